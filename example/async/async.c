@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/dh.h"
+#include "../../src/Exchange/async.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Exchange through the asynchronous API: the main thread submits the walks and stays free while the executor runs them.
+  Usage: ./async [executor threads] [max steps per prime]
+  The public keys are polled, the shared secrets are reported through a completion callback,
+  and a last job is cancelled while it is queued or running.
+  Returns 0 if both parties agree and the cancelled job did not complete, 1 otherwise.
+*/
+
+static const char *_async_states[] = {"pending", "running", "done", "failed", "cancelled"};
+
+typedef struct async_done_t {
+
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	uint count;
+} async_done_t;
+
+static void _async_callback(apply_job_t *job, void *arg) {
+
+	async_done_t *done = arg;
+
+	pthread_mutex_lock(&done->lock);
+	done->count++;
+	pthread_cond_signal(&done->cond);
+	pthread_mutex_unlock(&done->lock);
+}
+
+static key__t *_async_keygen(cfg_t *cfg, int party, slong max_steps, flint_rand_t state) {
+
+	key__t *key = keygen_(cfg, party, state);
+
+	for(uint j = 0; max_steps > 0 && j < key->nb_primes; j++) {
+		if(fmpz_cmp_si(key->steps[j], max_steps) > 0) fmpz_set_si(key->steps[j], max_steps);
+		if(fmpz_cmp_si(key->steps[j], -max_steps) < 0) fmpz_set_si(key->steps[j], -max_steps);
+	}
+	return key;
+}
+
+int main(int argc, char **argv) {
+
+	uint nb_threads = (argc > 1) ? atoi(argv[1]) : 2;
+	slong max_steps = (argc > 2) ? atol(argv[2]) : 0;
+
+	flint_rand_t state;
+	cfg_t *cfg = cfg_init_set();
+	const fq_ctx_t *F = (cfg->fields);
+	apply_executor_t ex;
+	apply_job_t *job_A, *job_B, *job_C;
+	async_done_t done;
+	struct timespec tick = {0, 10000000};
+	ulong ticks = 0;
+	int ec = 1, state_C;
+
+	fq_t j_A, j_B;
+	MG_curve_t E_A, E_B, E_secret_A, E_secret_B;
+
+	fq_init(j_A, *F);
+	fq_init(j_B, *F);
+	MG_curve_init(&E_A, F);
+	MG_curve_init(&E_B, F);
+	MG_curve_init(&E_secret_A, F);
+	MG_curve_init(&E_secret_B, F);
+	pthread_mutex_init(&done.lock, NULL);
+	pthread_cond_init(&done.cond, NULL);
+	done.count = 0;
+	flint_randinit(state);
+
+	//// Secret keys, drawn here since keygen is not thread-safe
+	key__t *key_A = _async_keygen(cfg, 0, max_steps, state);
+	key__t *key_B = _async_keygen(cfg, 1, max_steps, state);
+
+	apply_executor_init(&ex, cfg, nb_threads);
+
+	//// Public keys: poll, the main thread is free in the meantime
+	job_A = apply_key_submit(&ex, cfg->E, key_A, NULL, NULL);
+	job_B = apply_key_submit(&ex, cfg->E, key_B, NULL, NULL);
+	while(apply_job_poll(job_A) < APPLY_DONE || apply_job_poll(job_B) < APPLY_DONE) {
+		nanosleep(&tick, NULL);
+		ticks++;
+	}
+	printf("Public keys: %s, %s after %lu polls\n", _async_states[apply_job_poll(job_A)], _async_states[apply_job_poll(job_B)], ticks);
+	ec = apply_job_result(&E_A, job_A) && apply_job_result(&E_B, job_B);
+	apply_job_clear(job_A);
+	apply_job_clear(job_B);
+
+	//// Shared secrets: completion callback
+	job_A = apply_key_submit(&ex, &E_B, key_A, _async_callback, &done);
+	job_B = apply_key_submit(&ex, &E_A, key_B, _async_callback, &done);
+	pthread_mutex_lock(&done.lock);
+	while(done.count < 2) pthread_cond_wait(&done.cond, &done.lock);
+	pthread_mutex_unlock(&done.lock);
+	printf("Shared secrets: %s, %s\n", _async_states[apply_job_poll(job_A)], _async_states[apply_job_poll(job_B)]);
+	ec = ec && apply_job_result(&E_secret_A, job_A) && apply_job_result(&E_secret_B, job_B);
+	apply_job_clear(job_A);
+	apply_job_clear(job_B);
+
+	if(ec) {
+		MG_j_invariant(&j_A, &E_secret_A);
+		MG_j_invariant(&j_B, &E_secret_B);
+		ec = fq_equal(j_A, j_B, *F);
+	}
+	printf("Agreement: %d\n", ec);
+
+	//// Cancellation, stops at the next yield point
+	job_C = apply_key_submit(&ex, cfg->E, key_A, NULL, NULL);
+	apply_job_cancel(job_C);
+	state_C = apply_job_wait(job_C);
+	printf("Cancelled job: %s\n", _async_states[state_C]);
+	ec = ec && (state_C == APPLY_CANCELLED);
+	apply_job_clear(job_C);
+
+	apply_executor_clear(&ex);
+
+	key_clear(key_A);
+	key_clear(key_B);
+	fq_clear(j_A, *F);
+	fq_clear(j_B, *F);
+	MG_curve_clear(&E_A);
+	MG_curve_clear(&E_B);
+	MG_curve_clear(&E_secret_A);
+	MG_curve_clear(&E_secret_B);
+	pthread_mutex_destroy(&done.lock);
+	pthread_cond_destroy(&done.cond);
+	cfg_clear(cfg);
+	flint_randclear(state);
+
+	return ec ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TICKS "cycles"
+#else
+#define BENCH_TICKS "ns"
+#endif
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arena.h"
+#include "../../src/EllipticCurves/fp512.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/dh.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Throughput of apply_key under multi-threaded load, with and without the arena allocator.
+  Usage: ./bench [max threads] [walks per thread] [max steps per prime]
+  Each thread applies its own key to the base curve; keys are truncated to the given number of steps per prime.
+  The throughput table is preceded by the cost of each supported fp512 kernel on the base prime, in cycles on x86
+  and in nanoseconds elsewhere, with the kernel picked by fp512_dispatch and fmpz_powm as a reference.
+*/
+
+typedef struct bench_job_t {
+
+	cfg_t *cfg;
+	key__t *key;
+	uint walks;
+	int arena;
+
+	ulong steps;
+	int ec;
+	arena_stats_t stats;
+} bench_job_t;
+
+static void *_bench_thread(void *arg) {
+
+	bench_job_t *job = arg;
+	MG_curve_t E;
+
+	arena_enable(job->arena);
+	arena_stats_reset();
+
+	MG_curve_init(&E, job->cfg->fields);
+	job->ec = 1;
+	job->steps = 0;
+	for(uint i = 0; i < job->walks; i++) {
+		job->ec &= apply_key(&E, job->cfg->E, job->key, job->cfg, NULL);
+		for(uint j = 0; j < job->key->nb_primes; j++) job->steps += labs(fmpz_get_si(job->key->steps[j]));
+	}
+	MG_curve_clear(&E);
+
+	arena_stats(&job->stats);
+	return NULL;
+}
+
+static double _bench_now() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static double _bench_ticks() {
+
+#if defined(__x86_64__) || defined(__i386__)
+	return (double)__rdtsc();
+#else
+	return 1e9 * _bench_now();
+#endif
+}
+
+/**
+  Prints the cost of a multiplication, a squaring and an exponentiation to a random 512-bit exponent for each
+  supported fp512 kernel, checking that they all agree with fmpz_powm. Leaves the dispatched kernel selected.
+*/
+static void _bench_kernels(cfg_t *cfg, flint_rand_t state) {
+
+	const fmpz *p = fq_ctx_prime(cfg->fields[0]);
+	const fp512_ctx_t *ctx = fp512_get(p);
+	const char *picked = fp512_kernel()->name;
+	const uint reps = 10000, pow_reps = 50;
+	fmpz_t a, e, ref, res;
+	fp512_t x, y;
+	double t0, mul, sqr, pow;
+	int ok;
+
+	if(ctx == NULL) return;
+
+	fmpz_init(a);
+	fmpz_init(e);
+	fmpz_init(ref);
+	fmpz_init(res);
+
+	fmpz_randm(a, state, p);
+	fmpz_randm(e, state, p);
+
+	t0 = _bench_ticks();
+	for(uint i = 0; i < pow_reps; i++) fmpz_powm(ref, a, e, p);
+	pow = (_bench_ticks() - t0) / pow_reps;
+
+	printf("fp512 kernel, %-6s      mul       sqr       pow  ok\n", BENCH_TICKS);
+	printf("%-18s %9s %9s %9.0f\n", "fmpz_powm", "-", "-", pow);
+	for(uint k = 0; k < fp512_nb_kernels; k++) {
+		if(!fp512_set_kernel(fp512_kernels[k].name)) continue;
+
+		fp512_set_fmpz(x, a, ctx);
+		memcpy(y, x, sizeof(fp512_t));
+
+		t0 = _bench_ticks();
+		for(uint i = 0; i < reps; i++) fp512_mul(y, y, x, ctx);
+		mul = (_bench_ticks() - t0) / reps;
+
+		t0 = _bench_ticks();
+		for(uint i = 0; i < reps; i++) fp512_sqr(y, y, ctx);
+		sqr = (_bench_ticks() - t0) / reps;
+
+		t0 = _bench_ticks();
+		for(uint i = 0; i < pow_reps; i++) {
+			fp512_set_fmpz(y, a, ctx);
+			fp512_pow(y, y, e, ctx);
+			fp512_get_fmpz(res, y, ctx);
+		}
+		pow = (_bench_ticks() - t0) / pow_reps;
+
+		ok = fmpz_equal(res, ref);
+		printf("%-18s %9.0f %9.0f %9.0f  %d%s\n", fp512_kernels[k].name, mul, sqr, pow, ok,
+			(strcmp(fp512_kernels[k].name, picked) ? "" : "  (dispatched)"));
+	}
+	printf("\n");
+
+	fp512_set_kernel(picked);
+
+	fmpz_clear(a);
+	fmpz_clear(e);
+	fmpz_clear(ref);
+	fmpz_clear(res);
+}
+
+int main(int argc, char **argv) {
+
+	arena_install();
+
+	uint max_threads = (argc > 1) ? atoi(argv[1]) : 4;
+	uint walks = (argc > 2) ? atoi(argv[2]) : 2;
+	slong max_steps = (argc > 3) ? atol(argv[3]) : 2;
+
+	flint_rand_t state;
+	cfg_t *cfg = cfg_init_set();
+	key__t **keys = malloc(sizeof(key__t *) * max_threads);
+	bench_job_t *jobs = malloc(sizeof(bench_job_t) * max_threads);
+	pthread_t *threads = malloc(sizeof(pthread_t) * max_threads);
+
+	flint_randinit(state);
+
+	_bench_kernels(cfg, state);
+
+	//// Keys are drawn here since keygen is not thread-safe
+	for(uint t = 0; t < max_threads; t++) {
+		keys[t] = keygen_(cfg, t, state);
+		for(uint j = 0; j < keys[t]->nb_primes; j++) {
+			if(fmpz_cmp_si(keys[t]->steps[j], max_steps) > 0) fmpz_set_si(keys[t]->steps[j], max_steps);
+			if(fmpz_cmp_si(keys[t]->steps[j], -max_steps) < 0) fmpz_set_si(keys[t]->steps[j], -max_steps);
+		}
+	}
+
+	printf("allocator threads     walks/s   steps/s  alloc/step  system/step  ok\n");
+	for(int arena = 0; arena <= 1; arena++) {
+		for(uint n = 1; n <= max_threads; n *= 2) {
+
+			ulong steps = 0, alloc = 0, system = 0;
+			int ec = 1;
+			double t0 = _bench_now();
+
+			for(uint t = 0; t < n; t++) {
+				jobs[t].cfg = cfg;
+				jobs[t].key = keys[t];
+				jobs[t].walks = walks;
+				jobs[t].arena = arena;
+				pthread_create(threads + t, NULL, _bench_thread, jobs + t);
+			}
+			for(uint t = 0; t < n; t++) {
+				pthread_join(threads[t], NULL);
+				steps += jobs[t].steps;
+				alloc += jobs[t].stats.alloc;
+				system += jobs[t].stats.system;
+				ec &= jobs[t].ec;
+			}
+
+			double dt = _bench_now() - t0;
+			printf("%-9s %7u %9.2f %9.1f %11.1f %12.2f  %d\n", (arena ? "arena" : "system"), n,
+				n * walks / dt, steps / dt, (double)alloc / steps, (double)system / steps, ec);
+		}
+	}
+
+	for(uint t = 0; t < max_threads; t++) key_clear(keys[t]);
+	free(keys);
+	free(jobs);
+	free(threads);
+	cfg_clear(cfg);
+	flint_randclear(state);
+
+	flint_cleanup();
+	arena_clear();
+	return 0;
+}
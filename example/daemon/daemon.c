@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/dh.h"
+#include "../../src/Exchange/serialize.h"
+
+#include "protocol.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Exchange daemon: keeps the configuration warm and serves key applications over a Unix-domain socket.
+  Usage: ./daemon [socket path] [workers]
+  Each worker accepts a connection and serves its requests until the client closes it.
+  Built with -DOPCOUNT, -DVERBOSE or -DTIMING, each worker counts and profiles its own walks.
+*/
+
+static int _daemon_fd = -1;
+static volatile sig_atomic_t _daemon_stop = 0;
+static cfg_t *_daemon_cfg;
+
+static void _daemon_signal(int sig) {
+
+	_daemon_stop = 1;
+	shutdown(_daemon_fd, SHUT_RDWR);
+}
+
+/**
+  Serves the requests of the connection fd until it is closed.
+*/
+static void _daemon_serve(int fd) {
+
+	cfg_t *cfg = _daemon_cfg;
+	size_t klen = key_bytes(cfg), clen = MG_curve_bytes(cfg);
+	unsigned char op, req[klen + clen], res[1 + clen];
+	key__t *key = key_init_(cfg);
+	MG_curve_t E, R;
+	fq_t j;
+
+	fq_init(j, *(cfg->fields));
+	MG_curve_init(&E, cfg->fields);
+	MG_curve_init(&R, cfg->fields);
+
+	while(ccrs_read(fd, &op, 1)) {
+
+		memset(res, 0, 1 + clen);
+
+		//// Read and check the request
+		if(op == CCRS_OP_PUBLIC) {
+			if(!ccrs_read(fd, req, klen)) break;
+			res[0] = key_import(key, req) ? CCRS_OK : CCRS_EREQUEST;
+			MG_curve_set_(&E, cfg->E);
+		}
+		else if(op == CCRS_OP_SHARED) {
+			if(!ccrs_read(fd, req, klen + clen)) break;
+			res[0] = (key_import(key, req) && MG_curve_import(&E, req + klen, cfg)) ? CCRS_OK : CCRS_EREQUEST;
+		}
+		else {
+			res[0] = CCRS_EREQUEST;
+			ccrs_write(fd, res, 1 + clen);
+			break;
+		}
+
+		//// Walk
+		if(res[0] == CCRS_OK) {
+			if(!apply_key(&R, &E, key, cfg, NULL)) res[0] = CCRS_EWALK;
+			else if(op == CCRS_OP_PUBLIC) MG_curve_export(res + 1, &R);
+			else {
+				MG_j_invariant(&j, &R);
+				fq_export(res + 1, j, *(cfg->fields));
+			}
+		}
+
+		if(!ccrs_write(fd, res, 1 + clen)) break;
+	}
+
+	key_clear(key);
+	fq_clear(j, *(cfg->fields));
+	MG_curve_clear(&E);
+	MG_curve_clear(&R);
+}
+
+static void *_daemon_worker(void *arg) {
+
+	while(!_daemon_stop) {
+		int fd = accept(_daemon_fd, NULL, NULL);
+		if(fd < 0) continue;
+		_daemon_serve(fd);
+		close(fd);
+	}
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+
+	const char *path = (argc > 1) ? argv[1] : CCRS_DEFAULT_SOCKET;
+	uint nb_workers = (argc > 2) ? atoi(argv[2]) : 4;
+	struct sockaddr_un addr;
+	pthread_t workers[nb_workers];
+
+	//// Setup is paid once for the lifetime of the daemon, with the first steps from the base curve
+	_daemon_cfg = cfg_init_set();
+	cfg_precompute(_daemon_cfg);
+
+	//// Listen
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	unlink(path);
+
+	_daemon_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(_daemon_fd < 0 || bind(_daemon_fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(_daemon_fd, 128)) {
+		perror("daemon");
+		return 1;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, _daemon_signal);
+	signal(SIGTERM, _daemon_signal);
+
+	printf("Serving on %s with %u workers\n", path, nb_workers);
+	fflush(stdout);
+
+	for(uint i = 0; i < nb_workers; i++) pthread_create(workers + i, NULL, _daemon_worker, NULL);
+	for(uint i = 0; i < nb_workers; i++) pthread_join(workers[i], NULL);
+
+	close(_daemon_fd);
+	unlink(path);
+	cfg_clear(_daemon_cfg);
+	return 0;
+}
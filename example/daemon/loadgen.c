@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/serialize.h"
+#include "../../src/Exchange/profile.h"
+
+#include "protocol.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Load generator for the exchange daemon.
+  Usage: ./loadgen [socket path] [connections] [exchanges per connection] [max steps per prime]
+  Each connection runs full exchanges between two keys, that is two public key and two shared secret requests,
+  and checks that both parties agree. Reports the throughput and the latency percentiles of the requests.
+*/
+
+typedef struct loadgen_job_t {
+
+	const char *path;
+	uint exchanges;
+	size_t klen, clen;
+	unsigned char *key_A, *key_B;
+
+	ulong ok, failed;		// exchanges
+	profile_hist_t latency;		// per request, in ns
+} loadgen_job_t;
+
+static ulong _loadgen_now() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ulong)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/**
+  Sends one request on fd and waits for the response curve in res.
+  Returns the status of the response, or -1 if the connection failed.
+*/
+static int _loadgen_request(loadgen_job_t *job, int fd, unsigned char op, unsigned char *key, unsigned char *curve, unsigned char *res) {
+
+	unsigned char req[1 + job->klen + job->clen];
+	size_t len = 1 + job->klen;
+	ulong t0 = _loadgen_now();
+
+	req[0] = op;
+	memcpy(req + 1, key, job->klen);
+	if(curve) {
+		memcpy(req + len, curve, job->clen);
+		len += job->clen;
+	}
+
+	if(!ccrs_write(fd, req, len)) return -1;
+	if(!ccrs_read(fd, res, 1 + job->clen)) return -1;
+
+	profile_hist_add(&job->latency, _loadgen_now() - t0);
+	return res[0];
+}
+
+static void *_loadgen_thread(void *arg) {
+
+	loadgen_job_t *job = arg;
+	size_t clen = job->clen;
+	unsigned char pub_A[1 + clen], pub_B[1 + clen], sec_A[1 + clen], sec_B[1 + clen];
+	struct sockaddr_un addr;
+	int fd;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, job->path, sizeof(addr.sun_path) - 1);
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr))) {
+		perror("loadgen");
+		job->failed = job->exchanges;
+		return NULL;
+	}
+
+	for(uint i = 0; i < job->exchanges; i++) {
+
+		int ec = (_loadgen_request(job, fd, CCRS_OP_PUBLIC, job->key_A, NULL, pub_A) == CCRS_OK);
+		ec = ec && (_loadgen_request(job, fd, CCRS_OP_PUBLIC, job->key_B, NULL, pub_B) == CCRS_OK);
+		ec = ec && (_loadgen_request(job, fd, CCRS_OP_SHARED, job->key_A, pub_B + 1, sec_A) == CCRS_OK);
+		ec = ec && (_loadgen_request(job, fd, CCRS_OP_SHARED, job->key_B, pub_A + 1, sec_B) == CCRS_OK);
+
+		//// Both parties get the same j-invariant
+		ec = ec && !memcmp(sec_A + 1, sec_B + 1, clen);
+
+		if(ec) job->ok++;
+		else job->failed++;
+	}
+
+	close(fd);
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+
+	const char *path = (argc > 1) ? argv[1] : CCRS_DEFAULT_SOCKET;
+	uint nb_conn = (argc > 2) ? atoi(argv[2]) : 4;
+	uint exchanges = (argc > 3) ? atoi(argv[3]) : 4;
+	slong max_steps = (argc > 4) ? atol(argv[4]) : 2;
+
+	flint_rand_t state;
+	cfg_t *cfg = cfg_init_set();
+	size_t klen = key_bytes(cfg), clen = MG_curve_bytes(cfg);
+	loadgen_job_t *jobs = calloc(nb_conn, sizeof(loadgen_job_t));
+	pthread_t *threads = malloc(sizeof(pthread_t) * nb_conn);
+	profile_hist_t latency;
+	ulong ok = 0, failed = 0, t0, elapsed;
+
+	flint_randinit(state);
+	memset(&latency, 0, sizeof(profile_hist_t));
+
+	//// Two keys per connection, drawn here since keygen is not thread-safe
+	for(uint t = 0; t < nb_conn; t++) {
+
+		jobs[t].path = path;
+		jobs[t].exchanges = exchanges;
+		jobs[t].klen = klen;
+		jobs[t].clen = clen;
+		jobs[t].key_A = malloc(klen);
+		jobs[t].key_B = malloc(klen);
+
+		for(uint k = 0; k < 2; k++) {
+			key__t *key = keygen_(cfg, 2 * t + k, state);
+			for(uint j = 0; j < key->nb_primes; j++) {
+				if(fmpz_cmp_si(key->steps[j], max_steps) > 0) fmpz_set_si(key->steps[j], max_steps);
+				if(fmpz_cmp_si(key->steps[j], -max_steps) < 0) fmpz_set_si(key->steps[j], -max_steps);
+			}
+			key_export(k ? jobs[t].key_B : jobs[t].key_A, key);
+			key_clear(key);
+		}
+	}
+
+	//// Load
+	t0 = _loadgen_now();
+	for(uint t = 0; t < nb_conn; t++) pthread_create(threads + t, NULL, _loadgen_thread, jobs + t);
+	for(uint t = 0; t < nb_conn; t++) {
+		pthread_join(threads[t], NULL);
+		profile_hist_merge(&latency, &jobs[t].latency);
+		ok += jobs[t].ok;
+		failed += jobs[t].failed;
+	}
+	elapsed = _loadgen_now() - t0;
+
+	//// Report
+	printf("connections %u, exchanges %lu ok / %lu failed, %.3fs\n", nb_conn, ok, failed, elapsed / 1e9);
+	printf("throughput  %.2f requests/s, %.2f exchanges/s\n", latency.count / (elapsed / 1e9), (ok + failed) / (elapsed / 1e9));
+	if(latency.count) {
+		printf("latency     mean %.3fms  p50 %.3fms  p90 %.3fms  p99 %.3fms  max %.3fms\n",
+			latency.sum / 1e6 / latency.count,
+			profile_hist_percentile(&latency, 0.5) / 1e6,
+			profile_hist_percentile(&latency, 0.9) / 1e6,
+			profile_hist_percentile(&latency, 0.99) / 1e6,
+			latency.max / 1e6);
+	}
+
+	for(uint t = 0; t < nb_conn; t++) {
+		free(jobs[t].key_A);
+		free(jobs[t].key_B);
+	}
+	free(jobs);
+	free(threads);
+	cfg_clear(cfg);
+	flint_randclear(state);
+
+	return failed ? 1 : 0;
+}
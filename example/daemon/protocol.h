@@ -0,0 +1,56 @@
+#ifndef _protocol_H_
+#define _protocol_H_
+
+#include <unistd.h>
+#include <errno.h>
+
+/*********************************************
+ Wire protocol of the exchange daemon
+ A request is one opcode byte followed by its payload, in the compact binary format of serialize.h:
+	CCRS_OP_PUBLIC	key			applies the key to the base curve, responds with the public curve
+	CCRS_OP_SHARED	key, curve		applies the key to the given public curve, responds with the
+					j-invariant of the result, which both parties share
+ The response is one status byte followed by a curve or a field element, of the same size,
+ zeroed unless the status is CCRS_OK.
+ Requests are served in order until the client closes the connection.
+*********************************************/
+#define CCRS_DEFAULT_SOCKET "/tmp/ccrs.sock"
+
+#define CCRS_OP_PUBLIC 1
+#define CCRS_OP_SHARED 2
+
+#define CCRS_OK 0
+#define CCRS_EREQUEST 1		// unknown opcode, invalid key or invalid curve
+#define CCRS_EWALK 2		// a walk failed, the request can be retried
+
+/**
+  Reads exactly len bytes from fd. Returns 1 if successful and 0 on error or end of stream.
+*/
+static inline int ccrs_read(int fd, void *buf, size_t len) {
+
+	size_t done = 0;
+	while(done < len) {
+		ssize_t n = read(fd, (char *)buf + done, len - done);
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) return 0;
+		done += n;
+	}
+	return 1;
+}
+
+/**
+  Writes exactly len bytes to fd. Returns 1 if successful and 0 on error.
+*/
+static inline int ccrs_write(int fd, const void *buf, size_t len) {
+
+	size_t done = 0;
+	while(done < len) {
+		ssize_t n = write(fd, (const char *)buf + done, len - done);
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) return 0;
+		done += n;
+	}
+	return 1;
+}
+
+#endif
@@ -3,15 +3,26 @@ gcc 	../../src/EllipticCurves/memory.c \
 	../../src/EllipticCurves/pretty_print.c \
 	../../src/EllipticCurves/arithmetic.c \
 	../../src/EllipticCurves/auxiliary.c \
+	../../src/EllipticCurves/opcount.c \
+	../../src/EllipticCurves/arena.c \
+	../../src/EllipticCurves/pool.c \
+	../../src/EllipticCurves/fpv.c \
+	../../src/EllipticCurves/frobenius.c \
+	../../src/EllipticCurves/fp512.c \
 	../../src/Polynomials/binary_trees.c \
 	../../src/Polynomials/multieval.c \
 	../../src/Polynomials/roots.c \
 	../../src/Isogeny/radical.c \
 	../../src/Isogeny/velu.c \
 	../../src/Isogeny/walk.c \
+	../../src/Isogeny/yield.c \
 	../../src/Exchange/setup.c \
 	../../src/Exchange/keygen.c \
 	../../src/Exchange/dh.c \
 	../../src/Exchange/info.c \
+	../../src/Exchange/profile.c \
+	../../src/Exchange/schedule.c \
+	../../src/Exchange/async.c \
+	../../src/Exchange/tune.c \
 	exchange.c \
-	-O3  $1 $2 -lgmp -lflint -o exchange
+	-O3  $1 $2 -lgmp -lflint -lm -lpthread -o exchange
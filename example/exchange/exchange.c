@@ -6,6 +6,8 @@
 #include "../../src/EllipticCurves/memory.h"
 #include "../../src/EllipticCurves/arithmetic.h"
 #include "../../src/EllipticCurves/pretty_print.h"
+#include "../../src/EllipticCurves/arena.h"
+#include "../../src/EllipticCurves/pool.h"
 
 #include "../../src/Polynomials/binary_trees.h"
 #include "../../src/Polynomials/roots.h"
@@ -26,6 +28,14 @@
 
 int main() {
 
+	#ifdef ARENA
+	arena_install();
+	#endif
+
+	#ifdef POOL
+	pool_init(POOL);
+	#endif
+
 	flint_rand_t state;
 	cfg_t *cfg = cfg_init_set();
 
@@ -62,20 +72,24 @@ int main() {
 	#ifndef TIMING
 	printf("\nComputing Alice's public key\n");
 	#endif
-	int ret_A = apply_key(&E_A, cfg->E, key_A, cfg);
+	opcount_report_t counts;
+	int ret_A = apply_key(&E_A, cfg->E, key_A, cfg, &counts);
+	#ifdef OPCOUNT
+	print_opcount_json(&counts);
+	#endif
 	#ifndef TIMING
 	printf("Success: %d\n", ret_A);
 	printf("Computing Bob's public key\n");
-	int ret_B = apply_key(&E_B, cfg->E, key_B, cfg);
+	int ret_B = apply_key(&E_B, cfg->E, key_B, cfg, NULL);
 	printf("Success: %d\n", ret_B);
 
 
 	//// Apply secret key to public keys to get the secret
 	printf("\nComputing Alice's shared secret\n");
-	int ret_secret_A = apply_key(&E_secret_A, &E_B, key_A, cfg);
+	int ret_secret_A = apply_key(&E_secret_A, &E_B, key_A, cfg, NULL);
 	printf("Success: %d\n", ret_secret_A);
 	printf("Computing Bob's shared secret\n");
-	int ret_secret_B = apply_key(&E_secret_B, &E_A, key_B, cfg);
+	int ret_secret_B = apply_key(&E_secret_B, &E_A, key_B, cfg, NULL);
 	printf("Success: %d\n", ret_secret_B);
 
 	//// Compute secrets' j-invariant to check for validity
@@ -101,5 +115,14 @@ int main() {
 	MG_curve_clear(&E_secret_A);
 	MG_curve_clear(&E_secret_B);
 	flint_randclear(state);
+
+	#ifdef POOL
+	pool_clear();
+	#endif
+
+	#ifdef ARENA
+	flint_cleanup();
+	arena_clear();
+	#endif
 }
 
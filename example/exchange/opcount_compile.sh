@@ -0,0 +1 @@
+./compile.sh -DOPCOUNT
@@ -0,0 +1 @@
+./compile.sh -DPOOL=4
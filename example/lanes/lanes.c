@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+
+#include "../../src/Isogeny/walk.h"
+#include "../../src/Exchange/setup.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Lockstep radical walks: FPV_LANES independent walks of l = 3, 5 and 7 through walk_rad_lanes,
+  each from its own curve and with its own number of steps, checked against walk_rad one walk at a time.
+  Usage: ./lanes [max steps] [kernel]
+  The kernel of fpv.h is the dispatched one unless named; with one not marked fast, walk_rad_lanes goes back to walk_rad.
+  Returns 0 if every walk reaches the same j-invariant both ways, 1 otherwise.
+*/
+
+static double _lanes_time(struct timespec *start) {
+
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return (end.tv_sec - start->tv_sec) + 1e-9 * (end.tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char **argv) {
+
+	slong max_steps = (argc > 1) ? atol(argv[1]) : 20;
+
+	flint_rand_t state;
+	cfg_t *cfg = cfg_init_set();
+	const fq_ctx_t *F = (cfg->fields);
+	struct timespec start;
+	double t_seq, t_lanes;
+	ulong primes[3] = {3, 5, 7};
+	int ec = 1, ok_seq, ok_lanes;
+
+	fmpz_t l, k[FPV_LANES];
+	fq_t j_seq, j_lanes;
+	MG_curve_t E[FPV_LANES], E_seq[FPV_LANES], E_lanes[FPV_LANES];
+
+	fmpz_init(l);
+	fq_init(j_seq, *F);
+	fq_init(j_lanes, *F);
+	for(uint i = 0; i < FPV_LANES; i++) {
+		fmpz_init(k[i]);
+		MG_curve_init(E + i, F);
+		MG_curve_init(E_seq + i, F);
+		MG_curve_init(E_lanes + i, F);
+	}
+	flint_randinit(state);
+
+	if(argc > 2 && !fpv_set_kernel(argv[2])) {
+		printf("Unknown or unsupported kernel %s\n", argv[2]);
+		return 1;
+	}
+
+	//// Distinct start curves, i steps of 3-isogenies away from the base curve
+	fmpz_set_ui(l, 3);
+	for(uint i = 0; i < FPV_LANES; i++) {
+		fmpz_set_ui(k[i], i);
+		ec &= walk_rad(E + i, cfg->E, l, k[i]);
+	}
+
+	for(uint j = 0; j < 3; j++) {
+		fmpz_set_ui(l, primes[j]);
+
+		//// Steps in both directions, one lane idle
+		for(uint i = 0; i < FPV_LANES; i++) {
+			fmpz_set_si(k[i], (i == 1) ? 0 : (slong)n_randint(state, 2 * max_steps + 1) - max_steps);
+		}
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		ok_seq = 1;
+		for(uint i = 0; i < FPV_LANES; i++) ok_seq &= walk_rad(E_seq + i, E + i, l, k[i]);
+		t_seq = _lanes_time(&start);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		ok_lanes = walk_rad_lanes(E_lanes, E, l, k, FPV_LANES);
+		t_lanes = _lanes_time(&start);
+
+		ec &= ok_seq && ok_lanes;
+		for(uint i = 0; ec && i < FPV_LANES; i++) {
+			MG_j_invariant(&j_seq, E_seq + i);
+			MG_j_invariant(&j_lanes, E_lanes + i);
+			ec &= fq_equal(j_seq, j_lanes, *F);
+		}
+
+		printf("l = %lu: %u walks, one by one %.3fs, in %s lanes %.3fs (x%.2f), agreement %d\n",
+			primes[j], FPV_LANES, t_seq, fpv_kernel()->name, t_lanes, t_seq / t_lanes, ec);
+	}
+
+	fmpz_clear(l);
+	fq_clear(j_seq, *F);
+	fq_clear(j_lanes, *F);
+	for(uint i = 0; i < FPV_LANES; i++) {
+		fmpz_clear(k[i]);
+		MG_curve_clear(E + i);
+		MG_curve_clear(E_seq + i);
+		MG_curve_clear(E_lanes + i);
+	}
+	cfg_clear(cfg);
+	flint_randclear(state);
+
+	return ec ? 0 : 1;
+}
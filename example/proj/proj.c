@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+
+#include "../../src/Isogeny/radical.h"
+#include "../../src/Isogeny/walk.h"
+#include "../../src/Exchange/setup.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Inversion-free radical chains: radical_isogeny_5_proj and radical_isogeny_7_proj against radical_isogeny_5
+  and radical_isogeny_7, from the base curve in both directions, over the same number of steps.
+  Usage: ./proj [steps]
+  The number of steps is at least 1000.
+  Returns 0 if every chain reaches the same j-invariant both ways, 1 otherwise.
+*/
+
+static double _proj_time(struct timespec *start) {
+
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return (end.tv_sec - start->tv_sec) + 1e-9 * (end.tv_nsec - start->tv_nsec);
+}
+
+int main(int argc, char **argv) {
+
+	slong steps = (argc > 1) ? atol(argv[1]) : 1000;
+	if(steps < 1000) steps = 1000;
+
+	cfg_t *cfg = cfg_init_set();
+	const fq_ctx_t *F = (cfg->fields);
+	struct timespec start;
+	double t_aff, t_proj;
+	ulong primes[2] = {5, 7};
+	int ec = 1, ok;
+
+	fmpz_t l, k;
+	fq_t j_aff, j_proj;
+	TN_curve_t E_TN, E_aff, E_proj;
+	MG_curve_t E_MG_aff, E_MG_proj;
+
+	fmpz_init(l);
+	fmpz_init(k);
+	fmpz_set_si(k, steps);
+	fq_init(j_aff, *F);
+	fq_init(j_proj, *F);
+	MG_curve_init(&E_MG_aff, F);
+	MG_curve_init(&E_MG_proj, F);
+
+	for(uint j = 0; j < 2; j++) {
+		fmpz_set_ui(l, primes[j]);
+		TN_curve_init(&E_TN, l, F);
+		TN_curve_init(&E_aff, l, F);
+		TN_curve_init(&E_proj, l, F);
+
+		for(int twist = 0; twist < 2; twist++) {
+
+			//// Same start for both chains
+			ok = walk_rad_start(&E_TN, cfg->E, l, twist);
+
+			if(ok) {
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				if(primes[j] == 5) radical_isogeny_5(&E_aff, &E_TN, k);
+				else radical_isogeny_7(&E_aff, &E_TN, k);
+				t_aff = _proj_time(&start);
+
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				if(primes[j] == 5) radical_isogeny_5_proj(&E_proj, &E_TN, k);
+				else radical_isogeny_7_proj(&E_proj, &E_TN, k);
+				t_proj = _proj_time(&start);
+
+				ok = TN_get_MG(&E_MG_aff, &E_aff) && TN_get_MG(&E_MG_proj, &E_proj);
+			}
+
+			if(ok) {
+				MG_j_invariant(&j_aff, &E_MG_aff);
+				MG_j_invariant(&j_proj, &E_MG_proj);
+				ok = fq_equal(j_aff, j_proj, *F);
+				printf("l = %lu, %s: %ld steps, affine %.3fs, projective %.3fs (x%.2f), agreement %d\n",
+					primes[j], twist ? "twist" : "curve", steps, t_aff, t_proj, t_aff / t_proj, ok);
+			}
+			else printf("l = %lu, %s: no start curve\n", primes[j], twist ? "twist" : "curve");
+
+			ec &= ok;
+		}
+
+		TN_curve_clear(&E_TN);
+		TN_curve_clear(&E_aff);
+		TN_curve_clear(&E_proj);
+	}
+
+	fmpz_clear(l);
+	fmpz_clear(k);
+	fq_clear(j_aff, *F);
+	fq_clear(j_proj, *F);
+	MG_curve_clear(&E_MG_aff);
+	MG_curve_clear(&E_MG_proj);
+	cfg_clear(cfg);
+
+	return ec ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arena.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/dh.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Soak test for long-running processes: runs many exchanges in a single process and checks that memory stays flat.
+  Usage: ./soak [exchanges] [max steps per prime] [RSS slack in KiB]
+  After a warm-up of a tenth of the exchanges, the number of live FLINT/GMP blocks must not grow
+  and the resident set size must stay within the slack of its value at the end of the warm-up.
+  Returns 0 if memory stayed flat and every exchange agreed, 1 otherwise.
+*/
+
+/**
+  Returns the resident set size of the process in KiB.
+*/
+static long _soak_rss() {
+
+	long pages = 0, rss = 0;
+	FILE *f = fopen("/proc/self/statm", "r");
+
+	if(f) {
+		if(fscanf(f, "%ld %ld", &pages, &rss) != 2) rss = 0;
+		fclose(f);
+	}
+	return rss * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/**
+  Runs one exchange with fresh keys truncated to max_steps steps per prime.
+  Returns 1 if both parties agree on the shared secret.
+*/
+static int _soak_exchange(cfg_t *cfg, uint seed, slong max_steps, flint_rand_t state) {
+
+	int ret;
+	fq_t j_A, j_B;
+	MG_curve_t E_A, E_B, S_A, S_B;
+	const fq_ctx_t *F = cfg->fields;
+
+	fq_init(j_A, *F);
+	fq_init(j_B, *F);
+	MG_curve_init(&E_A, F);
+	MG_curve_init(&E_B, F);
+	MG_curve_init(&S_A, F);
+	MG_curve_init(&S_B, F);
+
+	key__t *key_A = keygen_(cfg, 2 * seed, state);
+	key__t *key_B = keygen_(cfg, 2 * seed + 1, state);
+	for(uint i = 0; i < cfg->nb_primes; i++) {
+		if(fmpz_cmp_si(key_A->steps[i], max_steps) > 0) fmpz_set_si(key_A->steps[i], max_steps);
+		if(fmpz_cmp_si(key_A->steps[i], -max_steps) < 0) fmpz_set_si(key_A->steps[i], -max_steps);
+		if(fmpz_cmp_si(key_B->steps[i], max_steps) > 0) fmpz_set_si(key_B->steps[i], max_steps);
+		if(fmpz_cmp_si(key_B->steps[i], -max_steps) < 0) fmpz_set_si(key_B->steps[i], -max_steps);
+	}
+
+	ret = apply_key(&E_A, cfg->E, key_A, cfg, NULL);
+	ret &= apply_key(&E_B, cfg->E, key_B, cfg, NULL);
+	ret &= apply_key(&S_A, &E_B, key_A, cfg, NULL);
+	ret &= apply_key(&S_B, &E_A, key_B, cfg, NULL);
+
+	if(ret) {
+		MG_j_invariant(&j_A, &S_A);
+		MG_j_invariant(&j_B, &S_B);
+		ret = fq_equal(j_A, j_B, *F);
+	}
+
+	key_clear(key_A);
+	key_clear(key_B);
+	fq_clear(j_A, *F);
+	fq_clear(j_B, *F);
+	MG_curve_clear(&E_A);
+	MG_curve_clear(&E_B);
+	MG_curve_clear(&S_A);
+	MG_curve_clear(&S_B);
+
+	return ret;
+}
+
+int main(int argc, char **argv) {
+
+	arena_install();
+
+	uint n = (argc > 1) ? atoi(argv[1]) : 1000;
+	slong max_steps = (argc > 2) ? atol(argv[2]) : 1;
+	long slack = (argc > 3) ? atol(argv[3]) : 1024;
+	uint warmup = (n / 10) ? (n / 10) : 1;
+
+	int ec = 0;
+	uint ok = 0;
+	long rss0 = 0, rss;
+	arena_stats_t stats;
+	slong live0 = 0;
+
+	flint_rand_t state;
+	cfg_t *cfg = cfg_init_set();
+	flint_randinit(state);
+
+	printf("exchange      rss(KiB)   live blocks  ok\n");
+	for(uint i = 0; i < n; i++) {
+
+		ok += _soak_exchange(cfg, i, max_steps, state);
+
+		arena_stats(&stats);
+		rss = _soak_rss();
+		if(i + 1 == warmup) {
+			rss0 = rss;
+			live0 = stats.live;
+		}
+		else if(i + 1 > warmup) {
+			if(stats.live > live0) ec = 1;
+			if(rss > rss0 + slack) ec = 1;
+		}
+
+		if((i + 1) % warmup == 0 || i + 1 == n) {
+			printf("%8u  %12ld  %12ld  %u\n", i + 1, rss, (long)stats.live, ok);
+			fflush(stdout);
+		}
+	}
+
+	flint_randclear(state);
+	cfg_clear(cfg);
+	flint_cleanup();
+	arena_clear();
+
+	if(ec) printf("FAILED: memory grew after warm-up (live blocks %ld -> %ld, rss %ld -> %ld KiB)\n", (long)live0, (long)stats.live, rss0, rss);
+	else printf("Memory flat after warm-up\n");
+	if(ok < n) {
+		printf("FAILED: %u of %u exchanges did not agree\n", n - ok, n);
+		ec = 1;
+	}
+	return ec;
+}
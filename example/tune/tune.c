@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/tune.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*
+  Sqrt-Velu split autotuner: times the candidate splits of every Velu prime up to a given extension degree
+  with tune_split, prints the fastest ones, then the l_PRIMES_B and l_PRIMES_BPRIME tables of setup.c.
+  Primes of higher degree keep their split, as do those whose steps go over the Frobenius orbits of the kernel.
+  Usage: ./tune [repetitions] [max degree]
+  Returns 0 if every Velu prime was tuned, 1 otherwise.
+*/
+
+int main(int argc, char **argv) {
+
+	uint reps = (argc > 1) ? atoi(argv[1]) : 3;
+	uint max_r = (argc > 2) ? atoi(argv[2]) : MAX_EXTENSION_DEGREE;
+
+	cfg_t *cfg = cfg_init_set();
+	tune_split_t res;
+	lprime_t *lp;
+	int ec = 1;
+
+	printf("%6s %2s %11s %11s %12s %12s %6s\n", "l", "r", "default", "tuned", "default (s)", "tuned (s)", "gain");
+
+	for(uint i = 0; i < cfg->nb_primes; i++) {
+		lp = cfg->lprimes + i;
+		if(lp->type != 2 || lp->r > max_r) continue;
+
+		if(!tune_split(&res, lp, cfg, reps)) {
+			printf("%6lu %2u: no point of order l\n", fmpz_get_ui(lp->l), lp->r);
+			ec = 0;
+			continue;
+		}
+
+		if(res.orbits) {
+			printf("%6lu %2u: steps over the Frobenius orbits of the kernel, split not tuned\n", res.l, res.r);
+			continue;
+		}
+
+		printf("%6lu %2u %5u,%-5u %5u,%-5u %12.6f %12.6f %5.1f%%\n", res.l, res.r, res.b0, res.bprime0,
+			res.b, res.bprime, res.t0, res.t, 100 * (1 - res.t / res.t0));
+		fflush(stdout);
+	}
+
+	printf("\nuint l_PRIMES_B[NB_PRIMES] = {");
+	for(uint i = 0; i < cfg->nb_primes; i++) printf("%u%s", cfg->lprimes[i].b, (i + 1 < cfg->nb_primes) ? ", " : "};\n");
+	printf("uint l_PRIMES_BPRIME[NB_PRIMES] = {");
+	for(uint i = 0; i < cfg->nb_primes; i++) printf("%u%s", cfg->lprimes[i].bprime, (i + 1 < cfg->nb_primes) ? ", " : "};\n");
+
+	cfg_clear(cfg);
+
+	return ec ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+import math
+
+"""
+    Offline search for the differential addition chains used to multiply by l.
+    A chain starts from the triple (P, 2P, 3P) and keeps (a, b, a+b) multiples of P, so that
+    the difference needed by each differential addition is always known:
+        bit 0: (a, b, a+b) -> (b, a+b, a+2b)     difference a
+        bit 1: (a, b, a+b) -> (a, a+b, 2a+b)     difference b
+    The chain is stored as an integer whose i-th bit is the i-th step, together with its length.
+"""
+
+L = [3, 5, 7, 11, 13, 17, 103, 523, 821, 947, 1723,
+     19, 661,
+     1013, 1181,
+     31, 61, 1321,
+     29, 71, 547,
+     881,
+     37, 1693]
+
+
+"""
+    Walks back from the final pair (a, b) with a+b = l to the starting pair (1, 2).
+    The predecessor of (a, b) is the pair {a, b-a} ordered increasingly, which fixes the step.
+    Returns the steps in forward order, or None if (1, 2) is not reached.
+"""
+def chain_from(a, b):
+    bits = []
+    while (a, b) != (1, 2):
+        if a >= b or a <= 0: return None
+        if a < b - a:
+            bits.append(1)
+            a, b = a, b - a
+        else:
+            bits.append(0)
+            a, b = b - a, a
+    return bits[::-1]
+
+
+"""
+    Shortest chain over all final pairs
+"""
+def search(l):
+    if l == 3: return []
+    best = None
+    for b in range((l + 1) // 2, l):
+        if math.gcd(b, l) != 1: continue
+        bits = chain_from(l - b, b)
+        if bits is not None and (best is None or len(bits) < len(best)):
+            best = bits
+    return best
+
+
+def run(bits):
+    a, b, c = 1, 2, 3
+    for bit in bits:
+        if bit: a, b, c = a, c, a + c
+        else: a, b, c = b, c, b + c
+    return c
+
+
+if __name__ == "__main__":
+    dac, daclen = [], []
+    for l in L:
+        bits = search(l)
+        assert run(bits) == l
+        dac.append(sum(bit << i for i, bit in enumerate(bits)))
+        daclen.append(len(bits))
+        # 1 xDBL and 1 xADD for (P, 2P, 3P), one xADD per step, against 1 xDBL then 1 xADD and 1 xDBL per bit
+        print("l = %4d: %2d x-only operations (ladder: %2d)" % (l, len(bits) + 2, 2 * l.bit_length() - 1))
+
+    print("uint l_PRIMES_DACLEN[NB_PRIMES] = {" + ", ".join(map(str, daclen)) + "};")
+    print("ulong l_PRIMES_DAC[NB_PRIMES] = {" + ", ".join(map(str, dac)) + "};")
@@ -11,13 +11,23 @@ from gekko import GEKKO
 PATH_IN = "files/timings.json"
 PATH_OUT = "files/optimized.json"
 
+"""
+    Timings in seconds per step for each l.
+    Reads either the profile printed by apply_key with -DTIMING, or the former flat {"l": seconds} format.
+"""
 def load_data():
     l_list, timings_list = [], []
     with open(PATH_IN, "r") as f:
         data = json.load(f)
-        for key, value in data.items():
-            l_list.append(key)
-            timings_list.append(value)
+        if "walks" in data:
+            for walk in data["walks"]:
+                if walk["l"] == 0 or walk["steps"] == 0: continue
+                l_list.append(str(walk["l"]))
+                timings_list.append(walk["step"]["sum"] / walk["steps"] / 1e9)
+        else:
+            for key, value in data.items():
+                l_list.append(key)
+                timings_list.append(value)
     return l_list, timings_list
 
 L, T = load_data()
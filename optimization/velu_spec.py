@@ -0,0 +1,129 @@
+"""
+    Generator of src/Isogeny/velu_spec.h, the straight-line KPS and xISOG of the small Velu primes.
+    For each configured Velu prime whose default split (b, b', lenK) has at most MAX_PAIRS products in I x J,
+    the chains of KPS and the direct products of xISOG are written out with every length, parity and index fixed,
+    and the resultants are taken pair by pair instead of with polynomial products and a remainder tree.
+    Run from this directory after changing the primes of setup.c:
+        python3 velu_spec.py > ../src/Isogeny/velu_spec.h
+"""
+
+L = [3, 5, 7, 11, 13, 17, 103, 523, 821, 947, 1723,
+     19, 661,
+     1013, 1181,
+     31, 61, 1321,
+     29, 71, 547,
+     881,
+     37, 1693]
+
+RADICAL = [3, 5, 7, 11, 13]
+
+MAX_PAIRS = 32
+
+
+"""
+    Default split of _init_lengths in velu.c
+"""
+def lengths(l):
+    bprime = l - 1
+    b = 1
+    while (b + 1) * (b + 1) <= bprime:
+        b += 1
+    b = b // 2
+    bprime = bprime // (4 * b)
+    lenK = (l - 1 - 4 * b * bprime) // 2
+    return b, bprime, lenK
+
+
+"""
+    Body of KPS_proj without the remainder tree, see _KPS_proj_IJ and _KPS_proj_K
+"""
+def kps(l, b, bprime, lenK):
+    out = []
+    out.append("\tMG_xDBL_proj(&ws->P2, P, a24, c24);")
+    out.append("\tMG_xDBL_proj(&ws->P4, ws->P2, a24, c24);")
+
+    out.append("\tMG_point_set_(&J[0], &P);")
+    if b >= 2: out.append("\tMG_xADD(&J[1], P, ws->P2, P);")
+    for j in range(2, b):
+        out.append("\tMG_xADD(&J[%d], J[%d], ws->P2, J[%d]);" % (j, j - 1, j - 2))
+
+    if b % 2 == 0: out.append("\tMG_xADD(&I[0], J[%d], J[%d], ws->P2);" % (b // 2, b - b // 2 - 1))
+    else: out.append("\tMG_xDBL_proj(&I[0], J[%d], a24, c24);" % (b // 2))
+    out.append("\tMG_xDBL_proj(&ws->P4b, I[0], a24, c24);")
+    if bprime >= 2: out.append("\tMG_xADD(&I[1], ws->P4b, I[0], I[0]);")
+    for i in range(2, bprime):
+        out.append("\tMG_xADD(&I[%d], I[%d], ws->P4b, I[%d]);" % (i, i - 1, i - 2))
+
+    if lenK > 0: out.append("\tMG_point_set_(&K[%d], &ws->P2);" % (lenK - 1))
+    if lenK > 1: out.append("\tMG_point_set_(&K[%d], &ws->P4);" % (lenK - 2))
+    for i in range(lenK - 3, -1, -1):
+        out.append("\tMG_xADD(&K[%d], K[%d], ws->P2, K[%d]);" % (i, i + 1, i + 2))
+    return out
+
+
+"""
+    Body of xISOG_proj with the resultants as direct products over I x J
+"""
+def xisog(l, b, bprime, lenK):
+    out = []
+    out.append("\tfq_one(ws->R0, *F);")
+    out.append("\tfq_one(ws->R1, *F);")
+    for i in range(bprime):
+        out.append("\t_velu_spec_I(ws, %d);" % i)
+    for j in range(b):
+        out.append("\t_velu_spec_J(ws, %d, a24, c24);" % j)
+        for i in range(bprime):
+            out.append("\t_velu_spec_R(ws, %d);" % i)
+
+    out.append("\tfq_one(ws->M0, *F);")
+    out.append("\tfq_one(ws->M1, *F);")
+    for i in range(lenK):
+        out.append("\t_velu_spec_K(ws, %d);" % i)
+    out.append("\t_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, %d, F);" % l)
+    return out
+
+
+if __name__ == "__main__":
+    specs = []
+    for l in sorted(L):
+        if l in RADICAL: continue
+        b, bprime, lenK = lengths(l)
+        if b * bprime <= MAX_PAIRS: specs.append((l, b, bprime, lenK))
+
+    print("#ifndef _VELU_SPEC_H_")
+    print("#define _VELU_SPEC_H_")
+    print("")
+    print("/**")
+    print("  KPS and xISOG specialised to the default split of the small Velu primes of setup.c, see velu_spec_get.")
+    print("  Generated by optimization/velu_spec.py, do not edit. Only included by velu.c.")
+    print("*/")
+    print("")
+    print("#define VELU_SPEC_MAX_L %d" % max(s[0] for s in specs))
+    for l, b, bprime, lenK in specs:
+        print("")
+        print("/* l = %d: b = %d, b' = %d, lenK = %d */" % (l, b, bprime, lenK))
+        print("static void _KPS_spec_%d(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {" % l)
+        print("")
+        print("\tMG_point_t *I = ws->I, *J = ws->J%s;" % (", *K = ws->K" if lenK else ""))
+        print("")
+        print("\n".join(kps(l, b, bprime, lenK)))
+        print("}")
+        print("")
+        print("static void _xISOG_spec_%d(fq_t a24, fq_t c24, velu_ws_t *ws) {" % l)
+        print("")
+        print("\tconst fq_ctx_t *F = ws->E->F;")
+        print("")
+        print("\n".join(xisog(l, b, bprime, lenK)))
+        print("}")
+
+    print("")
+    print("static const velu_spec_t _velu_specs[] = {")
+    print(",\n".join("\t{%d, %d, %d, %d, _KPS_spec_%d, _xISOG_spec_%d}" % (l, b, bprime, lenK, l, l) for l, b, bprime, lenK in specs))
+    print("};")
+    print("")
+    print("// Index of the specialisation of l in _velu_specs plus one, 0 if there is none")
+    print("static const uint _velu_spec_index[VELU_SPEC_MAX_L + 1] = {")
+    print(",\n".join("\t[%d] = %d" % (s[0], k + 1) for k, s in enumerate(specs)))
+    print("};")
+    print("")
+    print("#endif")
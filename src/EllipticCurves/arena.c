@@ -0,0 +1,328 @@
+/// @file arena.c
+#include "arena.h"
+
+/*
+  Every block starts with a header giving its size class, or ARENA_SYSTEM and its size
+  for blocks obtained from malloc. A block of class c is a header followed by 16 << c bytes,
+  carved by bumping a pointer in a chunk of the heap of the calling thread, which the header records.
+  Freed blocks are pushed on the free list of their class in their heap, and reused LIFO: once the first
+  steps of a walk have filled the free lists, the steps that follow are served without any call to the
+  system allocator. A block freed by another thread than the owner of its heap, as the limbs and coefficients
+  handed over by the task pool and the executor threads, goes to the remote list of the heap, a lock-free stack
+  that the owner moves to its free lists when they run empty. The heap of a thread that exits is adopted
+  by the next thread that allocates, with its free lists and the blocks still pending on its remote list.
+  Chunks and heaps are only returned to the system by arena_clear.
+*/
+
+#define ARENA_SYSTEM ARENA_NB_CLASSES
+
+typedef struct _arena_heap_t {
+
+	void *free_list[ARENA_NB_CLASSES];
+	char *cur, *end;			// rest of the current chunk
+	void *remote;				// blocks freed by other threads, see _arena_free
+	int orphan;				// 1 once its thread has exited
+	struct _arena_heap_t *next;		// in the global list of heaps
+} _arena_heap_t;
+
+typedef union _arena_header_t {
+
+	struct {
+		size_t cls;
+		union {
+			size_t size;		// ARENA_SYSTEM blocks
+			_arena_heap_t *owner;	// the others
+		};
+	};
+	max_align_t align;
+} _arena_header_t;
+
+static __thread _arena_heap_t *_arena_heap = NULL;
+static __thread int _arena_on = 1;
+static __thread arena_stats_t _arena_counters;
+
+static pthread_mutex_t _arena_lock = PTHREAD_MUTEX_INITIALIZER;
+static void *_arena_chunks = NULL;
+static _arena_heap_t *_arena_heaps = NULL;
+static pthread_key_t _arena_key;
+static pthread_once_t _arena_once = PTHREAD_ONCE_INIT;
+
+/**
+  Destructor of the thread-specific heap: leaves it to be adopted by another thread.
+*/
+static void _arena_orphan(void *arg) {
+
+	_arena_heap_t *heap = arg;
+
+	pthread_mutex_lock(&_arena_lock);
+	heap->orphan = 1;
+	pthread_mutex_unlock(&_arena_lock);
+}
+
+static void _arena_key_init() {
+
+	pthread_key_create(&_arena_key, _arena_orphan);
+}
+
+/**
+  Returns the heap of the calling thread, adopting the heap of an exited thread or creating one on first use.
+  Returns NULL if the system is out of memory.
+*/
+static _arena_heap_t *_arena_get_heap() {
+
+	_arena_heap_t *heap;
+
+	if(_arena_heap) return _arena_heap;
+
+	pthread_once(&_arena_once, _arena_key_init);
+
+	pthread_mutex_lock(&_arena_lock);
+	for(heap = _arena_heaps; heap && !heap->orphan; heap = heap->next);
+	if(heap) heap->orphan = 0;
+	else {
+		heap = calloc(1, sizeof(_arena_heap_t));
+		if(heap) {
+			heap->next = _arena_heaps;
+			_arena_heaps = heap;
+		}
+	}
+	pthread_mutex_unlock(&_arena_lock);
+
+	if(heap) pthread_setspecific(_arena_key, heap);
+	_arena_heap = heap;
+	return heap;
+}
+
+/**
+  Moves the blocks freed by other threads to the free lists of heap, owned by the calling thread.
+*/
+static void _arena_drain(_arena_heap_t *heap) {
+
+	void *ptr = __atomic_exchange_n(&heap->remote, NULL, __ATOMIC_ACQUIRE);
+	void *next;
+	_arena_header_t *h;
+
+	while(ptr) {
+		next = *(void **)ptr;
+		h = (_arena_header_t *)ptr - 1;
+		*(void **)ptr = heap->free_list[h->cls];
+		heap->free_list[h->cls] = ptr;
+		ptr = next;
+	}
+}
+
+/**
+  Returns the smallest class whose blocks hold size bytes, or ARENA_SYSTEM if there is none.
+*/
+static size_t _arena_class(size_t size) {
+
+	size_t c = 0;
+	while(c < ARENA_NB_CLASSES && ((size_t)1 << (c + ARENA_MIN_SHIFT)) < size) c++;
+	return c;
+}
+
+/**
+  Gives a fresh chunk of ARENA_CHUNK_SIZE bytes to heap.
+  The first header of the chunk links it into the global list of chunks.
+*/
+static int _arena_refill(_arena_heap_t *heap) {
+
+	char *chunk = malloc(ARENA_CHUNK_SIZE);
+	if(!chunk) return 0;
+	_arena_counters.system++;
+
+	pthread_mutex_lock(&_arena_lock);
+	*(void **)chunk = _arena_chunks;
+	_arena_chunks = chunk;
+	pthread_mutex_unlock(&_arena_lock);
+
+	heap->cur = chunk + sizeof(_arena_header_t);
+	heap->end = chunk + ARENA_CHUNK_SIZE;
+	return 1;
+}
+
+/**
+  Allocates size bytes from the system, behind a header.
+*/
+static void *_arena_system_alloc(size_t size) {
+
+	_arena_header_t *h = malloc(sizeof(_arena_header_t) + size);
+	if(!h) return NULL;
+	_arena_counters.system++;
+
+	h->cls = ARENA_SYSTEM;
+	h->size = size;
+	return h + 1;
+}
+
+static void *_arena_malloc(size_t size) {
+
+	size_t c = _arena_class(size);
+	size_t bsize;
+	_arena_header_t *h;
+	_arena_heap_t *heap;
+
+	_arena_counters.alloc++;
+	_arena_counters.live++;
+	if(c == ARENA_SYSTEM || !_arena_on) return _arena_system_alloc(size);
+
+	heap = _arena_get_heap();
+	if(!heap) return _arena_system_alloc(size);
+
+	//// Reuse a freed block, the ones freed by other threads included
+	if(!heap->free_list[c] && __atomic_load_n(&heap->remote, __ATOMIC_RELAXED)) _arena_drain(heap);
+	if(heap->free_list[c]) {
+		void *ptr = heap->free_list[c];
+		heap->free_list[c] = *(void **)ptr;
+		return ptr;
+	}
+
+	//// Carve a new one
+	bsize = sizeof(_arena_header_t) + ((size_t)1 << (c + ARENA_MIN_SHIFT));
+	if(heap->cur + bsize > heap->end) {
+		if(!_arena_refill(heap)) return NULL;
+	}
+	h = (_arena_header_t *)heap->cur;
+	heap->cur += bsize;
+
+	h->cls = c;
+	h->owner = heap;
+	return h + 1;
+}
+
+static void _arena_free(void *ptr) {
+
+	if(!ptr) return;
+
+	_arena_header_t *h = (_arena_header_t *)ptr - 1;
+	_arena_counters.live--;
+	if(h->cls == ARENA_SYSTEM) {
+		free(h);
+		return;
+	}
+
+	//// Back to the heap of the block, through its remote list from another thread
+	_arena_heap_t *heap = h->owner;
+	if(heap == _arena_heap) {
+		*(void **)ptr = heap->free_list[h->cls];
+		heap->free_list[h->cls] = ptr;
+		return;
+	}
+
+	void *head = __atomic_load_n(&heap->remote, __ATOMIC_RELAXED);
+	do {
+		*(void **)ptr = head;
+	} while(!__atomic_compare_exchange_n(&heap->remote, &head, ptr, 1, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static void *_arena_calloc(size_t n, size_t size) {
+
+	void *ptr = _arena_malloc(n * size);
+	if(ptr) memset(ptr, 0, n * size);
+	return ptr;
+}
+
+static void *_arena_realloc(void *ptr, size_t size) {
+
+	if(!ptr) return _arena_malloc(size);
+
+	_arena_header_t *h = (_arena_header_t *)ptr - 1;
+	size_t old, c = _arena_class(size);
+	void *rop;
+
+	//// Grow in place if possible
+	if(h->cls == ARENA_SYSTEM) {
+		if(c == ARENA_SYSTEM || !_arena_on) {
+			_arena_counters.alloc++;
+			_arena_counters.system++;
+			h = realloc(h, sizeof(_arena_header_t) + size);
+			if(!h) return NULL;
+			h->size = size;
+			return h + 1;
+		}
+		old = h->size;
+	}
+	else {
+		old = (size_t)1 << (h->cls + ARENA_MIN_SHIFT);
+		if(size <= old) return ptr;
+	}
+
+	//// Move
+	rop = _arena_malloc(size);
+	if(!rop) return NULL;
+	memcpy(rop, ptr, (old < size) ? old : size);
+	_arena_free(ptr);
+	return rop;
+}
+
+static void *_arena_gmp_realloc(void *ptr, size_t old, size_t size) {
+
+	return _arena_realloc(ptr, size);
+}
+
+static void _arena_gmp_free(void *ptr, size_t size) {
+
+	_arena_free(ptr);
+}
+
+/**
+  Routes every FLINT and GMP allocation through the arena.
+  Must be called before anything is allocated by FLINT or GMP, since blocks are recognised by their header.
+  Allocations are served by the arena in every thread until arena_enable(0) is called in that thread.
+*/
+void arena_install() {
+
+	flint_set_memory_functions(_arena_malloc, _arena_calloc, _arena_realloc, _arena_free);
+	mp_set_memory_functions(_arena_malloc, _arena_gmp_realloc, _arena_gmp_free);
+}
+
+/**
+  Returns all chunks and heaps to the system.
+  Every FLINT and GMP object must have been cleared beforehand, including FLINT's caches (see flint_cleanup),
+  and the other threads that used the arena must have exited.
+*/
+void arena_clear() {
+
+	pthread_mutex_lock(&_arena_lock);
+	while(_arena_chunks) {
+		void *next = *(void **)_arena_chunks;
+		free(_arena_chunks);
+		_arena_chunks = next;
+	}
+	while(_arena_heaps) {
+		_arena_heap_t *next = _arena_heaps->next;
+		free(_arena_heaps);
+		_arena_heaps = next;
+	}
+	pthread_mutex_unlock(&_arena_lock);
+
+	if(_arena_heap) pthread_setspecific(_arena_key, NULL);
+	_arena_heap = NULL;
+}
+
+/**
+  If on = 0, the allocations of the calling thread go to the system allocator, otherwise they are served by the arena.
+  Blocks can be freed in either mode, whatever mode they were allocated in.
+*/
+void arena_enable(int on) {
+
+	_arena_on = on;
+}
+
+/**
+  Sets rop to the allocation counters of the calling thread.
+*/
+void arena_stats(arena_stats_t *rop) {
+
+	*rop = _arena_counters;
+}
+
+/**
+  Resets the allocation counters of the calling thread.
+  The count of live blocks is kept, so that it stays balanced.
+*/
+void arena_stats_reset() {
+
+	_arena_counters.alloc = 0;
+	_arena_counters.system = 0;
+}
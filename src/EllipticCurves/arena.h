@@ -0,0 +1,38 @@
+/// @file arena.h
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <gmp.h>
+#include <flint/flint.h>
+
+/*********************************************
+   Arena allocator for FLINT and GMP
+*********************************************/
+
+// Block sizes served by the arena: 16 << c bytes for 0 <= c < ARENA_NB_CLASSES
+// Larger requests always go to the system allocator
+#define ARENA_MIN_SHIFT 4
+#define ARENA_NB_CLASSES 9
+#define ARENA_CHUNK_SIZE (1 << 18)
+
+typedef struct arena_stats_t {
+
+	ulong alloc;	// allocations (and moving reallocations) requested by FLINT or GMP
+	ulong system;	// calls to the system allocator among them, chunk refills included
+	slong live;	// blocks allocated minus blocks freed
+} arena_stats_t;
+
+void arena_install();
+void arena_clear();
+
+void arena_enable(int);
+void arena_stats(arena_stats_t *);
+void arena_stats_reset();
+
+#endif
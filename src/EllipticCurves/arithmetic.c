@@ -15,6 +15,9 @@ void MG_curve_update_field(MG_curve_t *rop, MG_curve_t *op, const fq_ctx_t *L) {
 
 	//// Try to embed A and B in L
 	MG_curve_set_str(rop, L, str_A, str_B, 10);
+
+	flint_free(str_A);
+	flint_free(str_B);
 }
 
 /**
@@ -305,7 +308,7 @@ bool MG_point_isinfty_(MG_point_t *P) {
 void MG_point_normalize(MG_point_t *P) {
 
 	if(!fq_is_zero(P->Z, *(P->E->F))) {
-		fq_div(P->X, P->X, P->Z, *(P->E->F));
+		fq_div_itoh(P->X, P->X, P->Z, *(P->E->F));
 		fq_one(P->Z, *(P->E->F));
 	}
 	else {
@@ -313,6 +316,56 @@ void MG_point_normalize(MG_point_t *P) {
 	}
 }
 
+/**
+  Normalizes the n points pointed to by P at once using Montgomery's simultaneous inversion trick.
+  This costs a single inversion and about 4n multiplications instead of n inversions.
+  Points at infinity are set to (1, 0) and left out of the product.
+  All points must lie on curves defined over the same field.
+*/
+void MG_point_normalize_batch(MG_point_t **P, uint n) {
+
+	if(n == 0) return;
+
+	const fq_ctx_t *F = P[0]->E->F;
+
+	fq_t acc[n];
+	fq_t inv, tmp;
+
+	fq_init(inv, *F);
+	fq_init(tmp, *F);
+
+	//// Prefix products acc[i] = Z_0 * ... * Z_i over the finite points
+	fq_one(inv, *F);
+	for(uint i = 0; i < n; i++) {
+		fq_init(acc[i], *F);
+		if(!fq_is_zero(P[i]->Z, *F)) fq_mul(inv, inv, P[i]->Z, *F);
+		fq_set(acc[i], inv, *F);
+	}
+
+	//// Single inversion of the whole product, with Itoh-Tsujii in the extensions
+	fq_inv_itoh(inv, inv, *F);
+
+	//// Peel off one Z_i at a time, inv = (Z_0 * ... * Z_i)^-1 at the start of each iteration
+	for(int i = n-1; i >= 0; i--) {
+		if(fq_is_zero(P[i]->Z, *F)) {
+			fq_one(P[i]->X, *F);
+			continue;
+		}
+
+		// tmp = Z_i^-1
+		if(i > 0) fq_mul(tmp, inv, acc[i-1], *F);
+		else fq_set(tmp, inv, *F);
+		fq_mul(inv, inv, P[i]->Z, *F);
+
+		fq_mul(P[i]->X, P[i]->X, tmp, *F);
+		fq_one(P[i]->Z, *F);
+	}
+
+	for(uint i = 0; i < n; i++) fq_clear(acc[i], *F);
+	fq_clear(inv, *F);
+	fq_clear(tmp, *F);
+}
+
 /**
   Returns a non-infinity random point on the underlying curve.
   P must be initialized.
@@ -386,11 +439,11 @@ void MG_point_rand_ninfty(MG_point_t *P, flint_rand_t state) {
 		fq_add(tmp1, tmp1, tmp2, *F);
 		fq_mul(tmp1, tmp1, X, *F);
 
-		fq_inv(tmp2, P->E->B, *F);
+		fq_inv_itoh(tmp2, P->E->B, *F);
 		fq_mul(tmp1, tmp1, tmp2, *F);
 
-		// Extract root if exists, otherwise fail with 0.
-		ret = fq_sqr_from_polyfact(tmp2, tmp1, *F);
+		// Square test from the norm, 0 counts as a non-square
+		ret = !fq_is_zero(tmp1, *F) && fq_issquare(tmp1, *F);
 	}
 	// Create corresponding MG_point_t, is not infinity
 	fq_set(P->X, X, *F);
@@ -432,11 +485,11 @@ void MG_point_rand_ninfty_nsquare(MG_point_t *P, flint_rand_t state) {
 		fq_add(tmp1, tmp1, tmp2, *F);
 		fq_mul(tmp1, tmp1, X, *F);
 
-		fq_inv(tmp2, P->E->B, *F);
+		fq_inv_itoh(tmp2, P->E->B, *F);
 		fq_mul(tmp1, tmp1, tmp2, *F);
 
-		// Extract root if exists, otherwise fail with 0.
-		ret = fq_sqr_from_polyfact(tmp2, tmp1, *F);
+		// Square test from the norm, 0 counts as a non-square
+		ret = !fq_is_zero(tmp1, *F) && fq_issquare(tmp1, *F);
 	}
 	// Create corresponding MG_point_t, is not infinity
 	fq_set(P->X, X, *F);
@@ -448,6 +501,197 @@ void MG_point_rand_ninfty_nsquare(MG_point_t *P, flint_rand_t state) {
 	fq_clear(X, *F);
 }
 
+/**
+  Auxiliary function for _MG_point_rand_ninfty_proj: draws a random X and tests whether x^3 + Ax^2 + x
+  is a non-square (nsquare = 1) or a square (nsquare = 0), A being given projectively by (A : c24).
+  Since (A : C) = (4a24 - 2c24 : c24), the test is run on T = c24^2 * (x^3 + (A/c24)x^2 + x) and needs no inversion.
+  The test is a Legendre symbol of the norm of T, see fq_issquare.
+  If Y is not NULL and X is accepted as a square, Y is set to the square root c24*y of T.
+  Returns 1 if X is accepted and 0 otherwise.
+*/
+static int _MG_point_try_x_proj(fq_t X, fq_t Y, const fq_t A, const fq_t c24, flint_rand_t state, int nsquare, const fq_ctx_t F) {
+
+	int ret;
+	fq_t tmp1, tmp2;
+
+	fq_init(tmp1, F);
+	fq_init(tmp2, F);
+
+	// Find random x in base field
+	fq_randtest(X, state, F);
+
+	// Compute T := C * x * (Cx^2 + Ax + C)
+	fq_mul(tmp1, c24, X, F);
+	fq_add(tmp1, tmp1, A, F);
+	fq_mul(tmp1, tmp1, X, F);
+	fq_add(tmp1, tmp1, c24, F);
+	fq_mul(tmp1, tmp1, X, F);
+	fq_mul(tmp1, tmp1, c24, F);
+
+	// Quadratic character from the norm, the root is only extracted when asked for
+	ret = !fq_is_zero(tmp1, F) && fq_issquare(tmp1, F);
+	if(Y != NULL && ret) ret = fq_sqr_tonelli(Y, tmp1, F);
+
+	fq_clear(tmp1, F);
+	fq_clear(tmp2, F);
+
+	return ret != nsquare;
+}
+
+/**
+  Auxiliary function for MG_point_rand_ninfty_proj and MG_point_rand_ninfty_nsquare_proj.
+  Samples X until x^3 + Ax^2 + x is a square (nsquare = 0) or a non-square (nsquare = 1)
+  on the curve given projectively by (a24 : c24) = (A+2C : 4C), assuming B = 1.
+*/
+void _MG_point_rand_ninfty_proj(MG_point_t *P, const fq_t a24, const fq_t c24, flint_rand_t state, int nsquare) {
+
+	fq_t X, A;
+
+	const fq_ctx_t *F = P->E->F;
+
+	fq_init(X, *F);
+	fq_init(A, *F);
+
+	// A := 4a24 - 2c24, so that (A : c24) is the projective Montgomery coefficient
+	fq_mul_ui(A, a24, 2, *F);
+	fq_sub(A, A, c24, *F);
+	fq_mul_ui(A, A, 2, *F);
+
+	while(!_MG_point_try_x_proj(X, NULL, A, c24, state, nsquare, *F));
+
+	// Create corresponding MG_point_t, is not infinity
+	fq_set(P->X, X, *F);
+	fq_set_ui(P->Z, 1, *F);
+
+	fq_clear(A, *F);
+	fq_clear(X, *F);
+}
+
+// A speculative candidate of _MG_point_rand_ninfty_proj_par
+typedef struct _MG_candidate_t {
+
+	fq_t X, Y;
+	const fq_t *A, *c24;
+	const fq_ctx_t *F;
+	flint_rand_t state;
+	int nsquare;
+	int found;
+} _MG_candidate_t;
+
+static void _MG_candidate_try(void *arg) {
+
+	_MG_candidate_t *c = arg;
+	c->found = _MG_point_try_x_proj(c->X, c->Y, *(c->A), *(c->c24), c->state, c->nsquare, *(c->F));
+}
+
+/**
+  Same as _MG_point_rand_ninfty_proj, with one candidate X per thread of the task pool tested at a time.
+  The first accepted candidate in order is kept, so that the point only depends on state and the pool size.
+  A round succeeds with probability 1 - 2^-n for n candidates instead of 1/2.
+  If Y is not NULL, it is set to c24*y as in _MG_point_try_x_proj.
+*/
+static void _MG_point_rand_ninfty_proj_par(MG_point_t *P, fq_t Y, const fq_t a24, const fq_t c24, flint_rand_t state, int nsquare) {
+
+	const fq_ctx_t *F = P->E->F;
+	uint n = pool_size();
+	int found = -1;
+	fq_t A;
+
+	if(n > POOL_MAX_CANDIDATES) n = POOL_MAX_CANDIDATES;
+
+	_MG_candidate_t cand[n];
+	pool_task_t tasks[n];
+
+	fq_init(A, *F);
+
+	// A := 4a24 - 2c24, so that (A : c24) is the projective Montgomery coefficient
+	fq_mul_ui(A, a24, 2, *F);
+	fq_sub(A, A, c24, *F);
+	fq_mul_ui(A, A, 2, *F);
+
+	//// One random state per candidate, seeded from state
+	for(uint i = 0; i < n; i++) {
+		fq_init(cand[i].X, *F);
+		fq_init(cand[i].Y, *F);
+		cand[i].A = (const fq_t *)A;
+		cand[i].c24 = (const fq_t *)c24;
+		cand[i].F = F;
+		cand[i].nsquare = nsquare;
+		flint_randinit(cand[i].state);
+		flint_randseed(cand[i].state, n_randlimb(state), i + 1);
+		tasks[i].fn = _MG_candidate_try;
+		tasks[i].arg = cand + i;
+	}
+
+	while(found < 0) {
+		pool_run(tasks, n);
+		for(uint i = 0; found < 0 && i < n; i++) if(cand[i].found) found = i;
+	}
+
+	// Create corresponding MG_point_t, is not infinity
+	fq_set(P->X, cand[found].X, *F);
+	fq_set_ui(P->Z, 1, *F);
+	if(Y != NULL) fq_set(Y, cand[found].Y, *F);
+
+	for(uint i = 0; i < n; i++) {
+		fq_clear(cand[i].X, *F);
+		fq_clear(cand[i].Y, *F);
+		flint_randclear(cand[i].state);
+	}
+	fq_clear(A, *F);
+}
+
+/**
+  Same as MG_point_rand_ninfty on the curve given projectively by (a24 : c24) = (A+2C : 4C).
+  P must be initialized.
+*/
+void MG_point_rand_ninfty_proj(MG_point_t *P, const fq_t a24, const fq_t c24, flint_rand_t state) {
+
+	_MG_point_rand_ninfty_proj(P, a24, c24, state, 0);
+}
+
+/**
+  Same as MG_point_rand_ninfty_nsquare on the curve given projectively by (a24 : c24) = (A+2C : 4C).
+  P must be initialized.
+*/
+void MG_point_rand_ninfty_nsquare_proj(MG_point_t *P, const fq_t a24, const fq_t c24, flint_rand_t state) {
+
+	_MG_point_rand_ninfty_proj(P, a24, c24, state, 1);
+}
+
+/**
+  Same as MG_point_rand_ninfty_proj, also setting Y to c24*y where (x, y) is the affine point,
+  which costs a square root once X is accepted, see fq_sqr_tonelli.
+  For l >= POOL_MIN_L, candidates are tested speculatively on the task pool when it has several threads.
+  P must be initialized.
+*/
+void MG_point_rand_ninfty_y_proj(MG_point_t *P, fq_t Y, const fq_t a24, const fq_t c24, flint_rand_t state, ulong l) {
+
+	const fq_ctx_t *F = P->E->F;
+	fq_t X, A;
+
+	if(pool_enabled(l)) {
+		_MG_point_rand_ninfty_proj_par(P, Y, a24, c24, state, 0);
+		return;
+	}
+
+	fq_init(X, *F);
+	fq_init(A, *F);
+
+	// A := 4a24 - 2c24, so that (A : c24) is the projective Montgomery coefficient
+	fq_mul_ui(A, a24, 2, *F);
+	fq_sub(A, A, c24, *F);
+	fq_mul_ui(A, A, 2, *F);
+
+	while(!_MG_point_try_x_proj(X, Y, A, c24, state, 0, *F));
+
+	fq_set(P->X, X, *F);
+	fq_set_ui(P->Z, 1, *F);
+
+	fq_clear(A, *F);
+	fq_clear(X, *F);
+}
+
 /******************************
   Montgomery Arithmetics
 ******************************/
@@ -456,13 +700,10 @@ void MG_point_rand_ninfty_nsquare(MG_point_t *P, flint_rand_t state) {
   This is possible if and only if B admits a square root in the base field.
 **/
 int MG_curve_normalize(MG_curve_t *E){
-	fq_t tmp;
-	fq_init(tmp, *(E->F));
 
-	int ret = fq_sqr_from_polyfact(tmp, E->B, *(E->F));
+	int ret = !fq_is_zero(E->B, *(E->F)) && fq_issquare(E->B, *(E->F));
 	if(ret == 1) fq_set_ui(E->B, 1, *(E->F));
 
-	fq_clear(tmp, *(E->F));
 	return ret;
 }
 
@@ -605,6 +846,39 @@ void MG_xDBL_const(MG_point_t *output, MG_point_t P,const fq_t dbl_const) {
 	fq_clear(v3, *F);
 }
 
+/**
+   Same as MG_xDBL but the curve is given projectively by the pair (a24 : c24) = (A+2C : 4C).
+   The coefficients of P.E are not read, no inversion is performed.
+   output must be initialized.
+*/
+void MG_xDBL_proj(MG_point_t *output, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	const fq_ctx_t *F;
+	F = (P.E)->F;
+
+	// Buffers
+	fq_t t0, t1, t2;
+	fq_init(t0, *F);
+	fq_init(t1, *F);
+	fq_init(t2, *F);
+
+	fq_sub(t0, P.X, P.Z, *F);
+	fq_sqr(t0, t0, *F);
+	fq_add(t1, P.X, P.Z, *F);
+	fq_sqr(t1, t1, *F);
+	fq_mul(t2, c24, t0, *F);
+	fq_mul(output->X, t2, t1, *F);
+	fq_sub(t1, t1, t0, *F);
+	fq_mul(t0, a24, t1, *F);
+	fq_add(t2, t2, t0, *F);
+	fq_mul(output->Z, t2, t1, *F);
+
+	// clear memory
+	fq_clear(t0, *F);
+	fq_clear(t1, *F);
+	fq_clear(t2, *F);
+}
+
 /**
    Sets rop to the k times *op using the montgomery ladder double-and-add type procedure.
    rop must be initialized.
@@ -666,6 +940,129 @@ void MG_ladder_iter_(MG_point_t *rop, fmpz_t k, MG_point_t *op) {
 	fq_clear(dbl_cst, *F);
 }
 
+/**
+   Same as MG_ladder_iter_ on the curve given projectively by (a24 : c24) = (A+2C : 4C).
+   rop must be initialized.
+*/
+void MG_ladder_iter_proj_(MG_point_t *rop, fmpz_t k, MG_point_t *op, const fq_t a24, const fq_t c24) {
+
+	MG_curve_t *E = op->E;
+	const fq_ctx_t *F = E->F;
+
+	// Check if k = 0
+	if(fmpz_is_zero(k)){
+		fq_one(rop->X, *F);
+		fq_zero(rop->Z, *F);
+		return;
+	}
+
+	// Check if P = O
+	bool isinfty;
+	MG_point_isinfty(&isinfty, op);
+	if(isinfty) return;
+
+	// Buffers
+	MG_point_t X0, X1;
+
+	MG_point_init(&X0, E);
+	MG_point_init(&X1, E);
+
+	fq_set(X0.X, op->X, *F);
+	fq_set(X0.Z, op->Z, *F);
+	MG_xDBL_proj(&X1, *op, a24, c24);
+
+	int l;
+	l = fmpz_sizeinbase(k, 2);
+
+	for (int i = l-2; i>=0; i--) {
+		if (fmpz_tstbit(k, i)) {
+			MG_xADD(&X0, X0, X1, *op);
+			MG_xDBL_proj(&X1, X1, a24, c24);
+		}
+		else {
+			MG_xADD(&X1, X0, X1, *op);
+			MG_xDBL_proj(&X0, X0, a24, c24);
+		}
+	}
+
+	fq_set(rop->X, X0.X, *F);
+	fq_set(rop->Z, X0.Z, *F);
+
+	MG_point_clear(&X0);
+	MG_point_clear(&X1);
+}
+
+/**
+   Swaps the coordinates of P and Q.
+*/
+static void _MG_point_swap(MG_point_t *P, MG_point_t *Q) {
+
+	fq_swap(P->X, Q->X, *(P->E->F));
+	fq_swap(P->Z, Q->Z, *(P->E->F));
+}
+
+/**
+   Sets rop to l*op on the curve given projectively by (a24 : c24) = (A+2C : 4C),
+   where l is given by the differential addition chain (dac, daclen).
+   The chain starts from (P, 2P, 3P) and keeps multiples (aP, bP, (a+b)P). The i-th bit of dac replaces them with
+	(bP, (a+b)P, (a+2b)P) if it is 0,	(aP, (a+b)P, (2a+b)P) if it is 1,
+   so that each step is a single xADD whose difference is known. The result is the last multiple.
+   The chains of the l-primes are found offline by optimization/dac_search.py.
+   The multiples of op below l must not be O, which holds when op has order a power of l.
+   rop must be initialized.
+*/
+void MG_xMUL_dac_proj(MG_point_t *rop, MG_point_t *op, ulong dac, uint daclen, const fq_t a24, const fq_t c24) {
+
+	MG_curve_t *E = op->E;
+	const fq_ctx_t *F = E->F;
+
+	// Check if P = O
+	bool isinfty;
+	MG_point_isinfty(&isinfty, op);
+	if(isinfty) {
+		fq_one(rop->X, *F);
+		fq_zero(rop->Z, *F);
+		return;
+	}
+
+	// Buffers
+	MG_point_t Pa, Pb, Pc, T;
+
+	MG_point_init(&Pa, E);
+	MG_point_init(&Pb, E);
+	MG_point_init(&Pc, E);
+	MG_point_init(&T, E);
+
+	fq_set(Pa.X, op->X, *F);
+	fq_set(Pa.Z, op->Z, *F);
+	MG_xDBL_proj(&Pb, Pa, a24, c24);
+	MG_xADD(&Pc, Pb, Pa, Pa);
+
+	for (uint i = 0; i < daclen; i++) {
+		if ((dac >> i) & 1) {
+			// (a, b, a+b) -> (a, a+b, 2a+b)
+			MG_xADD(&T, Pc, Pa, Pb);
+			_MG_point_swap(&Pb, &Pc);
+			_MG_point_swap(&Pc, &T);
+		}
+		else {
+			// (a, b, a+b) -> (b, a+b, a+2b)
+			MG_xADD(&T, Pc, Pb, Pa);
+			_MG_point_swap(&Pa, &Pb);
+			_MG_point_swap(&Pb, &Pc);
+			_MG_point_swap(&Pc, &T);
+		}
+	}
+
+	fq_set(rop->X, Pc.X, *F);
+	fq_set(rop->Z, Pc.Z, *F);
+
+	MG_point_clear(&Pa);
+	MG_point_clear(&Pb);
+	MG_point_clear(&Pc);
+	MG_point_clear(&T);
+}
+
 /**
    Sets rop to the frobenius' trace for the CRS base curve.
    rop must be initialized.
@@ -758,6 +1155,7 @@ void MG_curve_card_ext(fmpz_t rop, MG_curve_t *E, fmpz_t r) {
 */
 int MG_curve_rand_torsion(MG_point_t *P, fmpz_t l, fmpz_t card) {
 
+	int ec = 0;
 	flint_rand_t state;
 	fmpz_t val, cofactor, e;
 	MG_point_t Q, R;
@@ -773,35 +1171,43 @@ int MG_curve_rand_torsion(MG_point_t *P, fmpz_t l, fmpz_t card) {
 	MG_point_set_infty(&Q);
 
 	fmpz_val_q(val, cofactor, card, l); // Possible optimization?
-	if(fmpz_is_zero(val)) return 0;
 
-	while(isinfty) {
+	if(!fmpz_is_zero(val)) {
 
-		MG_point_rand_ninfty(&R, state);
-		MG_ladder_iter_(&Q, cofactor, &R);
-		MG_point_isinfty(&isinfty, &Q);
-	};
+		for(uint t = 0; isinfty && t < MG_TORSION_TRIES; t++) {
 
-	// Extract l-torsion point from possibly l^val-torsion point.
-	// Here R acts as a temporary variable for l*Q
-	MG_ladder_iter_(&R, l, &Q);
-	MG_point_isinfty(&isinfty, &R);
-	fmpz_set_ui(e, 1);
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			MG_point_rand_ninfty(&R, state);
+			OPCOUNT_PHASE(OPCOUNT_LADDER);
+			MG_ladder_iter_(&Q, cofactor, &R);
+			MG_point_isinfty(&isinfty, &Q);
+		};
 
-	// While l*Q != O do Q := l*Q
-	while(!isinfty && 0 >= fmpz_cmp(e, val)) {
-		MG_point_set_(&Q, &R);
-		MG_ladder_iter_(&R, l, &Q);
-		MG_point_isinfty(&isinfty, &R);
+		// Still O after MG_TORSION_TRIES samples: the curve lacks the expected torsion
+		if(!isinfty) {
 
-		fmpz_add_ui(e, e, 1);
-	}
+			// Extract l-torsion point from possibly l^val-torsion point.
+			// Here R acts as a temporary variable for l*Q
+			OPCOUNT_PHASE(OPCOUNT_TORSION);
+			MG_ladder_iter_(&R, l, &Q);
+			MG_point_isinfty(&isinfty, &R);
+			fmpz_set_ui(e, 1);
+
+			// While l*Q != O do Q := l*Q
+			while(!isinfty && 0 >= fmpz_cmp(e, val)) {
+				MG_point_set_(&Q, &R);
+				MG_ladder_iter_(&R, l, &Q);
+				MG_point_isinfty(&isinfty, &R);
 
-	// Case of failure
-	if(!isinfty) return 0;
+				fmpz_add_ui(e, e, 1);
+			}
 
-	MG_point_normalize(&Q);
-	MG_point_set_(P, &Q);
+			if(isinfty) {
+				MG_point_set_(P, &Q);
+				ec = 1;
+			}
+		}
+	}
 
 	MG_point_clear(&R);
 	MG_point_clear(&Q);
@@ -810,7 +1216,7 @@ int MG_curve_rand_torsion(MG_point_t *P, fmpz_t l, fmpz_t card) {
 	fmpz_clear(val);
 	flint_randclear(state);
 
-	return 1;
+	return ec;
 }
 /**
 WIP: only for degree two reduction
@@ -828,46 +1234,419 @@ int MG_curve_rand_torsion_(MG_point_t *P, fmpz_t l, fmpz_t card) {
 	int ec = 0;
 	flint_rand_t state;
 	fmpz_t val, cofactor;
-	MG_point_t Q, R, Q_test;
+	MG_point_t Q, R;
 	bool isinfty = 1;
 
 	fmpz_init(val);
 	fmpz_init(cofactor);
 	MG_point_init(&Q, P->E);
 	MG_point_init(&R, P->E);
-	MG_point_init(&Q_test, P->E);
 	flint_randinit(state);
 
 	MG_point_set_infty(&Q);
 
 	fmpz_val_q(val, cofactor, card, l);
-	if(fmpz_is_zero(val)) return 0;
 
-	while(isinfty) {
+	if(!fmpz_is_zero(val)) {
 
-		MG_point_rand_ninfty_nsquare(&R, state);
-		MG_ladder_iter_(&Q, cofactor, &R);
-		MG_point_isinfty(&isinfty, &Q);
-	};
+		for(uint t = 0; isinfty && t < MG_TORSION_TRIES; t++) {
+
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			MG_point_rand_ninfty_nsquare(&R, state);
+			OPCOUNT_PHASE(OPCOUNT_LADDER);
+			MG_ladder_iter_(&Q, cofactor, &R);
+			MG_point_isinfty(&isinfty, &Q);
+		};
+
+		// Still O after MG_TORSION_TRIES samples: the curve lacks the expected torsion
+		if(!isinfty) {
+
+			// Extract l-torsion point from possibly l^val-torsion point.
+			// Here R acts as a temporary variable for l*Q
+			OPCOUNT_PHASE(OPCOUNT_TORSION);
+			MG_ladder_iter_(&R, l, &Q);
+			MG_point_isinfty(&isinfty, &R);
+			int e = 0;
+
+			// While l*Q != O do Q := l*Q
+			while(!isinfty && 0 < fmpz_cmp_ui(val, e)) {
+				MG_point_set_(&Q, &R);
+				MG_ladder_iter_(&R, l, &Q);
+				MG_point_isinfty(&isinfty, &R);
+
+				e++;
+			}
+
+			if(isinfty) {
+				MG_point_set_(P, &Q);
+				ec = 1;
+			}
+		}
+	}
+
+	MG_point_clear(&R);
+	MG_point_clear(&Q);
+	fmpz_clear(cofactor);
+	fmpz_clear(val);
+	flint_randclear(state);
+
+	return ec;
+}
+
+/**
+   Sets P to a random point of order l^2 on the underlying curve and returns 1, see MG_curve_rand_torsion.
+   The l-part of E(F_q) is assumed cyclic, as the 3-part of a curve over F_p with p = 2 mod 3,
+   so that a sample has order l^2 once cleared to the l^2-torsion unless l times it is O.
+   Returns 0 in case of failure (no such point on E).
+*/
+int MG_curve_rand_torsion_sq(MG_point_t *P, fmpz_t l, fmpz_t card) {
+
+	int ec = 0;
+	flint_rand_t state;
+	fmpz_t val, cofactor, e;
+	MG_point_t Q, R;
+	bool isinfty = 1;
+
+	fmpz_init(val);
+	fmpz_init(cofactor);
+	fmpz_init(e);
+	MG_point_init(&Q, P->E);
+	MG_point_init(&R, P->E);
+	flint_randinit(state);
+
+	fmpz_val_q(val, cofactor, card, l);
+
+	if(fmpz_cmp_ui(val, 2) >= 0) {
+
+		//// Clear to the l^2-torsion with cofactor * l^(val - 2)
+		fmpz_pow_ui(e, l, fmpz_get_ui(val) - 2);
+		fmpz_mul(cofactor, cofactor, e);
+
+		for(uint t = 0; isinfty && t < MG_TORSION_TRIES; t++) {
+
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			MG_point_rand_ninfty(&R, state);
+			OPCOUNT_PHASE(OPCOUNT_LADDER);
+			MG_ladder_iter_(&Q, cofactor, &R);
+			MG_point_isinfty(&isinfty, &Q);
+
+			// Here R acts as a temporary variable for l*Q
+			OPCOUNT_PHASE(OPCOUNT_TORSION);
+			if(!isinfty) {
+				MG_ladder_iter_(&R, l, &Q);
+				MG_point_isinfty(&isinfty, &R);
+			}
+		};
+
+		if(!isinfty) {
+			MG_point_set_(P, &Q);
+			ec = 1;
+		}
+	}
+
+	MG_point_clear(&R);
+	MG_point_clear(&Q);
+	fmpz_clear(e);
+	fmpz_clear(cofactor);
+	fmpz_clear(val);
+	flint_randclear(state);
+
+	return ec;
+}
+
+/**
+  Auxiliary function for the projective torsion samplers: sets P to the point l^e * Q of order l, for the least e < val
+  for which it exists, where Q has order dividing l^val. R is a temporary point.
+  Returns 0 if Q has no such multiple, leaving P unchanged.
+*/
+static int _MG_torsion_extract_proj(MG_point_t *P, MG_point_t *Q, MG_point_t *R, fmpz_t val, ulong dac, uint daclen, const fq_t a24, const fq_t c24) {
+
+	bool isinfty;
+	fmpz_t e;
+
+	fmpz_init(e);
 
-	// Extract l-torsion point from possibly l^val-torsion point.
 	// Here R acts as a temporary variable for l*Q
-	MG_ladder_iter_(&R, l, &Q);
-	MG_point_isinfty(&isinfty, &R);
-	int e = 0;
+	OPCOUNT_PHASE(OPCOUNT_TORSION);
+	MG_xMUL_dac_proj(R, Q, dac, daclen, a24, c24);
+	MG_point_isinfty(&isinfty, R);
+	fmpz_set_ui(e, 1);
 
 	// While l*Q != O do Q := l*Q
-	while(!isinfty && 0 < fmpz_cmp_ui(val, e)) {
-		MG_point_set_(&Q, &R);
-		MG_ladder_iter_(&R, l, &Q);
-		MG_point_isinfty(&isinfty, &R);
+	while(!isinfty && 0 >= fmpz_cmp(e, val)) {
+		MG_point_set_(Q, R);
+		MG_xMUL_dac_proj(R, Q, dac, daclen, a24, c24);
+		MG_point_isinfty(&isinfty, R);
 
-		e++;
+		fmpz_add_ui(e, e, 1);
 	}
 
-	// Case of failure
-	if(!isinfty) ec = 0;
-	else {ec = 1; MG_point_set_(P, &Q);}
+	if(isinfty) MG_point_set_(P, Q);
+
+	fmpz_clear(e);
+
+	return isinfty;
+}
+
+/**
+  Auxiliary function for MG_curve_rand_torsion_proj and MG_curve_rand_torsion_proj_.
+  Samples on the curve given projectively by (a24 : c24) = (A+2C : 4C), on the quadratic twist if twist = 1.
+  Multiplications by l use the differential addition chain (dac, daclen) of l, see MG_xMUL_dac_proj.
+  For l >= POOL_MIN_L, candidate points are tested speculatively on the task pool when it has several threads.
+  The point P is not normalized.
+  Returns 0 in case of failure (no such point on E).
+*/
+int _MG_curve_rand_torsion_proj(MG_point_t *P, fmpz_t l, ulong dac, uint daclen, fmpz_t card, const fq_t a24, const fq_t c24, int twist) {
+
+	int ec = 0;
+	flint_rand_t state;
+	fmpz_t val, cofactor;
+	MG_point_t Q, R;
+	bool isinfty = 1;
+
+	fmpz_init(val);
+	fmpz_init(cofactor);
+	MG_point_init(&Q, P->E);
+	MG_point_init(&R, P->E);
+	flint_randinit(state);
+
+	MG_point_set_infty(&Q);
+
+	fmpz_val_q(val, cofactor, card, l);
+
+	if(!fmpz_is_zero(val)) {
+
+		for(uint t = 0; isinfty && t < MG_TORSION_TRIES; t++) {
+
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			if(pool_enabled(fmpz_get_ui(l))) _MG_point_rand_ninfty_proj_par(&R, NULL, a24, c24, state, twist);
+			else if(twist) MG_point_rand_ninfty_nsquare_proj(&R, a24, c24, state);
+			else MG_point_rand_ninfty_proj(&R, a24, c24, state);
+			OPCOUNT_PHASE(OPCOUNT_LADDER);
+			MG_ladder_iter_proj_(&Q, cofactor, &R, a24, c24);
+			MG_point_isinfty(&isinfty, &Q);
+		};
+
+		// Extract l-torsion point from possibly l^val-torsion point.
+		if(!isinfty) ec = _MG_torsion_extract_proj(P, &Q, &R, val, dac, daclen, a24, c24);
+	}
+
+	MG_point_clear(&R);
+	MG_point_clear(&Q);
+	fmpz_clear(cofactor);
+	fmpz_clear(val);
+	flint_randclear(state);
+
+	return ec;
+}
+
+/**
+   Same as MG_curve_rand_torsion on the curve given projectively by (a24 : c24) = (A+2C : 4C), assuming B = 1.
+   The point P is not normalized.
+   Returns 0 in case of failure (no such point on E).
+*/
+int MG_curve_rand_torsion_proj(MG_point_t *P, fmpz_t l, ulong dac, uint daclen, fmpz_t card, const fq_t a24, const fq_t c24) {
+
+	return _MG_curve_rand_torsion_proj(P, l, dac, daclen, card, a24, c24, 0);
+}
+
+/**
+   Same as MG_curve_rand_torsion_ on the curve given projectively by (a24 : c24) = (A+2C : 4C), assuming B = 1.
+   The point P is not normalized.
+   Returns 0 in case of failure (no such point on E).
+*/
+int MG_curve_rand_torsion_proj_(MG_point_t *P, fmpz_t l, ulong dac, uint daclen, fmpz_t card, const fq_t a24, const fq_t c24) {
+
+	return _MG_curve_rand_torsion_proj(P, l, dac, daclen, card, a24, c24, 1);
+}
+
+/******************************
+  Frobenius cofactor clearing
+******************************/
+/**
+  Initializes frob for the curves over the field F of E that are defined over the base field.
+  With r = q^a the degree of F, q prime, pi^r - 1 = Phi_r(pi) (pi^k - 1) for k = r/q, and frob->card is
+  #E(F_{p^r}) / #E(F_{p^k}), the order of the kernel of Phi_r(pi). frob->k is 0 if r is 1 or not a prime power,
+  and also if r is even: the y-coordinate (1 - pi^k) needs then costs a polynomial factorisation, see fq_sqr_tonelli,
+  which is more than the ladder saves.
+  E is only used for the cardinals, which only depend on the trace. pi^k is applied with the Frobenius table of F,
+  see fq_frob_register.
+  A corresponding call to MG_frob_clear() must be made after finishing with frob.
+*/
+void MG_frob_init(MG_frob_t *frob, MG_curve_t *E) {
+
+	const fq_ctx_t *F = E->F;
+	uint r = fq_ctx_degree(*F);
+	uint q = 2;
+	fmpz_t deg, card;
+
+	frob->F = F;
+	frob->k = 0;
+	fmpz_init(frob->card);
+
+	if(r == 1 || r % 2 == 0) return;
+
+	//// Smallest prime factor of r, which must be its only one
+	while(r % q) q++;
+	for(uint t = r; t > 1; t /= q) if(t % q) return;
+	frob->k = r / q;
+
+	fmpz_init(deg);
+	fmpz_init(card);
+
+	fmpz_set_ui(deg, r);
+	MG_curve_card_ext(frob->card, E, deg);
+	fmpz_set_ui(deg, frob->k);
+	MG_curve_card_ext(card, E, deg);
+	fmpz_divexact(frob->card, frob->card, card);
+
+	fmpz_clear(deg);
+	fmpz_clear(card);
+}
+
+/**
+  Clears frob, releasing any memory used. It must be reinitialised in order to be used again.
+*/
+void MG_frob_clear(MG_frob_t *frob) {
+
+	fmpz_clear(frob->card);
+}
+
+/**
+  Sets rop to pi^k(op) = op^(p^k) with fq_frobenius_tab. rop may alias op.
+*/
+void MG_frob_apply(fq_t rop, const fq_t op, MG_frob_t *frob) {
+
+	fq_frobenius_tab(rop, op, frob->k, *(frob->F));
+}
+
+/**
+  Auxiliary function for MG_curve_rand_torsion_frob_proj: overwrites R = (x : 1) with (1 - pi^k)R, given Y = c24*y,
+  the projective coefficient (A : c24) = (4a24 - 2c24 : c24) and c24_k = pi^k(c24); the affine coefficient A/C lies
+  in the base field. With (x2, y2) = pi^k(x, y), x(R - pi^k R) = ((y + y2)/(x - x2))^2 - A/C - x - x2,
+  which is scaled by (c24 * c24_k)^2 to avoid any inversion.
+  Returns 0 if x2 = x, in which case R is left unchanged.
+*/
+static int _MG_frob_sub(MG_point_t *R, const fq_t Y, const fq_t A, const fq_t c24, const fq_t c24_k, MG_frob_t *frob) {
+
+	const fq_ctx_t *F = frob->F;
+	int ec;
+	fq_t x2, Y2, dx, m;
+
+	fq_init(x2, *F);
+	fq_init(Y2, *F);
+	fq_init(dx, *F);
+	fq_init(m, *F);
+
+	MG_frob_apply(x2, R->X, frob);
+	fq_sub(dx, R->X, x2, *F);
+	ec = !fq_is_zero(dx, *F);
+	if(ec) {
+		MG_frob_apply(Y2, Y, frob);
+
+		// m = c24 * c24_k and dx = (x - x2)^2
+		fq_mul(m, c24, c24_k, *F);
+		fq_sqr(dx, dx, *F);
+
+		// Y2 = (Y*c24_k + pi^k(Y)*c24)^2 = (m(y + y2))^2
+		fq_mul(Y2, Y2, c24, *F);
+		fq_mul(R->Z, Y, c24_k, *F);
+		fq_add(Y2, Y2, R->Z, *F);
+		fq_sqr(Y2, Y2, *F);
+
+		// x2 = m (A c24_k + (x + x2) m) dx, that is m^2 (A/C + x + x2) dx
+		fq_add(x2, x2, R->X, *F);
+		fq_mul(x2, x2, m, *F);
+		fq_mul(R->Z, A, c24_k, *F);
+		fq_add(x2, x2, R->Z, *F);
+		fq_mul(x2, x2, m, *F);
+		fq_mul(x2, x2, dx, *F);
+
+		// (X : Z) = (Y2 - x2 : m^2 dx)
+		fq_sub(R->X, Y2, x2, *F);
+		fq_sqr(m, m, *F);
+		fq_mul(R->Z, m, dx, *F);
+	}
+
+	fq_clear(x2, *F);
+	fq_clear(Y2, *F);
+	fq_clear(dx, *F);
+	fq_clear(m, *F);
+
+	return ec;
+}
+
+/**
+  Sets R to (1 - pi^k)S for a random point S of E(F_{p^r}) other than infinity, on the curve given projectively by
+  (a24 : c24) = (A+2C : 4C), defined over the base field with B = 1: a random point of the kernel of Phi_r(pi),
+  see MG_frob_init. frob->k must be nonzero. The pool is used for the sampling as with _MG_curve_rand_torsion_proj.
+  R must be initialized and is not normalized.
+*/
+void MG_point_rand_frob_proj(MG_point_t *R, const fq_t a24, const fq_t c24, MG_frob_t *frob, flint_rand_t state, ulong l) {
+
+	const fq_ctx_t *F = R->E->F;
+	fq_t Y, A, c24_k;
+
+	fq_init(Y, *F);
+	fq_init(A, *F);
+	fq_init(c24_k, *F);
+
+	// A := 4a24 - 2c24, so that (A : c24) is the projective Montgomery coefficient
+	fq_mul_ui(A, a24, 2, *F);
+	fq_sub(A, A, c24, *F);
+	fq_mul_ui(A, A, 2, *F);
+	MG_frob_apply(c24_k, c24, frob);
+
+	do {
+		MG_point_rand_ninfty_y_proj(R, Y, a24, c24, state, l);
+	} while(!_MG_frob_sub(R, Y, A, c24, c24_k, frob));
+
+	fq_clear(Y, *F);
+	fq_clear(A, *F);
+	fq_clear(c24_k, *F);
+}
+
+/**
+   Same as MG_curve_rand_torsion_proj for a curve defined over the base field, with frob initialized for its field.
+   Samples come from MG_point_rand_frob_proj, so that the ladder only runs on frob->card / l^val
+   instead of card / l^val, a fraction phi(r)/r of its length for the degree r.
+   Falls back to MG_curve_rand_torsion_proj with card = #E(F_{p^r}) if frob->k = 0 or l does not divide frob->card.
+   The point P is not normalized.
+   Returns 0 in case of failure (no such point on E).
+*/
+int MG_curve_rand_torsion_frob_proj(MG_point_t *P, fmpz_t l, ulong dac, uint daclen, MG_frob_t *frob, fmpz_t card, const fq_t a24, const fq_t c24) {
+
+	int ec = 0;
+	flint_rand_t state;
+	fmpz_t val, cofactor;
+	MG_point_t Q, R;
+	bool isinfty = 1;
+
+	fmpz_init(val);
+	fmpz_init(cofactor);
+
+	if(frob->k) fmpz_val_q(val, cofactor, frob->card, l);
+	if(fmpz_is_zero(val)) {
+		fmpz_clear(val);
+		fmpz_clear(cofactor);
+		return MG_curve_rand_torsion_proj(P, l, dac, daclen, card, a24, c24);
+	}
+
+	MG_point_init(&Q, P->E);
+	MG_point_init(&R, P->E);
+	flint_randinit(state);
+
+	for(uint t = 0; isinfty && t < MG_TORSION_TRIES; t++) {
+
+		OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+		MG_point_rand_frob_proj(&R, a24, c24, frob, state, fmpz_get_ui(l));
+		OPCOUNT_PHASE(OPCOUNT_LADDER);
+		MG_ladder_iter_proj_(&Q, cofactor, &R, a24, c24);
+		MG_point_isinfty(&isinfty, &Q);
+	};
+
+	// Extract l-torsion point from possibly l^val-torsion point.
+	if(!isinfty) ec = _MG_torsion_extract_proj(P, &Q, &R, val, dac, daclen, a24, c24);
 
 	MG_point_clear(&R);
 	MG_point_clear(&Q);
@@ -884,41 +1663,35 @@ int MG_curve_rand_torsion_(MG_point_t *P, fmpz_t l, fmpz_t card) {
 /**
   Sets rop to the Tate-normal form of op relative to point P
   rop must be initialized.
+  Only 1/b3^2 = B/(4(x^3 + Ax^2 + x)) is needed, which costs a single inversion besides normalizing P.
 TODO: Check torsion
 */
 void MG_get_TN(TN_curve_t *rop, MG_curve_t *op, MG_point_t *P, fmpz_t l){
 
-	fq_t y2, b2, b3_, b4, c2, b, c, tmp1, tmp2;
+	fq_t inv_b3_, b2, b4, c2, b, c, tmp1;
 
 	const fq_ctx_t *F = op->F;
-	fq_init(y2, *F);
+	fq_init(inv_b3_, *F);
 	fq_init(tmp1, *F);
-	fq_init(tmp2, *F);
 	fq_init(b2, *F);
-	fq_init(b3_, *F);
 	fq_init(b4, *F);
 	fq_init(c2, *F);
 	fq_init(b, *F);
 	fq_init(c, *F);
 
-	// extract y^2 into y2
-	// TODO: make this a function
+	// inv_b3_ = 1 / b3^2 = 1 / 4y^2 = B / 4(x^3 + Ax^2 + x)
 	MG_point_normalize(P);
-	fq_pow_ui(tmp1, P->X, 2, *F);
-	fq_mul(tmp2, P->X, op->A, *F);
-	fq_add(tmp1, tmp2, tmp1, *F);
+	fq_add(tmp1, P->X, op->A, *F);
+	fq_mul(tmp1, tmp1, P->X, *F);
 	fq_add_ui(tmp1, tmp1, 1, *F);
 	fq_mul(tmp1, tmp1, P->X, *F);
-
-	fq_inv(tmp2, op->B, *F);
-	fq_mul(y2, tmp1, tmp2, *F);
+	fq_mul_ui(tmp1, tmp1, 4, *F);
+	fq_div(inv_b3_, op->B, tmp1, *F);
 
 	// Computing temporary coefficients
 	// b2 = 3x + A
 	fq_mul_ui(b2, P->X, 3, *F);
 	fq_add(b2, b2, P->E->A, *F);
-	// b3_ = b3 ^ 2 = 4y^2
-	fq_mul_ui(b3_, y2, 4, *F);
 	// b4 = 3x^2 + 2Ax + 1
 	fq_mul(b4, b2, P->X, *F);
 	fq_mul(tmp1, P->X, op->A, *F);
@@ -928,18 +1701,18 @@ void MG_get_TN(TN_curve_t *rop, MG_curve_t *op, MG_point_t *P, fmpz_t l){
 	if(!fmpz_equal_ui(l, 3)) {
 
 		// c2 = b2 - b4^2 / b3_
-		fq_pow_ui(tmp1, b4, 2, *F);
-		fq_inv(tmp2, b3_, *F);
-		fq_mul(c2, tmp1, tmp2, *F);
+		fq_sqr(tmp1, b4, *F);
+		fq_mul(c2, tmp1, inv_b3_, *F);
 		fq_sub(c2, b2, c2, *F);
 
 		// b = -c2^3 / b3_
-		fq_pow_ui(b, c2, 3, *F);
-		fq_mul(b, b, tmp2, *F);
+		fq_sqr(b, c2, *F);
+		fq_mul(b, b, c2, *F);
+		fq_mul(b, b, inv_b3_, *F);
 		fq_neg(b, b, *F);
 
 		// c = 1-2* b4/b3_ * c2
-		fq_mul(c, b4, tmp2, *F);
+		fq_mul(c, b4, inv_b3_, *F);
 		fq_mul(c, c, c2, *F);
 		fq_mul_ui(c, c, 2, *F);
 		fq_neg(c, c, *F);
@@ -947,25 +1720,21 @@ void MG_get_TN(TN_curve_t *rop, MG_curve_t *op, MG_point_t *P, fmpz_t l){
 	}
 	else {
 		// c = 1-2b4/b3_
-		fq_inv(c, b3_, *F);
-		fq_mul(c, c, b4, *F);
+		fq_mul(c, b4, inv_b3_, *F);
 		fq_mul_ui(c, c, 2, *F);
 		fq_neg(c, c, *F);
 		fq_add_ui(c, c, 1, *F);
 
 		// b = -1/b3^2
-		fq_neg(b, b3_, *F);
-		fq_inv(b, b, *F);
+		fq_neg(b, inv_b3_, *F);
 	}
 
 	TN_curve_set(rop, b, c, l, F);
 
 	// Free memory
-	fq_clear(y2, *F);
+	fq_clear(inv_b3_, *F);
 	fq_clear(tmp1, *F);
-	fq_clear(tmp2, *F);
 	fq_clear(b2, *F);
-	fq_clear(b3_, *F);
 	fq_clear(b4, *F);
 	fq_clear(c2, *F);
 	fq_clear(b, *F);
@@ -976,13 +1745,15 @@ void MG_get_TN(TN_curve_t *rop, MG_curve_t *op, MG_point_t *P, fmpz_t l){
   Sets rop to the Montgomery form of op
   Returns 1 if successful, 0 otherwise.
   rop must be initialized.
+  The x-coordinate of a 2-torsion point is found with fq_cubic_anyroot, the other two
+  candidates are the roots of the remaining quadratic factor.
 TODO: Check torsion
 */
 int TN_get_MG(MG_curve_t *rop, TN_curve_t * op){
 
+	int ret = 0, nb_roots = 1;
 	fq_t b2, b4, b6, c2, c4, tmp1, tmp2, alpha;
-	fq_poly_t pol, pol_;
-	fq_poly_factor_t fac;
+	fq_t roots[3];
 
 	const fq_ctx_t *F = op->F;
 	fq_init(b2, *F);
@@ -993,9 +1764,7 @@ int TN_get_MG(MG_curve_t *rop, TN_curve_t * op){
 	fq_init(tmp1, *F);
 	fq_init(tmp2, *F);
 	fq_init(alpha, *F);
-	fq_poly_init(pol, *F);
-	fq_poly_init(pol_, *F);
-	fq_poly_factor_init(fac, *F);
+	for(int i=0; i < 3; i++) fq_init(roots[i], *F);
 
 	// Set tmp1 to (c-1)/2 for re-use
 	fq_sub_ui(tmp1, op->c, 1, *F);
@@ -1015,54 +1784,46 @@ int TN_get_MG(MG_curve_t *rop, TN_curve_t * op){
 	fq_inv_ui(tmp1, 4, *F);
 	fq_mul(b6, b6, tmp1, *F);
 
-	//////// Prepare polynomial to extract x candidates
-	//// set coefficients
-	fq_set_ui(tmp1, 1, *F);
-	fq_poly_set_coeff(pol, 0, b6, *F);
-	fq_poly_set_coeff(pol, 1, b4, *F);
-	fq_poly_set_coeff(pol, 2, b2, *F);
-	fq_poly_set_coeff(pol, 3, tmp1, *F);
-
-	//// Factor polynomial, catch errors, discard lead
-	fq_poly_factor(fac, tmp1, pol, *F);
-	if(fac->num < 2) return 0; // pol has no roots in the underlying field!
-
-	//// Get roots candidates for x
-	fq_t roots[fac->num];
-	int roots_flag[fac->num];
-	for(int i=0; i < fac->num; i++){
-		/// Check if this factor is of degree 1, ITC leave 0 (non-root)
-		fq_init(roots[i], *F);
-		if(fq_poly_degree(fac->poly + i, *F) == 1) {
-			fq_poly_get_coeff(roots[i], fac->poly + i, 0, *F);
-			fq_neg(roots[i], roots[i], *F); // Careful there
-			roots_flag[i] = 1;
-		}
-		else{
-			roots_flag[i] = 0;
+	//////// Roots of x^3 + b2x^2 + b4x + b6
+	if(fq_cubic_anyroot(roots[0], b2, b4, b6, *F)) {
+
+		//// Remaining factor x^2 + tmp1x + tmp2 with tmp1 = b2 + x0 and tmp2 = b4 + x0 * tmp1
+		fq_add(tmp1, b2, roots[0], *F);
+		fq_mul(tmp2, tmp1, roots[0], *F);
+		fq_add(tmp2, tmp2, b4, *F);
+
+		//// Its roots (-tmp1 +/- sqrt(tmp1^2 - 4tmp2)) / 2
+		fq_sqr(c4, tmp1, *F);
+		fq_mul_ui(tmp2, tmp2, 4, *F);
+		fq_sub(c4, c4, tmp2, *F);
+		if(fq_sqr_tonelli(alpha, c4, *F)) {
+			fq_sub(roots[1], alpha, tmp1, *F);
+			fq_div_ui(roots[1], roots[1], 2, *F);
+			fq_add(roots[2], alpha, tmp1, *F);
+			fq_div_si(roots[2], roots[2], -2, *F);
+			nb_roots = 3;
 		}
 	}
+	else nb_roots = 0; // pol has no roots in the underlying field!
 
 	//// Try roots candidates
-	int ret = 0;
-	for(int i=0; i < fac->num; i++) {
-		if(roots_flag[i]) {
-
-
-			// Set c4 = pol'(x), we need a square root of c4 to continue
-			fq_poly_derivative(pol_, pol, *F);
-			fq_poly_evaluate_fq(c4, pol_, roots[i], *F);
-			int sqrt_ret = fq_sqr_from_polyfact(alpha, c4, *F);
-
-			if(sqrt_ret == 1) {
-				/// If successful, create A = c2 = (3x + b2)/alpha
-				fq_mul_ui(c2, roots[i], 3, *F);
-				fq_add(c2, c2, b2, *F);
-				fq_div(c2, c2, alpha, *F);
-				fq_set_ui(tmp1, 1, *F);
-				MG_curve_set(rop, F, c2, tmp1);
-				return 1;
-			}
+	for(int i=0; i < nb_roots && !ret; i++) {
+
+		// Set c4 = pol'(x) = 3x^2 + 2b2x + b4, we need a square root of c4 to continue
+		fq_mul_ui(c4, roots[i], 3, *F);
+		fq_mul_ui(tmp1, b2, 2, *F);
+		fq_add(c4, c4, tmp1, *F);
+		fq_mul(c4, c4, roots[i], *F);
+		fq_add(c4, c4, b4, *F);
+
+		if(fq_sqr_tonelli(alpha, c4, *F)) {
+			/// If successful, create A = c2 = (3x + b2)/alpha
+			fq_mul_ui(c2, roots[i], 3, *F);
+			fq_add(c2, c2, b2, *F);
+			fq_div(c2, c2, alpha, *F);
+			fq_set_ui(tmp1, 1, *F);
+			MG_curve_set(rop, F, c2, tmp1);
+			ret = 1;
 		}
 	}
 
@@ -1074,11 +1835,8 @@ int TN_get_MG(MG_curve_t *rop, TN_curve_t * op){
 	fq_clear(tmp1, *F);
 	fq_clear(tmp2, *F);
 	fq_clear(alpha, *F);
-	fq_poly_clear(pol, *F);
-	fq_poly_clear(pol_, *F);
-	fq_poly_factor_clear(fac, *F);
+	for(int i=0; i < 3; i++) fq_clear(roots[i], *F);
 
-	if(ret == 0) return 0; // Error!
-	return 1;
+	return ret;
 }
 
@@ -8,10 +8,13 @@
 #include "models.h"
 #include "auxiliary.h"
 #include "pretty_print.h"
+#include "pool.h"
+#include "frobenius.h"
 
 #include <gmp.h>
 #include <flint/fmpz.h>
 #include <flint/fq.h>
+#include <flint/ulong_extras.h>
 
 #include "../Polynomials/roots.h"
 
@@ -38,6 +41,7 @@ int SW_point_isvalid(bool *, SW_point_t *);
 int MG_point_isvalid(bool *, MG_point_t *);
 void MG_point_isinfty(bool *, MG_point_t *);
 void MG_point_normalize(MG_point_t *);
+void MG_point_normalize_batch(MG_point_t **, uint);
 
 /*********************************************
  Random torsion point generation
@@ -45,6 +49,10 @@ void MG_point_normalize(MG_point_t *);
 void SW_point_rand_ninfty(SW_point_t *);
 void MG_point_rand_ninfty(MG_point_t *, flint_rand_t);
 void MG_point_rand_ninfty_nsquare(MG_point_t *, flint_rand_t);
+void _MG_point_rand_ninfty_proj(MG_point_t *, const fq_t, const fq_t, flint_rand_t, int);
+void MG_point_rand_ninfty_proj(MG_point_t *, const fq_t, const fq_t, flint_rand_t);
+void MG_point_rand_ninfty_nsquare_proj(MG_point_t *, const fq_t, const fq_t, flint_rand_t);
+void MG_point_rand_ninfty_y_proj(MG_point_t *, fq_t, const fq_t, const fq_t, flint_rand_t, ulong);
 
 /*********************************************
  Montgomery curve arithmetic
@@ -54,6 +62,7 @@ int MG_rec_y(fq_t, MG_point_t *);
 void MG_xADD(MG_point_t *, MG_point_t, MG_point_t, MG_point_t);
 void MG_xDBL(MG_point_t *, MG_point_t);
 void MG_xDBL_const(MG_point_t *, MG_point_t ,const fq_t);
+void MG_xDBL_proj(MG_point_t *, MG_point_t, const fq_t, const fq_t);
 
 /*********************************************
  Montgomery ladder
@@ -62,15 +71,44 @@ void MG_ladder_rec(MG_point_t *, MG_point_t *, fmpz_t, MG_point_t, const fq_ctx_
 void MG_ladder(MG_point_t *x0, fmpz_t k, MG_point_t P);
 void MG_ladder_iter(MG_point_t *, MG_point_t *, fmpz_t, MG_point_t, fq_ctx_t *);
 void MG_ladder_iter_(MG_point_t *, fmpz_t, MG_point_t *);
+void MG_ladder_iter_proj_(MG_point_t *, fmpz_t, MG_point_t *, const fq_t, const fq_t);
+void MG_xMUL_dac_proj(MG_point_t *, MG_point_t *, ulong, uint, const fq_t, const fq_t);
 
 /*********************************************
  Torsion
 *********************************************/
+// The samplers give up after this many samples cleared to O. With l | card, a sample is cleared with probability
+// at most 1/l, so this only happens on a curve without the expected torsion, for instance an unchecked public key.
+#define MG_TORSION_TRIES 64
+
 void MG_curve_trace(fmpz_t);
 void MG_curve_card_base(fmpz_t, MG_curve_t *);
 void MG_curve_card_ext(fmpz_t, MG_curve_t *, fmpz_t r);
 int MG_curve_rand_torsion(MG_point_t *, fmpz_t, fmpz_t);
 int MG_curve_rand_torsion_(MG_point_t *, fmpz_t, fmpz_t);
+int MG_curve_rand_torsion_sq(MG_point_t *, fmpz_t, fmpz_t);
+int _MG_curve_rand_torsion_proj(MG_point_t *, fmpz_t, ulong, uint, fmpz_t, const fq_t, const fq_t, int);
+int MG_curve_rand_torsion_proj(MG_point_t *, fmpz_t, ulong, uint, fmpz_t, const fq_t, const fq_t);
+int MG_curve_rand_torsion_proj_(MG_point_t *, fmpz_t, ulong, uint, fmpz_t, const fq_t, const fq_t);
+
+/*********************************************
+ Frobenius cofactor clearing
+ On a curve over F_p, the points of order l that a walk in F_{p^r} samples lie in the kernel of Phi_r(pi),
+ for the p-power Frobenius pi. For r = q^a a prime power, (pi^k - 1) with k = r/q sends any point of E(F_{p^r})
+ there at the cost of two linear maps and one addition, and the ladder only clears the order of that kernel.
+*********************************************/
+typedef struct MG_frob_t {
+
+	const fq_ctx_t *F;
+	uint k;			// 0 if the degree r of F is 1, even or not a prime power
+	fmpz_t card;		// #E(F_{p^r}) / #E(F_{p^k}), the order of the kernel of Phi_r(pi)
+} MG_frob_t;
+
+void MG_frob_init(MG_frob_t *, MG_curve_t *);
+void MG_frob_clear(MG_frob_t *);
+void MG_frob_apply(fq_t, const fq_t, MG_frob_t *);
+void MG_point_rand_frob_proj(MG_point_t *, const fq_t, const fq_t, MG_frob_t *, flint_rand_t, ulong);
+int MG_curve_rand_torsion_frob_proj(MG_point_t *, fmpz_t, ulong, uint, MG_frob_t *, fmpz_t, const fq_t, const fq_t);
 
 /*********************************************
  Tate normal curve and Montgomery conversion
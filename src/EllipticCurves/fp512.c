@@ -0,0 +1,650 @@
+/// @file fp512.c
+#include "fp512.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#define FP512_MULX
+#endif
+
+static const fp512_kernel_t *_fp512_current = NULL;
+static pthread_once_t _fp512_once = PTHREAD_ONCE_INIT;
+
+static fp512_ctx_t _fp512_ctxs[FP512_MAX_PRIMES];
+static pthread_mutex_t _fp512_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+  Auxiliary function: sets the FP512_LIMBS limbs of rop to those of the non-negative integer op.
+*/
+static void _fp512_split(ulong *rop, const fmpz_t op) {
+
+	mpz_t z;
+
+	mpz_init(z);
+	fmpz_get_mpz(z, op);
+	for(uint j = 0; j < FP512_LIMBS; j++) rop[j] = mpz_getlimbn(z, j);
+	mpz_clear(z);
+}
+
+/**
+  Auxiliary function: sets rop to the integer of limbs op.
+*/
+static void _fp512_join(fmpz_t rop, const ulong *op) {
+
+	mpz_t z;
+
+	mpz_init(z);
+	mpz_import(z, FP512_LIMBS, -1, sizeof(ulong), 0, 0, op);
+	fmpz_set_mpz(rop, z);
+	mpz_clear(z);
+}
+
+/**
+  Auxiliary function: sets rop to t + top 2^512 - p if it is non-negative, and to t otherwise,
+  for t + top 2^512 < 2p. Branch-free, rop may alias t.
+*/
+static void _fp512_csub(ulong *rop, const ulong *t, ulong top, const ulong *p) {
+
+	ulong d[FP512_LIMBS], borrow = 0, mask;
+	unsigned __int128 y;
+
+	for(uint j = 0; j < FP512_LIMBS; j++) {
+		y = (unsigned __int128)t[j] - p[j] - borrow;
+		d[j] = (ulong)y;
+		borrow = (ulong)(y >> 64) & 1;
+	}
+
+	// t + top 2^512 >= p if top is set or if t - p did not borrow
+	mask = -(top | (borrow ^ 1));
+	for(uint j = 0; j < FP512_LIMBS; j++) rop[j] = (d[j] & mask) | (t[j] & ~mask);
+}
+
+/******************************
+  Generic kernel
+******************************/
+/**
+  Sets rop to a*b/R with 128-bit products, Montgomery reduction interleaved row by row (CIOS).
+  rop may alias a or b.
+*/
+static void _fp512_mul_generic(ulong *rop, const ulong *a, const ulong *b, const fp512_ctx_t *ctx) {
+
+	ulong t[FP512_LIMBS + 2] = {0};
+	ulong m;
+	unsigned __int128 c;
+
+	for(uint i = 0; i < FP512_LIMBS; i++) {
+
+		//// t += a * b[i]
+		c = 0;
+		for(uint j = 0; j < FP512_LIMBS; j++) {
+			c += (unsigned __int128)a[j] * b[i] + t[j];
+			t[j] = (ulong)c;
+			c >>= 64;
+		}
+		c += t[FP512_LIMBS];
+		t[FP512_LIMBS] = (ulong)c;
+		t[FP512_LIMBS + 1] = (ulong)(c >> 64);
+
+		//// t = (t + m p) / 2^64, m clearing the lowest limb
+		m = t[0] * ctx->pinv;
+		c = (unsigned __int128)m * ctx->p[0] + t[0];
+		c >>= 64;
+		for(uint j = 1; j < FP512_LIMBS; j++) {
+			c += (unsigned __int128)m * ctx->p[j] + t[j];
+			t[j - 1] = (ulong)c;
+			c >>= 64;
+		}
+		c += t[FP512_LIMBS];
+		t[FP512_LIMBS - 1] = (ulong)c;
+		t[FP512_LIMBS] = t[FP512_LIMBS + 1] + (ulong)(c >> 64);
+	}
+
+	_fp512_csub(rop, t, t[FP512_LIMBS], ctx->p);
+}
+
+/**
+  Auxiliary function for the generic squaring: sets rop to t/R for t of 2 FP512_LIMBS limbs, which is destroyed.
+  The carry out of limb i + FP512_LIMBS is added back with the next row.
+*/
+static void _fp512_redc_generic(ulong *rop, ulong *t, const fp512_ctx_t *ctx) {
+
+	ulong m, top = 0;
+	unsigned __int128 c;
+
+	for(uint i = 0; i < FP512_LIMBS; i++) {
+		m = t[i] * ctx->pinv;
+		c = 0;
+		for(uint j = 0; j < FP512_LIMBS; j++) {
+			c += (unsigned __int128)m * ctx->p[j] + t[i + j];
+			t[i + j] = (ulong)c;
+			c >>= 64;
+		}
+		c += (unsigned __int128)t[i + FP512_LIMBS] + top;
+		t[i + FP512_LIMBS] = (ulong)c;
+		top = (ulong)(c >> 64);
+	}
+
+	_fp512_csub(rop, t + FP512_LIMBS, top, ctx->p);
+}
+
+/**
+  Sets rop to a^2/R: the products a[i]a[j] for i < j are computed once and doubled, then the squares a[i]^2 are added.
+  rop may alias a.
+*/
+static void _fp512_sqr_generic(ulong *rop, const ulong *a, const fp512_ctx_t *ctx) {
+
+	ulong t[2 * FP512_LIMBS] = {0};
+	ulong hi = 0, v;
+	unsigned __int128 c;
+
+	//// Off-diagonal products, row i only writes up to t[i + FP512_LIMBS]
+	for(uint i = 0; i < FP512_LIMBS - 1; i++) {
+		c = 0;
+		for(uint j = i + 1; j < FP512_LIMBS; j++) {
+			c += (unsigned __int128)a[i] * a[j] + t[i + j];
+			t[i + j] = (ulong)c;
+			c >>= 64;
+		}
+		t[i + FP512_LIMBS] = (ulong)c;
+	}
+
+	//// Doubled, plus the diagonal
+	for(uint k = 0; k < 2 * FP512_LIMBS; k++) {
+		v = t[k];
+		t[k] = (v << 1) | hi;
+		hi = v >> 63;
+	}
+	c = 0;
+	for(uint i = 0; i < FP512_LIMBS; i++) {
+		c += (unsigned __int128)a[i] * a[i] + t[2 * i];
+		t[2 * i] = (ulong)c;
+		c >>= 64;
+		c += t[2 * i + 1];
+		t[2 * i + 1] = (ulong)c;
+		c >>= 64;
+	}
+
+	_fp512_redc_generic(rop, t, ctx);
+}
+
+static int _fp512_always() {
+
+	return 1;
+}
+
+/******************************
+  GMP kernel
+******************************/
+/**
+  Auxiliary function for the GMP kernel: sets rop to t/R for t of 2 FP512_LIMBS limbs, which is destroyed,
+  one mpn_addmul_1 row per limb. Each row carries up to the top of t, and the carries out of it sum to at most 1.
+*/
+static void _fp512_redc_gmp(ulong *rop, mp_limb_t *t, const fp512_ctx_t *ctx) {
+
+	mp_limb_t c, top = 0;
+
+	for(uint i = 0; i < FP512_LIMBS; i++) {
+		c = mpn_addmul_1(t + i, ctx->p, FP512_LIMBS, t[i] * ctx->pinv);
+		top += mpn_add_1(t + i + FP512_LIMBS, t + i + FP512_LIMBS, FP512_LIMBS - i, c);
+	}
+
+	_fp512_csub(rop, t + FP512_LIMBS, top, ctx->p);
+}
+
+/**
+  Sets rop to a*b/R with mpn_mul_n. rop may alias a or b.
+*/
+static void _fp512_mul_gmp(ulong *rop, const ulong *a, const ulong *b, const fp512_ctx_t *ctx) {
+
+	mp_limb_t t[2 * FP512_LIMBS];
+
+	mpn_mul_n(t, a, b, FP512_LIMBS);
+	_fp512_redc_gmp(rop, t, ctx);
+}
+
+/**
+  Sets rop to a^2/R with mpn_sqr. rop may alias a.
+*/
+static void _fp512_sqr_gmp(ulong *rop, const ulong *a, const fp512_ctx_t *ctx) {
+
+	mp_limb_t t[2 * FP512_LIMBS];
+
+	mpn_sqr(t, a, FP512_LIMBS);
+	_fp512_redc_gmp(rop, t, ctx);
+}
+
+/******************************
+  MULX/ADCX/ADOX kernel
+******************************/
+#ifdef FP512_MULX
+// Frame of the mulx kernel, addressed from a single register: a, p, b, -1/p mod 2^64, a zero limb and the output
+#define FP512_F_A 0
+#define FP512_F_P 8
+#define FP512_F_B 16
+#define FP512_F_PINV 24
+#define FP512_F_ZERO 25
+#define FP512_F_OUT 26
+#define FP512_F_SIZE 35
+
+// t_hi:t_lo += src[j] * rdx, the low half on the CF chain of ADCX and the high half on the OF chain of ADOX
+#define _FP512_MAC(src, j, t_lo, t_hi) \
+	"mulxq 8*" #src "+8*" #j "(%%rbx), %%rax, %%rcx\n\t" \
+	"adcxq %%rax, %%" #t_lo "\n\t" \
+	"adoxq %%rcx, %%" #t_hi "\n\t"
+
+#define _FP512_ROW(src, t0, t1, t2, t3, t4, t5, t6, t7, t8) \
+	"xorl %%eax, %%eax\n\t" \
+	_FP512_MAC(src, 0, t0, t1) _FP512_MAC(src, 1, t1, t2) _FP512_MAC(src, 2, t2, t3) _FP512_MAC(src, 3, t3, t4) \
+	_FP512_MAC(src, 4, t4, t5) _FP512_MAC(src, 5, t5, t6) _FP512_MAC(src, 6, t6, t7) _FP512_MAC(src, 7, t7, t8)
+
+// One CIOS step on T = t0..t9, t9 being 0: T += a * b[i], then T += m * p for m = t0 * pinv, which zeroes t0.
+// The first sum fits in t0..t8, the second one carries into t9, and the next step runs on t1..t9, t0
+#define _FP512_STEP(i, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9) \
+	"movq 8*" #i "+8*16(%%rbx), %%rdx\n\t" \
+	_FP512_ROW(0, t0, t1, t2, t3, t4, t5, t6, t7, t8) \
+	"adcxq 8*25(%%rbx), %%" #t8 "\n\t" \
+	"movq %%" #t0 ", %%rdx\n\t" \
+	"imulq 8*24(%%rbx), %%rdx\n\t" \
+	_FP512_ROW(8, t0, t1, t2, t3, t4, t5, t6, t7, t8) \
+	"adoxq 8*25(%%rbx), %%" #t9 "\n\t" \
+	"adcxq 8*25(%%rbx), %%" #t8 "\n\t" \
+	"adcxq 8*25(%%rbx), %%" #t9 "\n\t"
+
+/**
+  Sets rop to a*b/R, Montgomery multiplication by operand scanning with the reduction interleaved (CIOS) in a single
+  block of assembly. T stays in a ring of 10 registers, each step shifting it down by a limb by renaming them.
+  With T < 2p at the start of a step and p < 2^512 - 2^448, see fp512_ctx_init, T + a * b[i] fits in 9 limbs.
+  rop may alias a or b.
+*/
+static void _fp512_mul_mulx(ulong *rop, const ulong *a, const ulong *b, const fp512_ctx_t *ctx) {
+
+	ulong f[FP512_F_SIZE];
+
+	memcpy(f + FP512_F_A, a, sizeof(fp512_t));
+	memcpy(f + FP512_F_P, ctx->p, sizeof(fp512_t));
+	memcpy(f + FP512_F_B, b, sizeof(fp512_t));
+	f[FP512_F_PINV] = ctx->pinv;
+	f[FP512_F_ZERO] = 0;
+
+	__asm__ volatile(
+		"xorl %%r8d, %%r8d\n\t"
+		"xorl %%r9d, %%r9d\n\t"
+		"xorl %%r10d, %%r10d\n\t"
+		"xorl %%r11d, %%r11d\n\t"
+		"xorl %%r12d, %%r12d\n\t"
+		"xorl %%r13d, %%r13d\n\t"
+		"xorl %%r14d, %%r14d\n\t"
+		"xorl %%r15d, %%r15d\n\t"
+		"xorl %%esi, %%esi\n\t"
+		"xorl %%edi, %%edi\n\t"
+		_FP512_STEP(0, r8, r9, r10, r11, r12, r13, r14, r15, rsi, rdi)
+		_FP512_STEP(1, r9, r10, r11, r12, r13, r14, r15, rsi, rdi, r8)
+		_FP512_STEP(2, r10, r11, r12, r13, r14, r15, rsi, rdi, r8, r9)
+		_FP512_STEP(3, r11, r12, r13, r14, r15, rsi, rdi, r8, r9, r10)
+		_FP512_STEP(4, r12, r13, r14, r15, rsi, rdi, r8, r9, r10, r11)
+		_FP512_STEP(5, r13, r14, r15, rsi, rdi, r8, r9, r10, r11, r12)
+		_FP512_STEP(6, r14, r15, rsi, rdi, r8, r9, r10, r11, r12, r13)
+		_FP512_STEP(7, r15, rsi, rdi, r8, r9, r10, r11, r12, r13, r14)
+		"movq %%rsi, 8*26(%%rbx)\n\t"
+		"movq %%rdi, 8*27(%%rbx)\n\t"
+		"movq %%r8, 8*28(%%rbx)\n\t"
+		"movq %%r9, 8*29(%%rbx)\n\t"
+		"movq %%r10, 8*30(%%rbx)\n\t"
+		"movq %%r11, 8*31(%%rbx)\n\t"
+		"movq %%r12, 8*32(%%rbx)\n\t"
+		"movq %%r13, 8*33(%%rbx)\n\t"
+		"movq %%r14, 8*34(%%rbx)\n\t"
+		:
+		: "b" (f)
+		: "rax", "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+
+	_fp512_csub(rop, f + FP512_F_OUT, f[FP512_F_OUT + FP512_LIMBS], ctx->p);
+}
+
+/**
+  Sets rop to a^2/R with _fp512_mul_mulx: the interleaved reduction leaves no room for the halved triangle
+  of the generic squaring, and mpn_sqr followed by a separate reduction measured no faster.
+*/
+static void _fp512_sqr_mulx(ulong *rop, const ulong *a, const fp512_ctx_t *ctx) {
+
+	_fp512_mul_mulx(rop, a, a, ctx);
+}
+
+/**
+  Returns 1 if the CPU has BMI2 (MULX) and ADX (ADCX, ADOX), read from CPUID leaf 7, and 0 otherwise.
+*/
+static int _fp512_mulx_supported() {
+
+	unsigned int eax, ebx, ecx, edx;
+
+	if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return 0;
+	return ((ebx >> 8) & 1) && ((ebx >> 19) & 1);
+}
+#endif
+
+/******************************
+  Dispatch
+******************************/
+// In order of preference
+const fp512_kernel_t fp512_kernels[] = {
+#ifdef FP512_MULX
+	{"mulx", _fp512_mul_mulx, _fp512_sqr_mulx, _fp512_mulx_supported, 1},
+#endif
+	{"generic", _fp512_mul_generic, _fp512_sqr_generic, _fp512_always, 0},
+	{"gmp", _fp512_mul_gmp, _fp512_sqr_gmp, _fp512_always, 0},
+};
+const uint fp512_nb_kernels = sizeof(fp512_kernels) / sizeof(fp512_kernel_t);
+
+/**
+  Auxiliary function for fp512_dispatch.
+*/
+static void _fp512_select() {
+
+	for(uint i = 0; i < fp512_nb_kernels; i++) {
+		if(fp512_kernels[i].supported()) {
+			_fp512_current = fp512_kernels + i;
+			return;
+		}
+	}
+}
+
+/**
+  Selects the first supported kernel of fp512_kernels. Only the first call does anything, and fp512_ctx_init makes it.
+*/
+void fp512_dispatch() {
+
+	pthread_once(&_fp512_once, _fp512_select);
+}
+
+/**
+  Returns the kernel in use.
+*/
+const fp512_kernel_t *fp512_kernel() {
+
+	fp512_dispatch();
+	return _fp512_current;
+}
+
+/**
+  Uses the kernel called name from now on. Meant for benchmarks: it must not run concurrently with any fp512 operation.
+  Returns 1 if successful and 0 if there is no such kernel or the CPU does not support it, leaving the kernel unchanged.
+*/
+int fp512_set_kernel(const char *name) {
+
+	fp512_dispatch();
+	for(uint i = 0; i < fp512_nb_kernels; i++) {
+		if(strcmp(fp512_kernels[i].name, name) || !fp512_kernels[i].supported()) continue;
+		_fp512_current = fp512_kernels + i;
+		return 1;
+	}
+
+	return 0;
+}
+
+/******************************
+  Contexts
+******************************/
+/**
+  Initializes ctx for the prime p, and selects the kernel with fp512_dispatch.
+  A corresponding call to fp512_ctx_clear() must be made after finishing with ctx.
+  Returns 1 if successful and 0 if p is even, at least 2^512 - 2^448 (the top limb of p must not be all ones,
+  for the carries of the mulx kernel) or if limbs are not 64-bit,
+  in which case ctx must not be used but must still be cleared.
+*/
+int fp512_ctx_init(fp512_ctx_t *ctx, const fmpz_t p) {
+
+	fmpz_t tmp;
+	ulong inv = 1;
+
+	fmpz_init_set(ctx->prime, p);
+	ctx->refs = 0;
+	if(GMP_LIMB_BITS != 64 || fmpz_is_even(p) || fmpz_bits(p) > 64 * FP512_LIMBS) return 0;
+
+	fmpz_init(tmp);
+	fp512_dispatch();
+
+	_fp512_split(ctx->p, p);
+	if(ctx->p[FP512_LIMBS - 1] == ~0UL) {
+		fmpz_clear(tmp);
+		return 0;
+	}
+
+	//// -1/p mod 2^64 by Newton iteration, each step doubles the number of correct bits
+	for(uint i = 0; i < 6; i++) inv *= 2 - ctx->p[0] * inv;
+	ctx->pinv = -inv;
+
+	//// R mod p and R^2 mod p
+	fmpz_one(tmp);
+	fmpz_mul_2exp(tmp, tmp, 64 * FP512_LIMBS);
+	fmpz_mod(tmp, tmp, p);
+	_fp512_split(ctx->one, tmp);
+	fmpz_mul(tmp, tmp, tmp);
+	fmpz_mod(tmp, tmp, p);
+	_fp512_split(ctx->R2, tmp);
+
+	fmpz_clear(tmp);
+	return 1;
+}
+
+/**
+  Clears ctx, releasing any memory used.
+*/
+void fp512_ctx_clear(fp512_ctx_t *ctx) {
+
+	fmpz_clear(ctx->prime);
+}
+
+/**
+  Registers a context for p, for the lookups of fp512_get. Registrations are counted, each one must be matched
+  by a call to fp512_unregister(). Does nothing if p is not supported, see fp512_ctx_init, or if FP512_MAX_PRIMES
+  primes are already registered. Registration must happen before the prime is used by several threads.
+*/
+void fp512_register(const fmpz_t p) {
+
+	fp512_ctx_t *free_ctx = NULL;
+
+	pthread_mutex_lock(&_fp512_lock);
+
+	for(uint i = 0; i < FP512_MAX_PRIMES; i++) {
+		if(_fp512_ctxs[i].refs && fmpz_equal(_fp512_ctxs[i].prime, p)) {
+			_fp512_ctxs[i].refs++;
+			pthread_mutex_unlock(&_fp512_lock);
+			return;
+		}
+		if(!_fp512_ctxs[i].refs && free_ctx == NULL) free_ctx = _fp512_ctxs + i;
+	}
+
+	if(free_ctx != NULL) {
+		if(fp512_ctx_init(free_ctx, p)) free_ctx->refs = 1;
+		else fp512_ctx_clear(free_ctx);
+	}
+
+	pthread_mutex_unlock(&_fp512_lock);
+}
+
+/**
+  Releases a registration of p made with fp512_register.
+*/
+void fp512_unregister(const fmpz_t p) {
+
+	pthread_mutex_lock(&_fp512_lock);
+
+	for(uint i = 0; i < FP512_MAX_PRIMES; i++) {
+		if(!_fp512_ctxs[i].refs || !fmpz_equal(_fp512_ctxs[i].prime, p)) continue;
+		if(--_fp512_ctxs[i].refs == 0) fp512_ctx_clear(_fp512_ctxs + i);
+		break;
+	}
+
+	pthread_mutex_unlock(&_fp512_lock);
+}
+
+/**
+  Returns the context registered for p, or NULL if there is none.
+*/
+const fp512_ctx_t *fp512_get(const fmpz_t p) {
+
+	for(uint i = 0; i < FP512_MAX_PRIMES; i++) {
+		if(_fp512_ctxs[i].refs && fmpz_equal(_fp512_ctxs[i].prime, p)) return _fp512_ctxs + i;
+	}
+
+	return NULL;
+}
+
+/******************************
+  Arithmetic
+******************************/
+/**
+  Sets rop to the Montgomery form of op mod p.
+*/
+void fp512_set_fmpz(fp512_t rop, const fmpz_t op, const fp512_ctx_t *ctx) {
+
+	fmpz_t tmp;
+	ulong a[FP512_LIMBS];
+
+	fmpz_init(tmp);
+	fmpz_mod(tmp, op, ctx->prime);
+	_fp512_split(a, tmp);
+	_fp512_current->mul(rop, a, ctx->R2, ctx);
+	fmpz_clear(tmp);
+}
+
+/**
+  Sets rop to the integer in [0, p) of Montgomery form op.
+*/
+void fp512_get_fmpz(fmpz_t rop, const fp512_t op, const fp512_ctx_t *ctx) {
+
+	ulong a[FP512_LIMBS], one[FP512_LIMBS] = {1};
+
+	_fp512_current->mul(a, op, one, ctx);
+	_fp512_join(rop, a);
+}
+
+/**
+  Sets rop to op1*op2 with the dispatched kernel.
+*/
+void fp512_mul(fp512_t rop, const fp512_t op1, const fp512_t op2, const fp512_ctx_t *ctx) {
+
+	_fp512_current->mul(rop, op1, op2, ctx);
+}
+
+/**
+  Sets rop to op^2 with the dispatched kernel.
+*/
+void fp512_sqr(fp512_t rop, const fp512_t op, const fp512_ctx_t *ctx) {
+
+	_fp512_current->sqr(rop, op, ctx);
+}
+
+/**
+  Sets rop to op1 + op2.
+*/
+void fp512_add(fp512_t rop, const fp512_t op1, const fp512_t op2, const fp512_ctx_t *ctx) {
+
+	ulong t[FP512_LIMBS], top;
+
+	top = mpn_add_n(t, op1, op2, FP512_LIMBS);
+	_fp512_csub(rop, t, top, ctx->p);
+}
+
+/**
+  Sets rop to op1 - op2.
+*/
+void fp512_sub(fp512_t rop, const fp512_t op1, const fp512_t op2, const fp512_ctx_t *ctx) {
+
+	if(mpn_sub_n(rop, op1, op2, FP512_LIMBS)) mpn_add_n(rop, rop, ctx->p, FP512_LIMBS);
+}
+
+/**
+  Sets rop to -op.
+*/
+void fp512_neg(fp512_t rop, const fp512_t op, const fp512_ctx_t *ctx) {
+
+	fp512_t zero = {0};
+
+	fp512_sub(rop, zero, op, ctx);
+}
+
+/**
+  Sets rop to c*op, by a chain of additions.
+*/
+void fp512_mul_ui(fp512_t rop, const fp512_t op, ulong c, const fp512_ctx_t *ctx) {
+
+	fp512_t acc = {0};
+	int top = 8 * sizeof(ulong) - 1;
+
+	while(top >= 0 && !((c >> top) & 1)) top--;
+
+	for(int i = top; i >= 0; i--) {
+		fp512_add(acc, acc, acc, ctx);
+		if((c >> i) & 1) fp512_add(acc, acc, op, ctx);
+	}
+
+	memcpy(rop, acc, sizeof(fp512_t));
+}
+
+/**
+  Returns 1 if op1 and op2 are equal and 0 otherwise.
+*/
+int fp512_equal(const fp512_t op1, const fp512_t op2) {
+
+	return !memcmp(op1, op2, sizeof(fp512_t));
+}
+
+/**
+  Sets rop to op^e for a non-negative e.
+  Sliding windows of up to 5 bits over the odd powers of op, 1 bit for short exponents. rop may alias op.
+*/
+void fp512_pow(fp512_t rop, const fp512_t op, const fmpz_t e, const fp512_ctx_t *ctx) {
+
+	fp512_t table[16], acc, sq;
+	uint width = (fmpz_bits(e) > 32) ? 5 : 1;
+	slong bit = (slong)fmpz_bits(e) - 1;
+	slong low;
+	uint d;
+
+	//// table[k] = op^(2k+1)
+	memcpy(table[0], op, sizeof(fp512_t));
+	fp512_sqr(sq, op, ctx);
+	for(uint k = 1; k < (1U << (width - 1)); k++) fp512_mul(table[k], table[k - 1], sq, ctx);
+
+	//// Sliding windows: each one starts at a set bit and ends at a set bit at most width - 1 bits below
+	memcpy(acc, ctx->one, sizeof(fp512_t));
+	while(bit >= 0) {
+		if(!fmpz_tstbit(e, bit)) {
+			fp512_sqr(acc, acc, ctx);
+			bit--;
+			continue;
+		}
+
+		low = (bit - (slong)width + 1 > 0) ? bit - (slong)width + 1 : 0;
+		while(!fmpz_tstbit(e, low)) low++;
+
+		d = 0;
+		for(slong i = bit; i >= low; i--) {
+			d = 2 * d + fmpz_tstbit(e, i);
+			fp512_sqr(acc, acc, ctx);
+		}
+		fp512_mul(acc, acc, table[d >> 1], ctx);
+		bit = low - 1;
+	}
+
+	memcpy(rop, acc, sizeof(fp512_t));
+}
+
+/**
+  Sets rop to a^e mod p with the context registered for p, as fmpz_powm.
+  Returns 1 if successful, and 0 if no context is registered for p, if e is negative or if the kernel in use
+  is not fast, i.e. not faster than fmpz_powm, in which case rop is left unchanged and the caller should use fmpz_powm.
+*/
+int fp512_powm(fmpz_t rop, const fmpz_t a, const fmpz_t e, const fmpz_t p) {
+
+	const fp512_ctx_t *ctx = fp512_get(p);
+	fp512_t x;
+
+	if(ctx == NULL || fmpz_sgn(e) < 0 || !_fp512_current->fast) return 0;
+
+	fp512_set_fmpz(x, a, ctx);
+	fp512_pow(x, x, e, ctx);
+	fp512_get_fmpz(rop, x, ctx);
+
+	return 1;
+}
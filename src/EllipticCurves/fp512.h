@@ -0,0 +1,77 @@
+/// @file fp512.h
+#ifndef _FP512_H_
+#define _FP512_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+
+/*********************************************
+   512-bit Montgomery arithmetic with runtime kernel dispatch
+*********************************************/
+// Elements of F_p for p of at most 512 bits, as FP512_LIMBS 64-bit limbs in Montgomery form with R = 2^512,
+// fully reduced in [0, p). The multiplication and squaring kernels come in several variants:
+//	- "mulx": inline assembly with MULX and the two carry chains of ADCX/ADOX, x86-64 with BMI2 and ADX only,
+//	- "generic": portable C with 128-bit products, unrolled by the compiler,
+//	- "gmp": mpn_mul_n / mpn_sqr then a reduction by mpn_addmul_1 rows.
+// fp512_dispatch picks the first supported one in this order from CPUID, once per process; fp512_set_kernel
+// forces another, for benchmarks. Only mulx is faster than fmpz_powm (by about 10% against GMP's mpz_powm,
+// where generic and gmp are 1.9x and 1.4x slower), so that it is the only kernel marked fast. With a fast kernel,
+// the prime field exponentiations of the walks (fq_pow_fast and the radical roots) go through fp512_powm with
+// the context registered by cfg_init_set for the base prime, and the radical walks of degree 3, 5 and 7 over F_p
+// run in Montgomery form, see radical_isogeny_3_fp512; otherwise they all stay with FLINT.
+#define FP512_LIMBS 8
+#define FP512_MAX_PRIMES 8
+
+typedef ulong fp512_t[FP512_LIMBS];
+
+typedef struct fp512_ctx_t {
+
+	fp512_t p;		// limbs of p
+	ulong pinv;		// -1/p mod 2^64
+	fp512_t one;		// R mod p
+	fp512_t R2;		// R^2 mod p, to convert to Montgomery form
+	fmpz_t prime;
+	uint refs;		// registrations, see fp512_register
+} fp512_ctx_t;
+
+typedef struct fp512_kernel_t {
+
+	const char *name;
+	void (*mul)(ulong *, const ulong *, const ulong *, const fp512_ctx_t *);
+	void (*sqr)(ulong *, const ulong *, const fp512_ctx_t *);
+	int (*supported)();
+	int fast;		// faster than fmpz_powm
+} fp512_kernel_t;
+
+extern const fp512_kernel_t fp512_kernels[];
+extern const uint fp512_nb_kernels;
+
+void fp512_dispatch();
+const fp512_kernel_t *fp512_kernel();
+int fp512_set_kernel(const char *);
+
+int fp512_ctx_init(fp512_ctx_t *, const fmpz_t);
+void fp512_ctx_clear(fp512_ctx_t *);
+
+void fp512_register(const fmpz_t);
+void fp512_unregister(const fmpz_t);
+const fp512_ctx_t *fp512_get(const fmpz_t);
+
+void fp512_set_fmpz(fp512_t, const fmpz_t, const fp512_ctx_t *);
+void fp512_get_fmpz(fmpz_t, const fp512_t, const fp512_ctx_t *);
+void fp512_add(fp512_t, const fp512_t, const fp512_t, const fp512_ctx_t *);
+void fp512_sub(fp512_t, const fp512_t, const fp512_t, const fp512_ctx_t *);
+void fp512_neg(fp512_t, const fp512_t, const fp512_ctx_t *);
+void fp512_mul_ui(fp512_t, const fp512_t, ulong, const fp512_ctx_t *);
+int fp512_equal(const fp512_t, const fp512_t);
+void fp512_mul(fp512_t, const fp512_t, const fp512_t, const fp512_ctx_t *);
+void fp512_sqr(fp512_t, const fp512_t, const fp512_ctx_t *);
+void fp512_pow(fp512_t, const fp512_t, const fmpz_t, const fp512_ctx_t *);
+int fp512_powm(fmpz_t, const fmpz_t, const fmpz_t, const fmpz_t);
+
+#endif
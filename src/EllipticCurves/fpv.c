@@ -0,0 +1,582 @@
+/// @file fpv.c
+#include "fpv.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define FPV_X86
+#endif
+
+static const fpv_kernel_t *_fpv_current = NULL;
+static pthread_once_t _fpv_once = PTHREAD_ONCE_INIT;
+
+/**
+  Auxiliary function: sets the FPV_LIMBS limbs of rop to those of the non-negative integer op.
+*/
+static void _fpv_split(ulong *rop, const fmpz_t op) {
+
+	fmpz_t tmp;
+
+	fmpz_init_set(tmp, op);
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		rop[j] = fmpz_fdiv_ui(tmp, 1UL << FPV_LIMB_BITS);
+		fmpz_fdiv_q_2exp(tmp, tmp, FPV_LIMB_BITS);
+	}
+	fmpz_clear(tmp);
+}
+
+/**
+  Auxiliary function: subtracts q from the lanes of rop which are at least q.
+  The limbs of rop must be reduced.
+*/
+static void _fpv_csub(fpv_t *rop, const ulong *q) {
+
+	ulong d[FPV_LIMBS][FPV_LANES];
+	slong borrow[FPV_LANES] = {0};
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		for(uint k = 0; k < FPV_LANES; k++) {
+			slong y = (slong)rop->v[j][k] - (slong)q[j] + borrow[k];
+			d[j][k] = y & FPV_MASK;
+			borrow[k] = y >> FPV_LIMB_BITS;
+		}
+	}
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		for(uint k = 0; k < FPV_LANES; k++) {
+			rop->v[j][k] = (borrow[k] < 0) ? rop->v[j][k] : d[j][k];
+		}
+	}
+}
+
+/**
+  Auxiliary function: sets rop to op1 + op2 if sign > 0, and to op1 - op2 + 2p otherwise, lazily reduced.
+*/
+static void _fpv_addsub(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, int sign, fpv_ctx_t *ctx) {
+
+	slong carry[FPV_LANES] = {0};
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		slong c = (sign > 0) ? 0 : ctx->p2[j];
+
+		for(uint k = 0; k < FPV_LANES; k++) {
+			slong y = (slong)op1->v[j][k] + ((sign > 0) ? (slong)op2->v[j][k] : -(slong)op2->v[j][k]) + c + carry[k];
+			rop->v[j][k] = y & FPV_MASK;
+			carry[k] = y >> FPV_LIMB_BITS;
+		}
+	}
+
+	_fpv_csub(rop, ctx->p2);
+}
+
+/**
+  Initializes ctx for the prime field F, and selects the kernel with fpv_dispatch.
+  A corresponding call to fpv_ctx_clear() must be made after finishing with ctx.
+  Returns 1 if successful and 0 if F is not a prime field or if its characteristic has more than FPV_MAX_BITS bits,
+  in which case ctx must not be used but must still be cleared.
+*/
+int fpv_ctx_init(fpv_ctx_t *ctx, const fq_ctx_t F) {
+
+	fmpz_t tmp;
+	ulong limbs[FPV_LIMBS], inv = 1;
+
+	fpv_dispatch();
+
+	fmpz_init(tmp);
+	fmpz_init_set(ctx->prime, fq_ctx_prime(F));
+	fmpz_init(ctx->R);
+	fmpz_init(ctx->Rinv);
+
+	if(fq_ctx_degree(F) != 1 || fmpz_bits(ctx->prime) > FPV_MAX_BITS) {
+		fmpz_clear(tmp);
+		return 0;
+	}
+
+	//// Limbs of p and 2p
+	_fpv_split(ctx->p, ctx->prime);
+	fmpz_mul_ui(tmp, ctx->prime, 2);
+	_fpv_split(ctx->p2, tmp);
+
+	//// -1/p mod 2^52 by Newton iteration, each step doubles the number of correct bits
+	for(uint i = 0; i < 6; i++) inv *= 2 - ctx->p[0] * inv;
+	ctx->pinv = (-inv) & FPV_MASK;
+
+	//// R mod p, its inverse and the Montgomery form of 1
+	fmpz_one(tmp);
+	fmpz_mul_2exp(tmp, tmp, FPV_LIMBS * FPV_LIMB_BITS);
+	fmpz_mod(ctx->R, tmp, ctx->prime);
+	fmpz_invmod(ctx->Rinv, ctx->R, ctx->prime);
+
+	_fpv_split(limbs, ctx->R);
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		for(uint k = 0; k < FPV_LANES; k++) ctx->one.v[j][k] = limbs[j];
+	}
+
+	fmpz_clear(tmp);
+	return 1;
+}
+
+/**
+  Clears ctx, releasing any memory used.
+*/
+void fpv_ctx_clear(fpv_ctx_t *ctx) {
+
+	fmpz_clear(ctx->prime);
+	fmpz_clear(ctx->R);
+	fmpz_clear(ctx->Rinv);
+}
+
+/**
+  Sets the lane of rop to op, an element of the prime field F of ctx.
+*/
+void fpv_set_fq(fpv_t *rop, uint lane, const fq_t op, const fq_ctx_t F, fpv_ctx_t *ctx) {
+
+	fmpz_t tmp;
+	ulong limbs[FPV_LIMBS];
+
+	fmpz_init(tmp);
+
+	fq_get_fmpz(tmp, op, F);
+	fmpz_mul(tmp, tmp, ctx->R);
+	fmpz_mod(tmp, tmp, ctx->prime);
+
+	_fpv_split(limbs, tmp);
+	for(uint j = 0; j < FPV_LIMBS; j++) rop->v[j][lane] = limbs[j];
+
+	fmpz_clear(tmp);
+}
+
+/**
+  Sets rop to the lane of op, as an element of the prime field F of ctx.
+*/
+void fpv_get_fq(fq_t rop, const fpv_t *op, uint lane, const fq_ctx_t F, fpv_ctx_t *ctx) {
+
+	fmpz_t tmp;
+
+	fmpz_init(tmp);
+
+	for(int j = FPV_LIMBS - 1; j >= 0; j--) {
+		fmpz_mul_2exp(tmp, tmp, FPV_LIMB_BITS);
+		fmpz_add_ui(tmp, tmp, op->v[j][lane]);
+	}
+	fmpz_mul(tmp, tmp, ctx->Rinv);
+	fmpz_mod(tmp, tmp, ctx->prime);
+	fq_set_fmpz(rop, tmp, F);
+
+	fmpz_clear(tmp);
+}
+
+/**
+  Sets every lane of rop to 0.
+*/
+void fpv_zero(fpv_t *rop) {
+
+	memset(rop, 0, sizeof(fpv_t));
+}
+
+/**
+  Sets every lane of rop to 1.
+*/
+void fpv_one(fpv_t *rop, fpv_ctx_t *ctx) {
+
+	fpv_set(rop, &ctx->one);
+}
+
+/**
+  Sets rop to op.
+*/
+void fpv_set(fpv_t *rop, const fpv_t *op) {
+
+	if(rop != op) memcpy(rop, op, sizeof(fpv_t));
+}
+
+/**
+  Sets the lanes of rop whose bit is set in mask to those of op, leaving the others untouched.
+*/
+void fpv_select(fpv_t *rop, const fpv_t *op, uint mask) {
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		for(uint k = 0; k < FPV_LANES; k++) {
+			rop->v[j][k] = ((mask >> k) & 1) ? op->v[j][k] : rop->v[j][k];
+		}
+	}
+}
+
+/**
+  Sets rop to op1 + op2.
+*/
+void fpv_add(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	_fpv_addsub(rop, op1, op2, 1, ctx);
+}
+
+/**
+  Sets rop to op1 - op2.
+*/
+void fpv_sub(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	_fpv_addsub(rop, op1, op2, -1, ctx);
+}
+
+/**
+  Sets rop to -op.
+*/
+void fpv_neg(fpv_t *rop, const fpv_t *op, fpv_ctx_t *ctx) {
+
+	fpv_t zero;
+
+	fpv_zero(&zero);
+	_fpv_addsub(rop, &zero, op, -1, ctx);
+}
+
+/**
+  Sets rop to c*op, by a chain of additions.
+*/
+void fpv_mul_ui(fpv_t *rop, const fpv_t *op, ulong c, fpv_ctx_t *ctx) {
+
+	fpv_t acc;
+	int top = 8 * sizeof(ulong) - 1;
+
+	while(top >= 0 && !((c >> top) & 1)) top--;
+
+	fpv_zero(&acc);
+	for(int i = top; i >= 0; i--) {
+		fpv_add(&acc, &acc, &acc, ctx);
+		if((c >> i) & 1) fpv_add(&acc, &acc, op, ctx);
+	}
+
+	fpv_set(rop, &acc);
+}
+
+/******************************
+  Scalar kernel
+******************************/
+/**
+  Sets rop to op1*op2/R, lazily reduced.
+  Product scanning with the Montgomery reduction interleaved, one lane at a time:
+  every column is summed in a single 128-bit accumulator.
+*/
+static void _fpv_mul_scalar(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	unsigned __int128 acc;
+	ulong a[FPV_LIMBS], b[FPV_LIMBS], m[FPV_LIMBS];
+
+	for(uint k = 0; k < FPV_LANES; k++) {
+		for(uint j = 0; j < FPV_LIMBS; j++) {
+			a[j] = op1->v[j][k];
+			b[j] = op2->v[j][k];
+		}
+		acc = 0;
+
+		//// Lower columns, which set the multiples of p
+		for(uint i = 0; i < FPV_LIMBS; i++) {
+			for(uint j = 0; j < i; j++) {
+				acc += (unsigned __int128)a[j] * b[i - j];
+				acc += (unsigned __int128)m[j] * ctx->p[i - j];
+			}
+			acc += (unsigned __int128)a[i] * b[0];
+			m[i] = ((ulong)acc * ctx->pinv) & FPV_MASK;
+			acc += (unsigned __int128)m[i] * ctx->p[0];
+			acc >>= FPV_LIMB_BITS;
+		}
+
+		//// Upper columns, which are the result
+		for(uint i = FPV_LIMBS; i < 2 * FPV_LIMBS; i++) {
+			for(uint j = i - FPV_LIMBS + 1; j < FPV_LIMBS; j++) {
+				acc += (unsigned __int128)a[j] * b[i - j];
+				acc += (unsigned __int128)m[j] * ctx->p[i - j];
+			}
+			rop->v[i - FPV_LIMBS][k] = (ulong)acc & FPV_MASK;
+			acc >>= FPV_LIMB_BITS;
+		}
+	}
+}
+
+static int _fpv_always() {
+
+	return 1;
+}
+
+#ifdef FPV_X86
+/**
+  Auxiliary function: returns 1 if the OS saves the register states of mask in XCR0, read with XGETBV, and 0 otherwise.
+*/
+static int _fpv_os_saves(unsigned int mask) {
+
+	unsigned int eax, ebx, ecx, edx, lo, hi;
+
+	if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !((ecx >> 27) & 1)) return 0;
+	__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return (lo & mask) == mask;
+}
+
+/******************************
+  AVX-512 IFMA kernel
+******************************/
+/**
+  Sets rop to op1*op2/R, lazily reduced.
+  Schoolbook product then word by word Montgomery reduction, each lane in a 64-bit slot of the vectors.
+  The 104-bit partial products are split between two columns by the IFMA instructions.
+*/
+__attribute__((target("avx512f,avx512ifma")))
+static void _fpv_mul_ifma(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	__m512i a[FPV_LIMBS], b[FPV_LIMBS], t[2 * FPV_LIMBS + 1];
+	__m512i zero = _mm512_setzero_si512(), mask = _mm512_set1_epi64(FPV_MASK);
+	__m512i pinv = _mm512_set1_epi64(ctx->pinv), m, pj;
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		a[j] = _mm512_load_si512(op1->v[j]);
+		b[j] = _mm512_load_si512(op2->v[j]);
+	}
+	for(uint j = 0; j < 2 * FPV_LIMBS + 1; j++) t[j] = zero;
+
+	//// Product
+	for(uint i = 0; i < FPV_LIMBS; i++) {
+		for(uint j = 0; j < FPV_LIMBS; j++) {
+			t[i + j] = _mm512_madd52lo_epu64(t[i + j], a[i], b[j]);
+			t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], a[i], b[j]);
+		}
+	}
+
+	//// Reduction
+	for(uint i = 0; i < FPV_LIMBS; i++) {
+		m = _mm512_madd52lo_epu64(zero, t[i], pinv);
+		for(uint j = 0; j < FPV_LIMBS; j++) {
+			pj = _mm512_set1_epi64(ctx->p[j]);
+			t[i + j] = _mm512_madd52lo_epu64(t[i + j], m, pj);
+			t[i + j + 1] = _mm512_madd52hi_epu64(t[i + j + 1], m, pj);
+		}
+		t[i + 1] = _mm512_add_epi64(t[i + 1], _mm512_srli_epi64(t[i], FPV_LIMB_BITS));
+	}
+
+	//// Carries of the upper half
+	for(uint j = FPV_LIMBS; j < 2 * FPV_LIMBS; j++) {
+		t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], FPV_LIMB_BITS));
+		_mm512_store_si512(rop->v[j - FPV_LIMBS], _mm512_and_si512(t[j], mask));
+	}
+}
+
+/**
+  Returns 1 if the CPU has AVX-512F and IFMA, read from CPUID leaf 7, and the OS saves the AVX-512 registers, and 0 otherwise.
+*/
+static int _fpv_ifma_supported() {
+
+	unsigned int eax, ebx, ecx, edx;
+
+	if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return 0;
+	return ((ebx >> 16) & 1) && ((ebx >> 21) & 1) && _fpv_os_saves(0xe6);
+}
+
+/******************************
+  AVX2 kernel
+******************************/
+// VPMULUDQ multiplies the low 32 bits of each 64-bit slot, so the limbs are split in two digits of FPV_DIGIT_BITS bits.
+// The radix 2^26 Montgomery reduction over twice as many digits divides by the same R.
+// A column gets at most 2 * FPV_DIGITS products of 52 bits and a carry, which stays below 2^58.
+// That is four times the products of the 52-bit limbs, for four lanes per vector: no faster than the scalar kernel.
+#define FPV_DIGIT_BITS (FPV_LIMB_BITS / 2)
+#define FPV_DIGITS (2 * FPV_LIMBS)
+
+/**
+  Sets rop to op1*op2/R, lazily reduced.
+  Product scanning in radix 2^26 with the Montgomery reduction interleaved, as in the scalar kernel,
+  four lanes per 256-bit vector and the two halves of the lanes one after the other.
+*/
+__attribute__((target("avx2")))
+static void _fpv_mul_avx2(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	__m256i a[FPV_DIGITS], b[FPV_DIGITS], p[FPV_DIGITS], m[FPV_DIGITS], r[FPV_DIGITS], x, y, acc;
+	__m256i mask = _mm256_set1_epi64x((1UL << FPV_DIGIT_BITS) - 1);
+	__m256i pinv = _mm256_set1_epi64x(ctx->pinv & ((1UL << FPV_DIGIT_BITS) - 1));
+
+	for(uint j = 0; j < FPV_LIMBS; j++) {
+		p[2 * j] = _mm256_set1_epi64x(ctx->p[j] & ((1UL << FPV_DIGIT_BITS) - 1));
+		p[2 * j + 1] = _mm256_set1_epi64x(ctx->p[j] >> FPV_DIGIT_BITS);
+	}
+
+	for(uint h = 0; h < FPV_LANES; h += 4) {
+		for(uint j = 0; j < FPV_LIMBS; j++) {
+			x = _mm256_load_si256((const __m256i *)(op1->v[j] + h));
+			y = _mm256_load_si256((const __m256i *)(op2->v[j] + h));
+			a[2 * j] = _mm256_and_si256(x, mask);
+			a[2 * j + 1] = _mm256_srli_epi64(x, FPV_DIGIT_BITS);
+			b[2 * j] = _mm256_and_si256(y, mask);
+			b[2 * j + 1] = _mm256_srli_epi64(y, FPV_DIGIT_BITS);
+		}
+		acc = _mm256_setzero_si256();
+
+		//// Lower columns, which set the multiples of p; m only depends on the low 26 bits of acc
+		for(uint i = 0; i < FPV_DIGITS; i++) {
+			for(uint j = 0; j < i; j++) {
+				acc = _mm256_add_epi64(acc, _mm256_mul_epu32(a[j], b[i - j]));
+				acc = _mm256_add_epi64(acc, _mm256_mul_epu32(m[j], p[i - j]));
+			}
+			acc = _mm256_add_epi64(acc, _mm256_mul_epu32(a[i], b[0]));
+			m[i] = _mm256_and_si256(_mm256_mul_epu32(acc, pinv), mask);
+			acc = _mm256_add_epi64(acc, _mm256_mul_epu32(m[i], p[0]));
+			acc = _mm256_srli_epi64(acc, FPV_DIGIT_BITS);
+		}
+
+		//// Upper columns, which are the result
+		for(uint i = FPV_DIGITS; i < 2 * FPV_DIGITS; i++) {
+			for(uint j = i - FPV_DIGITS + 1; j < FPV_DIGITS; j++) {
+				acc = _mm256_add_epi64(acc, _mm256_mul_epu32(a[j], b[i - j]));
+				acc = _mm256_add_epi64(acc, _mm256_mul_epu32(m[j], p[i - j]));
+			}
+			r[i - FPV_DIGITS] = _mm256_and_si256(acc, mask);
+			acc = _mm256_srli_epi64(acc, FPV_DIGIT_BITS);
+		}
+
+		//// Two digits to a limb
+		for(uint j = 0; j < FPV_LIMBS; j++) {
+			x = _mm256_or_si256(r[2 * j], _mm256_slli_epi64(r[2 * j + 1], FPV_DIGIT_BITS));
+			_mm256_store_si256((__m256i *)(rop->v[j] + h), x);
+		}
+	}
+}
+
+/**
+  Returns 1 if the CPU has AVX2, read from CPUID leaf 7, and the OS saves the AVX registers, and 0 otherwise.
+*/
+static int _fpv_avx2_supported() {
+
+	unsigned int eax, ebx, ecx, edx;
+
+	if(!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return 0;
+	return ((ebx >> 5) & 1) && _fpv_os_saves(0x6);
+}
+#endif
+
+/******************************
+  Dispatch
+******************************/
+// In order of preference
+const fpv_kernel_t fpv_kernels[] = {
+#ifdef FPV_X86
+	{"avx512ifma", _fpv_mul_ifma, _fpv_ifma_supported, 1},
+	{"avx2", _fpv_mul_avx2, _fpv_avx2_supported, 0},
+#endif
+	{"scalar", _fpv_mul_scalar, _fpv_always, 0},
+};
+const uint fpv_nb_kernels = sizeof(fpv_kernels) / sizeof(fpv_kernel_t);
+
+/**
+  Auxiliary function for fpv_dispatch.
+*/
+static void _fpv_select() {
+
+	for(uint i = 0; i < fpv_nb_kernels; i++) {
+		if(fpv_kernels[i].supported()) {
+			_fpv_current = fpv_kernels + i;
+			return;
+		}
+	}
+}
+
+/**
+  Selects the first supported kernel of fpv_kernels. Only the first call does anything, and fpv_ctx_init makes it.
+*/
+void fpv_dispatch() {
+
+	pthread_once(&_fpv_once, _fpv_select);
+}
+
+/**
+  Returns the kernel in use.
+*/
+const fpv_kernel_t *fpv_kernel() {
+
+	fpv_dispatch();
+	return _fpv_current;
+}
+
+/**
+  Uses the kernel called name from now on. Meant for benchmarks: it must not run concurrently with any fpv operation.
+  Returns 1 if successful and 0 if there is no such kernel or the CPU does not support it, leaving the kernel unchanged.
+*/
+int fpv_set_kernel(const char *name) {
+
+	fpv_dispatch();
+	for(uint i = 0; i < fpv_nb_kernels; i++) {
+		if(strcmp(fpv_kernels[i].name, name) || !fpv_kernels[i].supported()) continue;
+		_fpv_current = fpv_kernels + i;
+		return 1;
+	}
+
+	return 0;
+}
+
+/******************************
+  Multiplication
+******************************/
+/**
+  Sets rop to op1*op2/R, lazily reduced, with the dispatched kernel.
+*/
+void fpv_mul(fpv_t *rop, const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	_fpv_current->mul(rop, op1, op2, ctx);
+}
+
+/**
+  Sets rop to op^2.
+*/
+void fpv_sqr(fpv_t *rop, const fpv_t *op, fpv_ctx_t *ctx) {
+
+	fpv_mul(rop, op, op, ctx);
+}
+
+/**
+  Sets rop to op^e for a non-negative e, the same in every lane.
+  Fixed window of 4 bits, 1 bit for short exponents; e is shared by the lanes, which all take the same time.
+*/
+void fpv_pow(fpv_t *rop, const fpv_t *op, const fmpz_t e, fpv_ctx_t *ctx) {
+
+	fpv_t table[16], acc;
+	uint width = (fmpz_bits(e) > 32) ? 4 : 1;
+	slong nb_windows = (fmpz_bits(e) + width - 1) / width;
+	uint d;
+
+	fpv_one(table, ctx);
+	for(uint i = 1; i < (1U << width); i++) fpv_mul(table + i, table + i - 1, op, ctx);
+
+	fpv_one(&acc, ctx);
+	for(slong w = nb_windows - 1; w >= 0; w--) {
+		d = 0;
+		for(int i = width - 1; i >= 0; i--) d = 2 * d + fmpz_tstbit(e, width * w + i);
+
+		if(w != nb_windows - 1) {
+			for(uint i = 0; i < width; i++) fpv_sqr(&acc, &acc, ctx);
+			if(d) fpv_mul(&acc, &acc, table + d, ctx);
+		}
+		else fpv_set(&acc, table + d);
+	}
+
+	fpv_set(rop, &acc);
+}
+
+/**
+  Returns the mask of the lanes where op1 and op2 are equal.
+*/
+uint fpv_equal(const fpv_t *op1, const fpv_t *op2, fpv_ctx_t *ctx) {
+
+	fpv_t a, b;
+	uint mask = 0;
+
+	fpv_set(&a, op1);
+	fpv_set(&b, op2);
+
+	//// Full reduction from [0, 2p]
+	for(uint i = 0; i < 2; i++) {
+		_fpv_csub(&a, ctx->p);
+		_fpv_csub(&b, ctx->p);
+	}
+
+	for(uint k = 0; k < FPV_LANES; k++) {
+		uint equal = 1;
+		for(uint j = 0; j < FPV_LIMBS; j++) equal &= (a.v[j][k] == b.v[j][k]);
+		mask |= equal << k;
+	}
+
+	return mask;
+}
@@ -0,0 +1,84 @@
+/// @file fpv.h
+#ifndef _FPV_H_
+#define _FPV_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*********************************************
+   Multi-lane prime field arithmetic
+*********************************************/
+// An fpv_t holds FPV_LANES independent elements of F_p, for p below 2^FPV_MAX_BITS,
+// in Montgomery form with R = 2^(FPV_LIMBS * FPV_LIMB_BITS), limb-major so that a limb of all the lanes
+// is contiguous. Every lane goes through the same operations, which lets whole batches of walks run in lockstep.
+// Values are kept lazily reduced in [0, 2p]: only fpv_equal and fpv_get_fq reduce them fully.
+// The multiplication kernels come in several variants:
+//	- "avx512ifma": eight lanes per vector with the 52-bit multiply-adds of AVX-512 IFMA,
+//	- "avx2": four lanes per vector with VPMULUDQ, on the limbs split in 26-bit digits,
+//	- "scalar": portable C with 128-bit products, one lane at a time.
+// fpv_dispatch picks the first supported one in this order from CPUID, once per process; fpv_set_kernel forces
+// another, for benchmarks. The other operations are written lane by lane for the compiler to vectorize.
+// Only IFMA makes up for the 100 products of 52 bits against 64 of 64 bits for GMP: walk_rad_lanes goes back
+// to walk_rad when the kernel in use is not marked fast.
+#define FPV_LIMB_BITS 52
+#define FPV_LIMBS 10
+#define FPV_LANES 8
+#define FPV_MASK ((1UL << FPV_LIMB_BITS) - 1)
+#define FPV_MAX_BITS (FPV_LIMBS * FPV_LIMB_BITS - 2)
+
+typedef struct fpv_t {
+
+	ulong v[FPV_LIMBS][FPV_LANES];
+} __attribute__((aligned(64))) fpv_t;
+
+typedef struct fpv_ctx_t {
+
+	ulong p[FPV_LIMBS];	// limbs of p
+	ulong p2[FPV_LIMBS];	// limbs of 2p
+	ulong pinv;		// -1/p mod 2^FPV_LIMB_BITS
+	fpv_t one;		// R mod p in every lane
+	fmpz_t prime;
+	fmpz_t R, Rinv;		// R mod p and 1/R mod p, to convert from and to Montgomery form
+} fpv_ctx_t;
+
+typedef struct fpv_kernel_t {
+
+	const char *name;
+	void (*mul)(fpv_t *, const fpv_t *, const fpv_t *, fpv_ctx_t *);
+	int (*supported)();
+	int fast;		// faster than walk_rad one lane at a time
+} fpv_kernel_t;
+
+extern const fpv_kernel_t fpv_kernels[];
+extern const uint fpv_nb_kernels;
+
+void fpv_dispatch();
+const fpv_kernel_t *fpv_kernel();
+int fpv_set_kernel(const char *);
+
+int fpv_ctx_init(fpv_ctx_t *, const fq_ctx_t);
+void fpv_ctx_clear(fpv_ctx_t *);
+
+void fpv_set_fq(fpv_t *, uint, const fq_t, const fq_ctx_t, fpv_ctx_t *);
+void fpv_get_fq(fq_t, const fpv_t *, uint, const fq_ctx_t, fpv_ctx_t *);
+void fpv_zero(fpv_t *);
+void fpv_one(fpv_t *, fpv_ctx_t *);
+void fpv_set(fpv_t *, const fpv_t *);
+void fpv_select(fpv_t *, const fpv_t *, uint);
+
+void fpv_add(fpv_t *, const fpv_t *, const fpv_t *, fpv_ctx_t *);
+void fpv_sub(fpv_t *, const fpv_t *, const fpv_t *, fpv_ctx_t *);
+void fpv_neg(fpv_t *, const fpv_t *, fpv_ctx_t *);
+void fpv_mul_ui(fpv_t *, const fpv_t *, ulong, fpv_ctx_t *);
+void fpv_mul(fpv_t *, const fpv_t *, const fpv_t *, fpv_ctx_t *);
+void fpv_sqr(fpv_t *, const fpv_t *, fpv_ctx_t *);
+void fpv_pow(fpv_t *, const fpv_t *, const fmpz_t, fpv_ctx_t *);
+uint fpv_equal(const fpv_t *, const fpv_t *, fpv_ctx_t *);
+
+#endif
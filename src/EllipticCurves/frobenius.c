@@ -0,0 +1,259 @@
+/// @file frobenius.c
+#include "frobenius.h"
+
+static fq_frob_t _fq_frob_tables[FQ_FROB_MAX_FIELDS];
+static uint _fq_frob_nb = 0;
+static pthread_mutex_t _fq_frob_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+  Sets rop to pi^i(op) for 0 < i < d with the table T of F, as the combination of the row i of T with the coefficients of op.
+  rop may alias op.
+*/
+static void _fq_frob_apply(fq_t rop, const fq_t op, uint i, const fq_frob_t *T, const fq_ctx_t F) {
+
+	fmpz_poly_t c;
+	fmpz_t cj;
+	fq_t acc, tmp;
+
+	fmpz_poly_init(c);
+	fmpz_init(cj);
+	fq_init(acc, F);
+	fq_init(tmp, F);
+
+	fq_get_fmpz_poly(c, op, F);
+	fq_zero(acc, F);
+	for(uint j = 0; j < T->d; j++) {
+		fmpz_poly_get_coeff_fmpz(cj, c, j);
+		if(fmpz_is_zero(cj)) continue;
+		fq_mul_fmpz(tmp, T->G[(i - 1) * T->d + j], cj, F);
+		fq_add(acc, acc, tmp, F);
+	}
+	fq_set(rop, acc, F);
+
+	fmpz_poly_clear(c);
+	fmpz_clear(cj);
+	fq_clear(acc, F);
+	fq_clear(tmp, F);
+}
+
+/**
+  Registers the Frobenius table of F, see fq_frob_t. Does nothing if F has degree 1, is already registered,
+  or if FQ_FROB_MAX_FIELDS fields are, in which case F keeps the generic routines.
+  Only x^p is computed as a power, the images of x under the higher powers of pi are obtained from the first row.
+  A corresponding call to fq_frob_unregister() must be made before clearing F.
+*/
+void fq_frob_register(const fq_ctx_t F) {
+
+	uint d = fq_ctx_degree(F);
+	uint slot;
+	fq_frob_t *T;
+	fq_t g;
+
+	if(d == 1) return;
+
+	pthread_mutex_lock(&_fq_frob_lock);
+
+	//// First free slot, unless F is already there
+	slot = _fq_frob_nb;
+	for(uint s = 0; s < _fq_frob_nb; s++) {
+		if(_fq_frob_tables[s].F == F) slot = FQ_FROB_MAX_FIELDS;
+		else if(_fq_frob_tables[s].F == NULL && slot == _fq_frob_nb) slot = s;
+	}
+	if(slot >= FQ_FROB_MAX_FIELDS) {
+		pthread_mutex_unlock(&_fq_frob_lock);
+		return;
+	}
+	T = _fq_frob_tables + slot;
+
+	fq_init(g, F);
+
+	//// Row i holds the powers of g = pi^i(x), each g being the image of the previous one by the first row
+	T->d = d;
+	T->G = malloc(sizeof(fq_t) * (d - 1) * d);
+	fq_gen(g, F);
+	for(uint i = 1; i < d; i++) {
+		if(i == 1) fq_frobenius(g, g, 1, F);
+		else _fq_frob_apply(g, g, 1, T, F);
+
+		for(uint j = 0; j < d; j++) {
+			fq_init(T->G[(i - 1) * d + j], F);
+			if(j == 0) fq_one(T->G[(i - 1) * d], F);
+			else fq_mul(T->G[(i - 1) * d + j], T->G[(i - 1) * d + j - 1], g, F);
+		}
+	}
+
+	//// Published last, once the table is complete
+	T->F = F;
+	if(slot == _fq_frob_nb) _fq_frob_nb++;
+
+	fq_clear(g, F);
+
+	pthread_mutex_unlock(&_fq_frob_lock);
+}
+
+/**
+  Releases the Frobenius table of F, if any.
+*/
+void fq_frob_unregister(const fq_ctx_t F) {
+
+	fq_frob_t *T;
+
+	pthread_mutex_lock(&_fq_frob_lock);
+
+	for(uint s = 0; s < _fq_frob_nb; s++) {
+		T = _fq_frob_tables + s;
+		if(T->F != F) continue;
+
+		T->F = NULL;
+		for(uint i = 0; i < (T->d - 1) * T->d; i++) fq_clear(T->G[i], F);
+		free(T->G);
+		T->G = NULL;
+	}
+
+	pthread_mutex_unlock(&_fq_frob_lock);
+}
+
+/**
+  Returns the Frobenius table of F, or NULL if F is not registered.
+*/
+const fq_frob_t *fq_frob_get(const fq_ctx_t F) {
+
+	for(uint s = 0; s < _fq_frob_nb; s++) {
+		if(_fq_frob_tables[s].F == F) return _fq_frob_tables + s;
+	}
+
+	return NULL;
+}
+
+/**
+  Sets rop to pi^i(op) = op^(p^i), with the table of F if it is registered and fq_frobenius otherwise.
+  rop may alias op.
+*/
+void fq_frobenius_tab(fq_t rop, const fq_t op, slong i, const fq_ctx_t F) {
+
+	const fq_frob_t *T = fq_frob_get(F);
+	slong d = fq_ctx_degree(F);
+
+	i = ((i % d) + d) % d;
+	if(i == 0) fq_set(rop, op, F);
+	else if(T == NULL) fq_frobenius(rop, op, i, F);
+	else _fq_frob_apply(rop, op, i, T, F);
+}
+
+/**
+  Auxiliary function for the Itoh-Tsujii routines: sets rop to op^(p + p^2 + ... + p^(d-1)), the product of the
+  conjugates of op other than op itself, for d > 1 the degree of F with table T.
+  With a_k = op^(1 + p + ... + p^(k-1)), a_2k = pi^k(a_k) a_k and a_(k+1) = pi(a_k) op, so a_(d-1) follows
+  from the bits of d - 1 in at most 2 log(d) multiplications, and rop = pi(a_(d-1)).
+*/
+static void _fq_itoh_tsujii(fq_t rop, const fq_t op, const fq_frob_t *T, const fq_ctx_t F) {
+
+	uint e = T->d - 1;
+	uint k = 1;
+	int top = 0;
+	fq_t a, tmp;
+
+	fq_init(a, F);
+	fq_init(tmp, F);
+
+	while(e >> (top + 1)) top++;
+
+	fq_set(a, op, F);
+	for(int bit = top - 1; bit >= 0; bit--) {
+		_fq_frob_apply(tmp, a, k, T, F);
+		fq_mul(a, a, tmp, F);
+		k *= 2;
+
+		if((e >> bit) & 1) {
+			_fq_frob_apply(tmp, a, 1, T, F);
+			fq_mul(a, tmp, op, F);
+			k++;
+		}
+	}
+	_fq_frob_apply(rop, a, 1, T, F);
+
+	fq_clear(a, F);
+	fq_clear(tmp, F);
+}
+
+/**
+  Sets rop to the norm of op to F_p, with Itoh-Tsujii if F is registered and fq_norm otherwise.
+*/
+void fq_norm_itoh(fmpz_t rop, const fq_t op, const fq_ctx_t F) {
+
+	const fq_frob_t *T = fq_frob_get(F);
+
+	if(fq_ctx_degree(F) == 1) {
+		fq_get_fmpz(rop, op, F);
+		return;
+	}
+	if(T == NULL) {
+		fq_norm(rop, op, F);
+		return;
+	}
+
+	fq_t b;
+	fq_init(b, F);
+
+	_fq_itoh_tsujii(b, op, T, F);
+	fq_mul(b, b, op, F);
+	fq_get_fmpz(rop, b, F);
+
+	fq_clear(b, F);
+}
+
+/**
+  Sets rop to the inverse of op. In a registered extension, op^-1 = op^(p + ... + p^(d-1)) / N(op) with Itoh-Tsujii,
+  which leaves a single inversion in F_p. Over F_p the integer representative is inverted with fmpz_invmod.
+  Like fq_inv, op must be nonzero. rop may alias op.
+*/
+void fq_inv_itoh(fq_t rop, const fq_t op, const fq_ctx_t F) {
+
+	const fq_frob_t *T = fq_frob_get(F);
+
+	if(fq_is_zero(op, F) || (fq_ctx_degree(F) > 1 && T == NULL)) {
+		fq_inv(rop, op, F);
+		return;
+	}
+
+	OPCOUNT_ADD(OPCOUNT_INV, F);
+
+	fmpz_t n;
+	fq_t b;
+
+	fmpz_init(n);
+	fq_init(b, F);
+
+	if(fq_ctx_degree(F) == 1) {
+		fq_get_fmpz(n, op, F);
+		fmpz_invmod(n, n, fq_ctx_prime(F));
+		fq_set_fmpz(rop, n, F);
+	}
+	else {
+		_fq_itoh_tsujii(b, op, T, F);
+
+		// n = N(op)^-1 in F_p
+		fq_mul(rop, b, op, F);
+		fq_get_fmpz(n, rop, F);
+		fmpz_invmod(n, n, fq_ctx_prime(F));
+
+		fq_mul_fmpz(rop, b, n, F);
+	}
+
+	fmpz_clear(n);
+	fq_clear(b, F);
+}
+
+/**
+  Sets rop to op1 / op2 with fq_inv_itoh. rop may alias either operand.
+*/
+void fq_div_itoh(fq_t rop, const fq_t op1, const fq_t op2, const fq_ctx_t F) {
+
+	fq_t inv;
+	fq_init(inv, F);
+
+	fq_inv_itoh(inv, op2, F);
+	fq_mul(rop, op1, inv, F);
+
+	fq_clear(inv, F);
+}
@@ -0,0 +1,46 @@
+/// @file frobenius.h
+#ifndef _FROBENIUS_H_
+#define _FROBENIUS_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fmpz_poly.h>
+#include <flint/fq.h>
+
+#include "opcount.h"
+
+/*********************************************
+ Frobenius tables of the extension fields
+ The p-power Frobenius pi is F_p-linear, so pi^i(op) is the combination of the images pi^i(x^j) of the
+ power basis with the coefficients of op. fq_frob_register precomputes them once per field, and pi^i
+ then costs d products by elements of F_p instead of an exponentiation.
+ With them, Itoh-Tsujii gets the norm to F_p of an element of F_{p^d} from O(log d) multiplications and
+ Frobenius maps, hence its inverse with a single inversion in F_p and its quadratic character with
+ a Legendre symbol in F_p.
+ Tables are looked up by context: cfg_init_set registers its extensions and cfg_clear releases them.
+ Registration must happen before the field is shared between threads, lookups take no lock.
+ Unregistered fields fall back to the generic FLINT routines.
+*********************************************/
+#define FQ_FROB_MAX_FIELDS 64
+
+typedef struct fq_frob_t {
+
+	const fq_ctx_struct *F;		// NULL for a free slot
+	uint d;				// degree of F
+	fq_t *G;			// G[(i-1)d + j] = pi^i(x^j) for the generator x of F, 0 < i < d and j < d
+} fq_frob_t;
+
+void fq_frob_register(const fq_ctx_t);
+void fq_frob_unregister(const fq_ctx_t);
+const fq_frob_t *fq_frob_get(const fq_ctx_t);
+
+void fq_frobenius_tab(fq_t, const fq_t, slong, const fq_ctx_t);
+void fq_norm_itoh(fmpz_t, const fq_t, const fq_ctx_t);
+void fq_inv_itoh(fq_t, const fq_t, const fq_ctx_t);
+void fq_div_itoh(fq_t, const fq_t, const fq_t, const fq_ctx_t);
+
+#endif
@@ -41,6 +41,9 @@ void SW_curve_set_si(SW_curve_t *E, const fq_ctx_t *F, const slong a, const slon
 	fq_set_si(bb, b, *F);
 
 	SW_curve_set(E, F, aa, bb);
+
+	fq_clear(aa, *F);
+	fq_clear(bb, *F);
 }
 
 /**
@@ -80,21 +83,21 @@ int SW_curve_set_str(SW_curve_t *E, const fq_ctx_t *F, const char *str_a, const
 	fq_init(fq_b, *F);
 
 	ret = fmpz_set_str(fmpz_a, str_a, b);
-	if(ret) return -1;
-	ret = fmpz_set_str(fmpz_b, str_b, b);
-	if(ret) return -1;
+	if(!ret) ret = fmpz_set_str(fmpz_b, str_b, b);
 
-	fq_set_fmpz(fq_a, fmpz_a, *F);
-	fq_set_fmpz(fq_b, fmpz_b, *F);
+	if(!ret) {
+		fq_set_fmpz(fq_a, fmpz_a, *F);
+		fq_set_fmpz(fq_b, fmpz_b, *F);
 
-	SW_curve_set(E, F, fq_a, fq_b);
+		SW_curve_set(E, F, fq_a, fq_b);
+	}
 
 	fmpz_clear(fmpz_a);
 	fmpz_clear(fmpz_b);
 	fq_clear(fq_a, *F);
 	fq_clear(fq_b, *F);
 
-	return 0;
+	return ret ? -1 : 0;
 }
 
 /**
@@ -289,21 +292,21 @@ int MG_curve_set_str(MG_curve_t *E, const fq_ctx_t *F, const char *str_A, const
 	fq_init(fq_B, *F);
 
 	ret = fmpz_set_str(fmpz_A, str_A, b);
-	if(ret) return -1;
-	ret = fmpz_set_str(fmpz_B, str_B, b);
-	if(ret) return -1;
+	if(!ret) ret = fmpz_set_str(fmpz_B, str_B, b);
 
-	fq_set_fmpz(fq_A, fmpz_A, *F);
-	fq_set_fmpz(fq_B, fmpz_B, *F);
+	if(!ret) {
+		fq_set_fmpz(fq_A, fmpz_A, *F);
+		fq_set_fmpz(fq_B, fmpz_B, *F);
 
-	MG_curve_set(E, F, fq_A, fq_B);
+		MG_curve_set(E, F, fq_A, fq_B);
+	}
 
 	fmpz_clear(fmpz_A);
 	fmpz_clear(fmpz_B);
 	fq_clear(fq_A, *F);
 	fq_clear(fq_B, *F);
 
-	return 0;
+	return ret ? -1 : 0;
 }
 
 /**
@@ -554,17 +557,16 @@ int TN_curve_set_str(TN_curve_t *E, const char *str_b, const char *str_c, const
 	fq_init(fq_b, *F);
 	fq_init(fq_c, *F);
 
-	ret = fmpz_set_str(fmpz_b, str_c, base);
-	if(ret) return -1;
-	ret = fmpz_set_str(fmpz_c, str_c, base);
-	if(ret) return -1;
-	ret = fmpz_set_str(fmpz_l, str_l, base);
-	if(ret) return -1;
+	ret = fmpz_set_str(fmpz_b, str_b, base);
+	if(!ret) ret = fmpz_set_str(fmpz_c, str_c, base);
+	if(!ret) ret = fmpz_set_str(fmpz_l, str_l, base);
 
-	fq_set_fmpz(fq_b, fmpz_b, *F);
-	fq_set_fmpz(fq_c, fmpz_c, *F);
+	if(!ret) {
+		fq_set_fmpz(fq_b, fmpz_b, *F);
+		fq_set_fmpz(fq_c, fmpz_c, *F);
 
-	TN_curve_set(E, fq_b, fq_c, fmpz_l, F);
+		TN_curve_set(E, fq_b, fq_c, fmpz_l, F);
+	}
 
 	fmpz_clear(fmpz_l);
 	fmpz_clear(fmpz_b);
@@ -572,7 +574,7 @@ int TN_curve_set_str(TN_curve_t *E, const char *str_b, const char *str_c, const
 	fq_clear(fq_b, *F);
 	fq_clear(fq_c, *F);
 
-	return 0;
+	return ret ? -1 : 0;
 }
 
 /**
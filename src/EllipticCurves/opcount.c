@@ -0,0 +1,170 @@
+// @file opcount.c
+#include "opcount.h"
+
+const char *opcount_op_names[OPCOUNT_NB_OPS] = {"mul", "sqr", "inv", "pow", "root", "polymul"};
+const char *opcount_phase_names[OPCOUNT_NB_PHASES] = {"other", "sampling", "ladder", "torsion", "kernel", "codomain", "evaluation",
+	"radical", "conversion", "field"};
+
+//// Report being filled and current walk and phase, per thread so that concurrent walks count separately
+static __thread opcount_report_t *_opcount_report = NULL;
+static __thread opcount_walk_t *_opcount_walk = NULL;
+static __thread uint _opcount_phase = OPCOUNT_OTHER;
+static __thread const opcount_listener_t *_opcount_listener = NULL;
+
+/**
+  Sets every counter of op to zero.
+*/
+void opcount_report_init(opcount_report_t *op) {
+
+	memset(op, 0, sizeof(opcount_report_t));
+}
+
+/**
+  Starts counting into op, which is reset.
+  If op is NULL, counting is disabled.
+*/
+void opcount_start(opcount_report_t *op) {
+
+	_opcount_report = op;
+	_opcount_walk = NULL;
+	_opcount_phase = OPCOUNT_OTHER;
+	if(op) opcount_report_init(op);
+}
+
+/**
+  Stops counting.
+*/
+void opcount_stop() {
+
+	_opcount_report = NULL;
+	_opcount_walk = NULL;
+}
+
+/**
+  Returns the walk (l, dir) in degree r of rep, created if needed, or NULL if rep is full.
+*/
+static opcount_walk_t *_opcount_find_walk(opcount_report_t *rep, ulong l, int dir, uint r) {
+
+	opcount_walk_t *walk;
+
+	for(uint i = 0; i < rep->nb_walks; i++) {
+		if(rep->walks[i].l == l && rep->walks[i].dir == dir && rep->walks[i].r == r) return rep->walks + i;
+	}
+
+	if(rep->nb_walks == OPCOUNT_MAX_WALKS) return NULL;
+
+	walk = rep->walks + rep->nb_walks;
+	walk->l = l;
+	walk->dir = dir;
+	walk->r = r;
+	rep->nb_walks++;
+	return walk;
+}
+
+/**
+  Attributes the next operations to the walk (l, dir) in degree r, created if needed, in phase OPCOUNT_OTHER.
+  Operations are dropped when the report is full.
+*/
+void opcount_set_walk(ulong l, int dir, uint r) {
+
+	if(_opcount_listener) _opcount_listener->walk(l, dir, r);
+	_opcount_phase = OPCOUNT_OTHER;
+
+	if(_opcount_report) _opcount_walk = _opcount_find_walk(_opcount_report, l, dir, r);
+}
+
+/**
+  Attributes the next operations to the given phase of the current walk.
+*/
+void opcount_set_phase(uint phase) {
+
+	if(_opcount_listener) _opcount_listener->phase(phase);
+
+	_opcount_phase = phase;
+}
+
+/**
+  Marks the end of a step of the current walk.
+*/
+void opcount_step() {
+
+	if(_opcount_listener) _opcount_listener->step();
+}
+
+/**
+  Forwards the walk, phase and step hooks of the calling thread to op, or to nobody if op is NULL.
+*/
+void opcount_set_listener(const opcount_listener_t *op) {
+
+	_opcount_listener = op;
+}
+
+/**
+  Sets op to the counting state of the calling thread.
+*/
+void opcount_save(opcount_ctx_t *op) {
+
+	op->report = _opcount_report;
+	op->walk = _opcount_walk;
+	op->phase = _opcount_phase;
+	op->listener = _opcount_listener;
+}
+
+/**
+  Sets the counting state of the calling thread to op, as saved by opcount_save.
+*/
+void opcount_restore(const opcount_ctx_t *op) {
+
+	_opcount_report = op->report;
+	_opcount_walk = op->walk;
+	_opcount_phase = op->phase;
+	_opcount_listener = op->listener;
+}
+
+/**
+  Starts counting into rop, which is reset, in the walk and phase of the state op of another thread,
+  without its listener. Used by the helper threads of the task pool, whose counts are then merged
+  into the report of op with opcount_report_merge.
+*/
+void opcount_fork(opcount_report_t *rop, const opcount_ctx_t *op) {
+
+	opcount_start(rop);
+	_opcount_listener = NULL;
+	if(op->walk) _opcount_walk = _opcount_find_walk(rop, op->walk->l, op->walk->dir, op->walk->r);
+	_opcount_phase = op->phase;
+}
+
+/**
+  Adds the counts of op to rop, walk by walk. The walks of op missing from a full rop are only counted by degree.
+*/
+void opcount_report_merge(opcount_report_t *rop, opcount_report_t *op) {
+
+	opcount_walk_t *walk;
+
+	for(uint i = 0; i < op->nb_walks; i++) {
+		walk = _opcount_find_walk(rop, op->walks[i].l, op->walks[i].dir, op->walks[i].r);
+		if(!walk) continue;
+
+		for(uint j = 0; j < OPCOUNT_NB_PHASES; j++) {
+			for(uint k = 0; k < OPCOUNT_NB_OPS; k++) walk->phases[j].ops[k] += op->walks[i].phases[j].ops[k];
+		}
+	}
+
+	for(uint r = 0; r <= OPCOUNT_MAX_DEGREE; r++) {
+		for(uint k = 0; k < OPCOUNT_NB_OPS; k++) rop->degrees[r].ops[k] += op->degrees[r].ops[k];
+	}
+}
+
+/**
+  Counts one operation of the given kind in the field ctx.
+*/
+void opcount_add(uint op, const fq_ctx_t ctx) {
+
+	if(!_opcount_report) return;
+
+	slong r = fq_ctx_degree(ctx);
+	if(r > OPCOUNT_MAX_DEGREE) r = OPCOUNT_MAX_DEGREE;
+	_opcount_report->degrees[r].ops[op]++;
+
+	if(_opcount_walk) _opcount_walk->phases[_opcount_phase].ops[op]++;
+}
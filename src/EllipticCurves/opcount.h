@@ -0,0 +1,123 @@
+#ifndef _OPCOUNT_H_
+#define _OPCOUNT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+#include <flint/fq_poly.h>
+#include <flint/fq_poly_factor.h>
+
+/*********************************************
+ Field operation counters
+ Enabled by compiling with -DOPCOUNT. Otherwise every hook below compiles to nothing.
+ The walk, phase and step hooks are also enabled by -DPROFILE (implied by -DVERBOSE and -DTIMING),
+ they are then forwarded to the listener set with opcount_set_listener, see Exchange/profile.c.
+ The report, walk, phase and listener are per thread; the tasks run by the helpers of the task pool
+ are counted into the report of the thread that queued them, see pool_run.
+*********************************************/
+#if !defined(PROFILE) && (defined(VERBOSE) || defined(TIMING))
+#define PROFILE
+#endif
+
+#define OPCOUNT_MAX_WALKS 64
+#define OPCOUNT_MAX_DEGREE 32
+
+// Counted operations
+enum { OPCOUNT_MUL, OPCOUNT_SQR, OPCOUNT_INV, OPCOUNT_POW, OPCOUNT_ROOT, OPCOUNT_POLYMUL, OPCOUNT_NB_OPS };
+
+// Phases of a walk the operations are attributed to
+enum { OPCOUNT_OTHER, OPCOUNT_SAMPLING, OPCOUNT_LADDER, OPCOUNT_TORSION, OPCOUNT_KERNEL, OPCOUNT_CODOMAIN, OPCOUNT_EVALUATION,
+	OPCOUNT_RADICAL, OPCOUNT_CONVERSION, OPCOUNT_FIELD, OPCOUNT_NB_PHASES };
+
+typedef struct opcount_t{
+
+	ulong ops[OPCOUNT_NB_OPS];
+} opcount_t;
+
+typedef struct opcount_walk_t{
+
+	ulong l;			// 0 for the work shared by several primes
+	int dir;			// 1 on the curve, -1 on the twist, 0 outside of a walk
+	uint r;				// extension degree
+	opcount_t phases[OPCOUNT_NB_PHASES];
+} opcount_walk_t;
+
+// Callbacks receiving the walk, phase and step hooks
+typedef struct opcount_listener_t{
+
+	void (*walk)(ulong, int, uint);
+	void (*phase)(uint);
+	void (*step)();
+} opcount_listener_t;
+
+typedef struct opcount_report_t{
+
+	uint nb_walks;
+	opcount_walk_t walks[OPCOUNT_MAX_WALKS];
+	opcount_t degrees[OPCOUNT_MAX_DEGREE + 1];	// totals by extension degree
+} opcount_report_t;
+
+// Counting state of a thread, see opcount_save
+typedef struct opcount_ctx_t{
+
+	opcount_report_t *report;
+	opcount_walk_t *walk;
+	uint phase;
+	const opcount_listener_t *listener;
+} opcount_ctx_t;
+
+void opcount_report_init(opcount_report_t *);
+void opcount_start(opcount_report_t *);
+void opcount_stop();
+void opcount_set_walk(ulong, int, uint);
+void opcount_set_phase(uint);
+void opcount_add(uint, const fq_ctx_t);
+void opcount_step();
+void opcount_set_listener(const opcount_listener_t *);
+void opcount_save(opcount_ctx_t *);
+void opcount_restore(const opcount_ctx_t *);
+void opcount_fork(opcount_report_t *, const opcount_ctx_t *);
+void opcount_report_merge(opcount_report_t *, opcount_report_t *);
+
+extern const char *opcount_op_names[OPCOUNT_NB_OPS];
+extern const char *opcount_phase_names[OPCOUNT_NB_PHASES];
+
+#if defined(OPCOUNT) || defined(PROFILE)
+
+#define OPCOUNT_WALK(l, dir, r) opcount_set_walk(l, dir, r)
+#define OPCOUNT_PHASE(phase) opcount_set_phase(phase)
+#define OPCOUNT_STEP() opcount_step()
+
+#else
+
+#define OPCOUNT_WALK(l, dir, r)
+#define OPCOUNT_PHASE(phase)
+#define OPCOUNT_STEP()
+
+#endif
+
+#ifdef OPCOUNT
+
+#define OPCOUNT_ADD(op, ctx) opcount_add(op, ctx)
+
+//// The flint headers are included above, so that only calls are rewritten
+#define fq_mul(rop, op1, op2, ctx) (opcount_add(OPCOUNT_MUL, ctx), fq_mul(rop, op1, op2, ctx))
+#define fq_sqr(rop, op, ctx) (opcount_add(OPCOUNT_SQR, ctx), fq_sqr(rop, op, ctx))
+#define fq_inv(rop, op, ctx) (opcount_add(OPCOUNT_INV, ctx), fq_inv(rop, op, ctx))
+#define fq_div(rop, op1, op2, ctx) (opcount_add(OPCOUNT_INV, ctx), opcount_add(OPCOUNT_MUL, ctx), fq_div(rop, op1, op2, ctx))
+#define fq_pow(rop, op, e, ctx) (opcount_add(OPCOUNT_POW, ctx), fq_pow(rop, op, e, ctx))
+#define fq_pow_ui(rop, op, e, ctx) (opcount_add(OPCOUNT_POW, ctx), fq_pow_ui(rop, op, e, ctx))
+#define fq_poly_mul(rop, op1, op2, ctx) (opcount_add(OPCOUNT_POLYMUL, ctx), fq_poly_mul(rop, op1, op2, ctx))
+#define fq_poly_factor(res, lead, input, ctx) (opcount_add(OPCOUNT_ROOT, ctx), fq_poly_factor(res, lead, input, ctx))
+
+#else
+
+#define OPCOUNT_ADD(op, ctx)
+
+#endif
+
+#endif
@@ -0,0 +1,182 @@
+/// @file pool.c
+#include "pool.h"
+
+// A call to pool_run, living on the stack of its caller
+typedef struct _pool_batch_t {
+
+	pool_task_t *tasks;
+	uint n;
+	uint next;			// first task not claimed yet
+	uint remaining;			// tasks not finished yet
+	pthread_cond_t done;
+	struct _pool_batch_t *link;	// in the list of batches with unclaimed tasks
+	#ifdef OPCOUNT
+	opcount_ctx_t counts;		// counting state of the caller
+	opcount_report_t helpers;	// operations of the tasks run by the helpers, merged by the caller
+	#endif
+} _pool_batch_t;
+
+static pthread_mutex_t _pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _pool_work = PTHREAD_COND_INITIALIZER;
+static _pool_batch_t *_pool_head = NULL;
+static pthread_t *_pool_threads = NULL;
+static uint _pool_size = 1;
+static int _pool_stop = 0;
+
+/**
+  Claims the next task of batch, which has unclaimed tasks, and unlinks it once they are all claimed.
+  Must be called with the pool lock held.
+*/
+static pool_task_t *_pool_claim(_pool_batch_t *batch) {
+
+	_pool_batch_t **p;
+	pool_task_t *task = batch->tasks + batch->next;
+
+	batch->next++;
+	if(batch->next == batch->n) {
+		for(p = &_pool_head; *p != batch; p = &((*p)->link));
+		*p = batch->link;
+	}
+	return task;
+}
+
+/**
+  Runs task outside of the pool lock, which is held on input and output, and signals its batch when it was the last one.
+  With -DOPCOUNT, a helper (helper = 1) counts the task into a report of its own in the walk and phase of the caller,
+  which is added to the batch under the lock.
+*/
+static void _pool_execute(_pool_batch_t *batch, pool_task_t *task, int helper) {
+
+	pthread_mutex_unlock(&_pool_lock);
+	#ifdef OPCOUNT
+	if(helper && batch->counts.report) {
+		opcount_ctx_t own;
+		opcount_report_t *counts = malloc(sizeof(opcount_report_t));
+
+		opcount_save(&own);
+		opcount_fork(counts, &batch->counts);
+		task->fn(task->arg);
+		opcount_restore(&own);
+
+		pthread_mutex_lock(&_pool_lock);
+		opcount_report_merge(&batch->helpers, counts);
+		pthread_mutex_unlock(&_pool_lock);
+		free(counts);
+	}
+	else task->fn(task->arg);
+	#else
+	task->fn(task->arg);
+	#endif
+	pthread_mutex_lock(&_pool_lock);
+
+	batch->remaining--;
+	if(!batch->remaining) pthread_cond_signal(&batch->done);
+}
+
+static void *_pool_thread(void *arg) {
+
+	_pool_batch_t *batch;
+
+	pthread_mutex_lock(&_pool_lock);
+	while(1) {
+		while(!_pool_head && !_pool_stop) pthread_cond_wait(&_pool_work, &_pool_lock);
+		if(!_pool_head) break;
+
+		batch = _pool_head;
+		_pool_execute(batch, _pool_claim(batch), 1);
+	}
+	pthread_mutex_unlock(&_pool_lock);
+
+	return NULL;
+}
+
+/**
+  Starts the pool with nb_threads threads, the callers of pool_run included.
+  A corresponding call to pool_clear() must be made before exiting.
+  Must not be called while another thread uses the pool.
+*/
+void pool_init(uint nb_threads) {
+
+	_pool_stop = 0;
+	_pool_size = nb_threads ? nb_threads : 1;
+	_pool_threads = malloc(sizeof(pthread_t) * _pool_size);
+
+	for(uint i = 1; i < _pool_size; i++) pthread_create(_pool_threads + i, NULL, _pool_thread, NULL);
+}
+
+/**
+  Stops the helper threads. pool_run then runs the tasks in the calling thread.
+*/
+void pool_clear() {
+
+	pthread_mutex_lock(&_pool_lock);
+	_pool_stop = 1;
+	pthread_cond_broadcast(&_pool_work);
+	pthread_mutex_unlock(&_pool_lock);
+
+	for(uint i = 1; i < _pool_size; i++) pthread_join(_pool_threads[i], NULL);
+
+	free(_pool_threads);
+	_pool_threads = NULL;
+	_pool_size = 1;
+}
+
+/**
+  Returns the number of threads of the pool, the callers of pool_run included.
+*/
+uint pool_size() {
+
+	return _pool_size;
+}
+
+/**
+  Returns 1 if the steps of degree l are worth parallelizing and 0 otherwise.
+*/
+int pool_enabled(ulong l) {
+
+	return (pool_size() > 1) && (l >= POOL_MIN_L);
+}
+
+/**
+  Runs the n tasks and returns once they are all finished.
+  The calling thread takes part, so that pool_run may be called from several threads, or from a task.
+  With -DOPCOUNT, the operations of the tasks run by the helpers are added to the report of the calling thread.
+*/
+void pool_run(pool_task_t *tasks, uint n) {
+
+	_pool_batch_t batch, **p;
+
+	if(pool_size() == 1 || n == 1) {
+		for(uint i = 0; i < n; i++) tasks[i].fn(tasks[i].arg);
+		return;
+	}
+
+	batch.tasks = tasks;
+	batch.n = n;
+	batch.next = 0;
+	batch.remaining = n;
+	batch.link = NULL;
+	pthread_cond_init(&batch.done, NULL);
+	#ifdef OPCOUNT
+	opcount_save(&batch.counts);
+	if(batch.counts.report) opcount_report_init(&batch.helpers);
+	#endif
+
+	pthread_mutex_lock(&_pool_lock);
+
+	//// Queue, first come first served
+	for(p = &_pool_head; *p; p = &((*p)->link));
+	*p = &batch;
+	pthread_cond_broadcast(&_pool_work);
+
+	//// Work on our own tasks, then wait for the helpers
+	while(batch.next < batch.n) _pool_execute(&batch, _pool_claim(&batch), 0);
+	while(batch.remaining) pthread_cond_wait(&batch.done, &_pool_lock);
+
+	pthread_mutex_unlock(&_pool_lock);
+	pthread_cond_destroy(&batch.done);
+
+	#ifdef OPCOUNT
+	if(batch.counts.report) opcount_report_merge(batch.counts.report, &batch.helpers);
+	#endif
+}
@@ -0,0 +1,43 @@
+/// @file pool.h
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include <gmp.h>
+#include <flint/flint.h>
+
+#include "opcount.h"
+
+/*********************************************
+   Task pool for intra-step parallelism
+*********************************************/
+// pool_init(n) starts n - 1 helper threads shared by the whole process, the thread calling pool_run
+// works as the n-th. Without pool_init, or with n = 1, pool_run runs the tasks in order in the calling thread.
+// With -DOPCOUNT, the operations of the tasks run by the helpers are counted in the report of the caller,
+// and with -DPROFILE the time of pool_run is charged to the phase of the caller.
+
+// Smallest prime whose Velu steps and torsion sampling are parallelized,
+// below it a step is too short to pay for the hand-off
+#define POOL_MIN_L 101
+
+// Number of speculative torsion point candidates per round
+#define POOL_MAX_CANDIDATES 8
+
+typedef void (*pool_fn_t)(void *);
+
+typedef struct pool_task_t {
+
+	pool_fn_t fn;
+	void *arg;
+} pool_task_t;
+
+void pool_init(uint);
+void pool_clear();
+uint pool_size();
+int pool_enabled(ulong);
+void pool_run(pool_task_t *, uint);
+
+#endif
@@ -0,0 +1,280 @@
+// @file async.c
+#include "async.h"
+
+/**
+  Yield hook of the executor threads: stops the walk of the job given as argument once it is cancelled.
+*/
+static int _apply_job_yield(void *arg) {
+
+	apply_job_t *job = arg;
+	int ret;
+
+	pthread_mutex_lock(&job->lock);
+	ret = job->cancel;
+	pthread_mutex_unlock(&job->lock);
+
+	return ret;
+}
+
+/**
+  Auxiliary function for apply_job_wait and apply_job_clear: returns 1 if job is finished and its callback,
+  if any, has returned or is being run by the calling thread. job->lock must be held.
+*/
+static int _apply_job_released(apply_job_t *job) {
+
+	if(job->state < APPLY_DONE) return 0;
+	return !job->in_callback || pthread_equal(job->finisher, pthread_self());
+}
+
+/**
+  Auxiliary function for apply_job_clear and _apply_job_finish: releases job.
+*/
+static void _apply_job_free(apply_job_t *job) {
+
+	MG_curve_clear(&job->E);
+	key_clear(job->key);
+	pthread_mutex_destroy(&job->lock);
+	pthread_cond_destroy(&job->finished);
+	free(job);
+}
+
+/**
+  Moves job to the final state and runs its callback. The waiters are only released once the callback has returned,
+  so that the job stays valid during the callback; if the callback clears the job, it is released here afterwards.
+  The job must not be touched after the last unlock.
+*/
+static void _apply_job_finish(apply_job_t *job, int state) {
+
+	apply_callback_t callback = job->callback;
+	void *arg = job->arg;
+	int cleared;
+
+	pthread_mutex_lock(&job->lock);
+	job->state = state;
+	if(callback) {
+		job->in_callback = 1;
+		job->finisher = pthread_self();
+	}
+	else pthread_cond_broadcast(&job->finished);
+	pthread_mutex_unlock(&job->lock);
+
+	if(!callback) return;
+
+	callback(job, arg);
+
+	pthread_mutex_lock(&job->lock);
+	job->in_callback = 0;
+	cleared = job->cleared;
+	pthread_cond_broadcast(&job->finished);
+	pthread_mutex_unlock(&job->lock);
+
+	if(cleared) _apply_job_free(job);
+}
+
+/**
+  Walks job, which is in state APPLY_RUNNING.
+*/
+static void _apply_job_run(apply_executor_t *ex, apply_job_t *job) {
+
+	int ec;
+	MG_curve_t R;
+
+	MG_curve_init(&R, job->E.F);
+
+	walk_set_yield(_apply_job_yield, job);
+	ec = apply_key(&R, &job->E, job->key, ex->cfg, NULL);
+	walk_set_yield(NULL, NULL);
+
+	if(ec) MG_curve_set_(&job->E, &R);
+	MG_curve_clear(&R);
+
+	if(_apply_job_yield(job)) _apply_job_finish(job, APPLY_CANCELLED);
+	else _apply_job_finish(job, ec ? APPLY_DONE : APPLY_FAILED);
+}
+
+/**
+  Executor thread: runs the pending jobs in order until the executor is stopped.
+*/
+static void *_apply_executor_thread(void *arg) {
+
+	apply_executor_t *ex = arg;
+	apply_job_t *job;
+
+	while(1) {
+
+		//// Next job
+		pthread_mutex_lock(&ex->lock);
+		while(!ex->head && !ex->stop) pthread_cond_wait(&ex->nonempty, &ex->lock);
+		if(ex->stop) {
+			pthread_mutex_unlock(&ex->lock);
+			break;
+		}
+		job = ex->head;
+		ex->head = job->next;
+		if(!ex->head) ex->tail = NULL;
+
+		pthread_mutex_lock(&job->lock);
+		job->state = APPLY_RUNNING;
+		pthread_mutex_unlock(&job->lock);
+		pthread_mutex_unlock(&ex->lock);
+
+		_apply_job_run(ex, job);
+	}
+
+	return NULL;
+}
+
+/**
+  Initializes ex and starts nb_threads threads applying keys for the configuration cfg.
+  A corresponding call to apply_executor_clear() must be made to stop the threads.
+*/
+void apply_executor_init(apply_executor_t *ex, cfg_t *cfg, uint nb_threads) {
+
+	ex->cfg = cfg;
+	ex->nb_threads = nb_threads;
+	ex->threads = malloc(sizeof(pthread_t) * nb_threads);
+	ex->head = NULL;
+	ex->tail = NULL;
+	ex->stop = 0;
+
+	pthread_mutex_init(&ex->lock, NULL);
+	pthread_cond_init(&ex->nonempty, NULL);
+
+	for(uint i = 0; i < nb_threads; i++) pthread_create(ex->threads + i, NULL, _apply_executor_thread, ex);
+}
+
+/**
+  Stops the threads of ex once their running jobs are finished, and cancels the pending jobs.
+  The jobs must still be cleared by their owners.
+*/
+void apply_executor_clear(apply_executor_t *ex) {
+
+	apply_job_t *job;
+
+	pthread_mutex_lock(&ex->lock);
+	ex->stop = 1;
+	pthread_cond_broadcast(&ex->nonempty);
+	pthread_mutex_unlock(&ex->lock);
+
+	for(uint i = 0; i < ex->nb_threads; i++) pthread_join(ex->threads[i], NULL);
+
+	while(ex->head) {
+		job = ex->head;
+		ex->head = job->next;
+		_apply_job_finish(job, APPLY_CANCELLED);
+	}
+	ex->tail = NULL;
+
+	pthread_mutex_destroy(&ex->lock);
+	pthread_cond_destroy(&ex->nonempty);
+	free(ex->threads);
+}
+
+/**
+  Queues the application of key to op on ex and returns immediately.
+  op and key are copied and can be modified or cleared right away.
+  If callback is not NULL, it is called with the job and arg from an executor thread once the job is finished,
+  whatever its final state; the waiters of apply_job_wait are only released once it has returned.
+  It may clear the job, in which case the job must not be used elsewhere.
+  Returns a handle on the job, to be cleared with apply_job_clear().
+*/
+apply_job_t *apply_key_submit(apply_executor_t *ex, MG_curve_t *op, key__t *key, apply_callback_t callback, void *arg) {
+
+	apply_job_t *job = malloc(sizeof(apply_job_t));
+
+	MG_curve_init(&job->E, op->F);
+	MG_curve_set_(&job->E, op);
+	job->key = key_init_(ex->cfg);
+	for(uint i = 0; i < key->nb_primes; i++) fmpz_set((job->key->steps)[i], (key->steps)[i]);
+
+	job->state = APPLY_PENDING;
+	job->cancel = 0;
+	job->callback = callback;
+	job->arg = arg;
+	job->in_callback = 0;
+	job->cleared = 0;
+	job->next = NULL;
+	pthread_mutex_init(&job->lock, NULL);
+	pthread_cond_init(&job->finished, NULL);
+
+	pthread_mutex_lock(&ex->lock);
+	if(ex->tail) ex->tail->next = job;
+	else ex->head = job;
+	ex->tail = job;
+	pthread_cond_signal(&ex->nonempty);
+	pthread_mutex_unlock(&ex->lock);
+
+	return job;
+}
+
+/**
+  Returns the current state of job, without blocking.
+*/
+int apply_job_poll(apply_job_t *job) {
+
+	int state;
+
+	pthread_mutex_lock(&job->lock);
+	state = job->state;
+	pthread_mutex_unlock(&job->lock);
+
+	return state;
+}
+
+/**
+  Blocks until job is finished and its callback, if any, has returned, then returns its final state.
+*/
+int apply_job_wait(apply_job_t *job) {
+
+	int state;
+
+	pthread_mutex_lock(&job->lock);
+	while(!_apply_job_released(job)) pthread_cond_wait(&job->finished, &job->lock);
+	state = job->state;
+	pthread_mutex_unlock(&job->lock);
+
+	return state;
+}
+
+/**
+  Asks for job to be cancelled and returns immediately.
+  A pending job is cancelled when an executor thread picks it up, a running one at its next yield point,
+  that is after the current isogeny step. A finished job is left unchanged.
+*/
+void apply_job_cancel(apply_job_t *job) {
+
+	pthread_mutex_lock(&job->lock);
+	job->cancel = 1;
+	pthread_mutex_unlock(&job->lock);
+}
+
+/**
+  Sets rop to the result of job if it is in state APPLY_DONE.
+  rop must be initialized.
+  Returns 1 if successful and 0 otherwise.
+*/
+int apply_job_result(MG_curve_t *rop, apply_job_t *job) {
+
+	if(apply_job_poll(job) != APPLY_DONE) return 0;
+
+	MG_curve_set_(rop, &job->E);
+	return 1;
+}
+
+/**
+  Waits for job to be finished and releases it. Called from the callback of job, the release is left
+  to the executor thread once the callback has returned.
+*/
+void apply_job_clear(apply_job_t *job) {
+
+	pthread_mutex_lock(&job->lock);
+	if(job->in_callback && pthread_equal(job->finisher, pthread_self())) {
+		job->cleared = 1;
+		pthread_mutex_unlock(&job->lock);
+		return;
+	}
+	pthread_mutex_unlock(&job->lock);
+
+	apply_job_wait(job);
+	_apply_job_free(job);
+}
@@ -0,0 +1,72 @@
+#ifndef _async_H_
+#define _async_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/Isogeny/yield.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/dh.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*********************************************
+   Asynchronous key application
+*********************************************/
+// Job states
+#define APPLY_PENDING 0		// queued
+#define APPLY_RUNNING 1		// being walked by an executor thread
+#define APPLY_DONE 2		// finished, the result is available
+#define APPLY_FAILED 3		// a walk failed
+#define APPLY_CANCELLED 4	// cancelled before or during the walk
+
+typedef struct apply_job_t apply_job_t;
+typedef void (*apply_callback_t)(apply_job_t *, void *);
+
+struct apply_job_t {
+
+	MG_curve_t E;			// start curve, then result
+	key__t *key;			// private copy of the key
+	int state;
+	int cancel;			// set by apply_job_cancel, read at every yield point
+
+	apply_callback_t callback;	// called by the executor thread once the job is finished
+	void *arg;
+	int in_callback;		// 1 while the callback runs, waiters are released afterwards
+	int cleared;			// set by apply_job_clear from the callback, the executor then releases the job
+	pthread_t finisher;		// thread running the callback
+
+	pthread_mutex_t lock;
+	pthread_cond_t finished;
+	apply_job_t *next;		// in the queue of the executor
+};
+
+typedef struct apply_executor_t {
+
+	cfg_t *cfg;
+	uint nb_threads;
+	pthread_t *threads;
+
+	pthread_mutex_t lock;
+	pthread_cond_t nonempty;
+	apply_job_t *head, *tail;	// FIFO of pending jobs
+	int stop;
+} apply_executor_t;
+
+void apply_executor_init(apply_executor_t *, cfg_t *, uint);
+void apply_executor_clear(apply_executor_t *);
+
+apply_job_t *apply_key_submit(apply_executor_t *, MG_curve_t *, key__t *, apply_callback_t, void *);
+int apply_job_poll(apply_job_t *);
+int apply_job_wait(apply_job_t *);
+void apply_job_cancel(apply_job_t *);
+int apply_job_result(MG_curve_t *, apply_job_t *);
+void apply_job_clear(apply_job_t *);
+
+#endif
@@ -5,16 +5,28 @@
   Walk in the isogeny graph starting from op following the path given by the key.
   The curve rop is set to the endpoint of this walk.
   rop must be initialized.
-  The l-primes are ordered according to their working extension.
-  That way we just change the extension degree when needed.
-  Returns 1 if successful and 0 if an error occured during a walk.
+  The l-primes are walked in the order of the schedule of the key, see schedule_plan:
+  each extension degree is visited once and the velu primes of a degree share their torsion points.
+  If counts is not NULL and the library is compiled with -DOPCOUNT, the field operations of the walk are counted in counts.
+  With -DVERBOSE or -DTIMING, the phases of the walk are profiled and the report is printed, as text or json respectively,
+  along with the estimated cost of the schedule.
+  The walk stops after the current isogeny step when the yield hook of the calling thread asks for it, see walk_set_yield.
+  When op is the base curve of cfg and cfg_precompute was called, the first group walked starts from the
+  precomputed first steps of its primes instead of sampling them. The schedule has no group without steps,
+  so the first group is the only one that starts on the base curve.
+  The walk stops at the first group that fails, rop being then set to the last curve reached.
+  Returns 1 if successful and 0 if an error occured during a walk or the walk was stopped.
 */
-int apply_key(MG_curve_t *rop, MG_curve_t *op, key__t *key, cfg_t *cfg) {
+int apply_key(MG_curve_t *rop, MG_curve_t *op, key__t *key, cfg_t *cfg, opcount_report_t *counts) {
 
 	uint ec = 1;
 	uint r = 1;
+	uint i;
+	int dir, at_base;
 	lprime_t *lp;
-	fmpz_t *steps;
+	cfg_start_t *start;
+	schedule_t plan;
+	schedule_group_t *group;
 	MG_curve_t tmp1, tmp2;
 
 	const fq_ctx_t *F = (cfg->fields);
@@ -25,44 +37,123 @@ int apply_key(MG_curve_t *rop, MG_curve_t *op, key__t *key, cfg_t *cfg) {
 	//// Init tmp1 at base curve op
 	MG_curve_set_(&tmp1, op);
 
-	int total_time = 0;
-	for(int i = 0; i < key->nb_primes; i++) {
+	schedule_plan(&plan, key, cfg);
 
+	//// Still on the base curve, for the first steps of cfg_precompute
+	at_base = (cfg->start != NULL) && (op->F == cfg->E->F) && fq_equal(op->A, cfg->E->A, *F) && fq_equal(op->B, cfg->E->B, *F);
 
-		lp = (key->lprimes) + i;
-		steps = (key->steps) + i;
-		if(lp->r != r) {// Upgrade the base field
-			r = lp->r;
+	#ifdef OPCOUNT
+	opcount_start(counts);
+	#else
+	if(counts) opcount_report_init(counts);
+	#endif
+
+	#ifdef PROFILE
+	profile_report_t prof;
+	profile_report_init(&prof);
+	profile_start(&prof);
+	#endif
+
+	for(uint g = 0; g < plan.nb_groups; g++) {
+
+		//// Cancelled from the yield hook, see walk_set_yield
+		if(walk_yield()) {
+			ec = 0;
+			break;
+		}
+
+		group = plan.groups + g;
+		if(group->r != r) {// Change the base field
+			OPCOUNT_WALK(0, 0, group->r);
+			OPCOUNT_PHASE(OPCOUNT_FIELD);
+			r = group->r;
 			MG_curve_update_field_(&tmp1, cfg->fields + r - 1);
 			MG_curve_update_field_(&tmp2, cfg->fields + r - 1);
 		}
 
-		clock_t start = clock(), diff; // Clock start
+		//// The velu primes of a group share their torsion points
+		if(group->type == 2 && group->n > 1) {
+			uint n = group->n;
+			fmpz_t l_batch[n], steps_batch[n];
+			ulong dac_batch[n];
+			uint daclen_batch[n], b_batch[n], bprime_batch[n];
+			MG_point_t *start_batch[n];
+			for(uint j = 0; j < n; j++) {
+				uint idx = plan.order[group->first + j];
+				lp = key->lprimes + idx;
+				fmpz_init_set(l_batch[j], lp->l);
+				fmpz_init_set(steps_batch[j], key->steps[idx]);
+				dac_batch[j] = lp->dac;
+				daclen_batch[j] = lp->daclen;
+				b_batch[j] = lp->b;
+				bprime_batch[j] = lp->bprime;
+				dir = (fmpz_sgn(key->steps[idx]) < 0);
+				start_batch[j] = (at_base && cfg->start[idx].ok[dir]) ? cfg->start[idx].P + dir : NULL;
+			}
+			ec = walk_velu_batch_from(&tmp2, &tmp1, l_batch, dac_batch, daclen_batch, b_batch, bprime_batch, steps_batch, n, start_batch);
+			OPCOUNT_WALK(0, 0, r);
+			OPCOUNT_PHASE(OPCOUNT_OTHER);
+
+			#ifdef VERBOSE
+			if(!ec) print_verbose_walk_failure(l_batch, n);
+			#endif
+
+			for(uint j = 0; j < n; j++) {
+				fmpz_clear(l_batch[j]);
+				fmpz_clear(steps_batch[j]);
+			}
+
+			// The next groups would start from a curve that was never reached
+			if(!ec) break;
+
+			MG_curve_set_(&tmp1, &tmp2);
+			at_base = 0;
+			continue;
+		}
 
-		if( lp->type == 1 ) ec = walk_rad(&tmp2, &tmp1, lp->l, *steps);
-		else ec = walk_velu(&tmp2, &tmp1, lp->l, *steps);
+		i = plan.order[group->first];
+		lp = key->lprimes + i;
+		dir = (fmpz_sgn(key->steps[i]) < 0);
+		start = (at_base && cfg->start[i].ok[dir]) ? cfg->start + i : NULL;
+		at_base = 0;
 
-		diff = clock() - start; // Clock stop
-		int msec = diff * 1000 / CLOCKS_PER_SEC;
-		total_time = total_time + msec;
+		if( lp->type == 1 ) ec = walk_rad_from(&tmp2, &tmp1, lp->l, key->steps[i], (start ? start->TN + dir : NULL));
+		else ec = walk_velu_from(&tmp2, &tmp1, lp->l, lp->dac, lp->daclen, lp->b, lp->bprime, key->steps[i], (start ? start->P + dir : NULL));
+		OPCOUNT_WALK(0, 0, r);
+		OPCOUNT_PHASE(OPCOUNT_OTHER);
 
 		#ifdef VERBOSE
-		if(!fmpz_is_zero(*steps)) print_verbose_walk(lp->type, lp->l, *steps, ec, msec);
-		#endif
-		#ifdef TIMING
-		print_timing_json(lp->l, ((float)msec)/(10*1000));
+		if(!ec) print_verbose_walk_failure(&(lp->l), 1);
 		#endif
 
+		if(!ec) break;
+
 		MG_curve_set_(&tmp1, &tmp2);
 	}
 
-	#ifdef VERBOSE
-	print_verbose_walk_total_time(total_time);
+	//// Coerce the output back to the base field
+	if(r != 1) {
+		OPCOUNT_WALK(0, 0, 1);
+		OPCOUNT_PHASE(OPCOUNT_FIELD);
+		MG_curve_update_field_(&tmp1, cfg->fields);
+	}
+	MG_curve_set_(rop, &tmp1);
+
+	#ifdef OPCOUNT
+	opcount_stop();
 	#endif
 
-	//// Coerce the output back to the base field
-	MG_curve_update_field_(&tmp2, cfg->fields);
-	MG_curve_set_(rop, &tmp2);
+	#ifdef PROFILE
+	profile_stop();
+	#ifdef VERBOSE
+	print_profile_report(&prof);
+	print_schedule_report(&plan, key, &prof);
+	#endif
+	#ifdef TIMING
+	print_profile_json(&prof, &plan, key);
+	#endif
+	profile_report_clear(&prof);
+	#endif
 
 	MG_curve_clear(&tmp1);
 	MG_curve_clear(&tmp2);
@@ -12,11 +12,13 @@
 #include "../../src/Exchange/keygen.h"
 #include "../../src/Exchange/setup.h"
 #include "../../src/Exchange/info.h"
+#include "../../src/Exchange/profile.h"
+#include "../../src/Exchange/schedule.h"
 
 #include <gmp.h>
 #include <flint/fmpz.h>
 #include <flint/fq.h>
 
-int apply_key(MG_curve_t *, MG_curve_t *, key__t *, cfg_t *);
+int apply_key(MG_curve_t *, MG_curve_t *, key__t *, cfg_t *, opcount_report_t *);
 
 #endif
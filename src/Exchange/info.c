@@ -2,44 +2,239 @@
 #include "info.h"
 
 /**
-  Prints information related to a walk on an l-isogeny graph.
+  Prints the l-primes of a walk that failed.
 */
-void print_verbose_walk(uint type, fmpz_t l, fmpz_t k, int ec, int msec) {
+void print_verbose_walk_failure(fmpz_t *l, uint n) {
 
-	printf("VERBOSE::apply_key:Taking ");
-	fmpz_print(k);
-	printf(" step(s) in the ");
-	fmpz_print(l);
-	printf("-isogeny graph using ");
+	printf("VERBOSE::apply_key:Walk in the ");
+	for(uint i = 0; i < n; i++) {
+		if(i) printf(", ");
+		fmpz_print(l[i]);
+	}
+	printf("-isogeny graph(s) resulted in an error (failure)\n");
+}
+
+/**
+ Auxiliary function for print_profile_report and print_schedule_report.
+ Prints a duration of t ns with a readable unit.
+*/
+static void _print_duration(ulong t) {
+
+	if(t >= 1000000000UL) printf("%7.3fs ", t / 1e9);
+	else if(t >= 1000000UL) printf("%7.3fms", t / 1e6);
+	else if(t >= 1000UL) printf("%7.3fus", t / 1e3);
+	else printf("%7luns", t);
+}
+
+/**
+ Auxiliary function for print_profile_report.
+ Prints the number of samples, mean and percentiles of op.
+*/
+static void _print_profile_hist(profile_hist_t *op) {
+
+	printf("n=%-6lu mean ", op->count);
+	_print_duration(op->sum / op->count);
+	printf("  p50 ");
+	_print_duration(profile_hist_percentile(op, 0.5));
+	printf("  p90 ");
+	_print_duration(profile_hist_percentile(op, 0.9));
+	printf("  p99 ");
+	_print_duration(profile_hist_percentile(op, 0.99));
+	printf("  total ");
+	_print_duration(op->sum);
+	printf("\n");
+}
+
+/**
+ Prints the profile of a key application: for every walk, the time per step and the time per step spent in each phase.
+ Walks with l = 0 gather the work shared by several primes, and the work done outside of a walk (dir = 0).
+*/
+void print_profile_report(profile_report_t *op) {
+
+	printf("VERBOSE::apply_key:Profile, total time ");
+	_print_duration(op->elapsed);
+	printf("\n");
 
-	if(type == 1) printf("[radical isogeny] algorithm ");
-	else printf("[sqrt-Velu] algorithm ");
+	for(uint i = 0; i < op->nb_walks; i++) {
+		profile_walk_t *w = op->walks + i;
 
-	printf("resulted in error code %d ", ec);
+		if(w->dir == 0) printf("VERBOSE::apply_key:[apply_key] r=%u", w->r);
+		else if(w->l == 0) printf("VERBOSE::apply_key:[shared] dir=%+d r=%u", w->dir, w->r);
+		else printf("VERBOSE::apply_key:l=%lu dir=%+d r=%u", w->l, w->dir, w->r);
+		printf(", %lu step(s)\n", w->steps);
 
-	if(ec) printf("(success) ");
-	else printf("(failure) ");
+		if(w->total.count) {
+			printf("VERBOSE::apply_key:    %-10s ", "step");
+			_print_profile_hist(&w->total);
+		}
+		for(uint j = 0; j < OPCOUNT_NB_PHASES; j++) {
+			if(!w->phases[j].count) continue;
+			printf("VERBOSE::apply_key:    %-10s ", opcount_phase_names[j]);
+			_print_profile_hist(w->phases + j);
+		}
+	}
+}
 
-	if(msec > 1000) printf("in <%ds> \n", msec/1000);
-	else printf("in <%dms> \n", msec);
+/**
+ Auxiliary function for print_profile_json.
+ Prints op as a json object, durations in ns.
+*/
+static void _print_profile_hist_json(profile_hist_t *op) {
 
+	printf("{\"count\":%lu,\"sum\":%lu,\"min\":%lu,\"max\":%lu,\"p50\":%lu,\"p90\":%lu,\"p99\":%lu}",
+		op->count, op->sum, op->min, op->max,
+		profile_hist_percentile(op, 0.5), profile_hist_percentile(op, 0.9), profile_hist_percentile(op, 0.99));
 }
 
 /**
- Prints the total walk time in seconds.
+ Auxiliary function for print_schedule_report and print_profile_json.
+ Returns the time spent in the walks of group according to op, in ns: the walks of its primes in its degree,
+ and for a group of several velu primes the work they share.
 */
-void print_verbose_walk_total_time(int total_time){
+static ulong _schedule_group_time(schedule_group_t *group, schedule_t *plan, key__t *key, profile_report_t *op) {
 
+	ulong t = 0;
 
-	printf("VERBOSE::apply_key:Total user-time: %ds\n", total_time/1000);
+	for(uint i = 0; i < op->nb_walks; i++) {
+		profile_walk_t *w = op->walks + i;
+		int match = (w->dir != 0 && w->r == group->r && w->l == 0 && group->type == 2 && group->n > 1);
+
+		for(uint j = 0; !match && w->dir != 0 && j < group->n; j++) {
+			match = (w->r == group->r && fmpz_equal_ui(key->lprimes[plan->order[group->first + j]].l, w->l));
+		}
+		if(!match) continue;
+
+		for(uint k = 0; k < OPCOUNT_NB_PHASES; k++) t += w->phases[k].sum;
+	}
+	return t;
 }
 
 /**
- Formats the timing results of the walk in a json-friendly output.
+ Auxiliary function for print_schedule_report and print_profile_json.
+ Returns the time spent outside of the walks according to op, in ns, the field changes included.
 */
-void print_timing_json(fmpz_t l, float msec) {
-	printf("\"");
-	fmpz_print(l);
-	printf("\":%f,", msec);
+static ulong _schedule_field_time(profile_report_t *op) {
+
+	ulong t = 0;
+
+	for(uint i = 0; i < op->nb_walks; i++) {
+		if(op->walks[i].dir != 0) continue;
+		for(uint k = 0; k < OPCOUNT_NB_PHASES; k++) t += op->walks[i].phases[k].sum;
+	}
+	return t;
+}
+
+/**
+ Prints the schedule of a key application next to the time measured by the profile op.
+ The cost estimates are in multiplications in the base field, the last column is the measured time per estimated
+ multiplication: the cost model holds as long as it stays about constant across the groups.
+*/
+void print_schedule_report(schedule_t *plan, key__t *key, profile_report_t *op) {
+
+	printf("VERBOSE::apply_key:Schedule, %u group(s), %u field change(s), estimated %.3g mul\n", plan->nb_groups, plan->nb_fields, plan->cost);
+
+	for(uint g = 0; g < plan->nb_groups; g++) {
+		schedule_group_t *group = plan->groups + g;
+		ulong t = _schedule_group_time(group, plan, key, op);
+
+		printf("VERBOSE::apply_key:    r=%u %-7s l=", group->r, (group->type == 1) ? "radical" : "velu");
+		for(uint j = 0; j < group->n; j++) {
+			if(j) printf(",");
+			fmpz_print(key->lprimes[plan->order[group->first + j]].l);
+		}
+		printf(" %lu step(s), estimated %.3g mul, ", group->steps, group->cost);
+		_print_duration(t);
+		printf(", %.3gns/mul\n", group->cost ? t / group->cost : 0);
+	}
+
+	printf("VERBOSE::apply_key:    outside of the walks, estimated %.3g mul, ", plan->field_cost);
+	_print_duration(_schedule_field_time(op));
+	printf("\n");
+}
+
+/**
+ Prints the profile of a key application in json format, durations in ns.
+ See print_profile_report. If plan is not NULL, the schedule of key is printed as well, with its estimated
+ and measured costs, see print_schedule_report.
+*/
+void print_profile_json(profile_report_t *op, schedule_t *plan, key__t *key) {
+
+	printf("{\"elapsed\":%lu,\"walks\":[", op->elapsed);
+	for(uint i = 0; i < op->nb_walks; i++) {
+		profile_walk_t *w = op->walks + i;
+		printf("%s{\"l\":%lu,\"dir\":%d,\"r\":%u,\"steps\":%lu,\"step\":", (i ? "," : ""), w->l, w->dir, w->r, w->steps);
+		_print_profile_hist_json(&w->total);
+		printf(",\"phases\":{");
+		int first = 1;
+		for(uint j = 0; j < OPCOUNT_NB_PHASES; j++) {
+			if(!w->phases[j].count) continue;
+			printf("%s\"%s\":", (first ? "" : ","), opcount_phase_names[j]);
+			_print_profile_hist_json(w->phases + j);
+			first = 0;
+		}
+		printf("}}");
+	}
+	printf("]");
+
+	if(plan) {
+		printf(",\"schedule\":{\"cost\":%.6g,\"fields\":%u,\"field_cost\":%.6g,\"field_time\":%lu,\"groups\":[",
+			plan->cost, plan->nb_fields, plan->field_cost, _schedule_field_time(op));
+		for(uint g = 0; g < plan->nb_groups; g++) {
+			schedule_group_t *group = plan->groups + g;
+			printf("%s{\"r\":%u,\"type\":%u,\"l\":[", (g ? "," : ""), group->r, group->type);
+			for(uint j = 0; j < group->n; j++) {
+				if(j) printf(",");
+				fmpz_print(key->lprimes[plan->order[group->first + j]].l);
+			}
+			printf("],\"steps\":%lu,\"cost\":%.6g,\"time\":%lu}", group->steps, group->cost, _schedule_group_time(group, plan, key, op));
+		}
+		printf("]}");
+	}
+	printf("}\n");
+}
+
+/**
+ Auxiliary function for print_opcount_json.
+ Prints the counts of op as the json member name, unless they are all zero.
+*/
+static void _print_opcount_json(const char *name, opcount_t *op) {
+
+	ulong total = 0;
+	for(uint j = 0; j < OPCOUNT_NB_OPS; j++) total += op->ops[j];
+	if(!total) return;
+
+	printf(",\"%s\":{", name);
+	for(uint j = 0; j < OPCOUNT_NB_OPS; j++) printf("%s\"%s\":%lu", (j ? "," : ""), opcount_op_names[j], op->ops[j]);
+	printf("}");
+}
+
+/**
+ Prints the operation counts of op in json format: the non-zero counts of every walk by phase, then the totals by extension degree.
+ Walks with l = 0 gather the work shared by several primes, and dir = 0 the work done outside of a walk.
+*/
+void print_opcount_json(opcount_report_t *op) {
+
+	printf("{\"walks\":[");
+	for(uint i = 0; i < op->nb_walks; i++) {
+		opcount_walk_t *w = op->walks + i;
+		printf("%s{\"l\":%lu,\"dir\":%d,\"r\":%u", (i ? "," : ""), w->l, w->dir, w->r);
+		for(uint j = 0; j < OPCOUNT_NB_PHASES; j++) {
+			_print_opcount_json(opcount_phase_names[j], w->phases + j);
+		}
+		printf("}");
+	}
+	printf("],\"degrees\":{");
+	int first = 1;
+	for(uint r = 1; r <= OPCOUNT_MAX_DEGREE; r++) {
+		opcount_t *c = op->degrees + r;
+		ulong total = 0;
+		for(uint j = 0; j < OPCOUNT_NB_OPS; j++) total += c->ops[j];
+		if(!total) continue;
+		printf("%s\"%u\":{", (first ? "" : ","), r);
+		for(uint j = 0; j < OPCOUNT_NB_OPS; j++) printf("%s\"%s\":%lu", (j ? "," : ""), opcount_op_names[j], c->ops[j]);
+		printf("}");
+		first = 0;
+	}
+	printf("}}\n");
 }
 
@@ -7,14 +7,18 @@
 #include "../../src/EllipticCurves/models.h"
 #include "../../src/Exchange/keygen.h"
 #include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/profile.h"
+#include "../../src/Exchange/schedule.h"
 
 #include <gmp.h>
 #include <flint/fmpz.h>
 #include <flint/fq.h>
 
-void print_verbose_walk(uint, fmpz_t, fmpz_t, int, int);
-void print_verbose_walk_total_time(int);
-void print_timing_json(fmpz_t, float);
+void print_verbose_walk_failure(fmpz_t *, uint);
+void print_profile_report(profile_report_t *);
+void print_profile_json(profile_report_t *, schedule_t *, key__t *);
+void print_schedule_report(schedule_t *, key__t *, profile_report_t *);
+void print_opcount_json(opcount_report_t *);
 
 #endif
 
@@ -96,10 +96,10 @@ key__t *keygen_(cfg_t *cfg, uint seed, flint_rand_t state) {
 */
 void key_clear(key__t *key) {
 
-	//for(int i = 0; i < key->nb_primes; i++) lprime_clear( &(key->lprimes)[i] );
+	//// The l-primes are shallow copies of the config's, which owns them
 	free(key->lprimes);
 
-	//for(int i = 0; i < key->nb_primes; i++) fmpz_clear( &(key->steps)[i] );
+	for(int i = 0; i < key->nb_primes; i++) fmpz_clear((key->steps)[i]);
 	free(key->steps);
 	free(key);
 }
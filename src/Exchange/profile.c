@@ -0,0 +1,228 @@
+// @file profile.c
+#include "profile.h"
+
+//// Report being filled, current walk and phase, and time of the last hook, per thread like the listener
+static __thread profile_report_t *_profile_report = NULL;
+static __thread profile_walk_t *_profile_walk = NULL;
+static __thread uint _profile_phase = OPCOUNT_OTHER;
+static __thread ulong _profile_last = 0;
+static __thread ulong _profile_begin = 0;
+
+/**
+  Returns the monotonic clock in ns.
+*/
+static ulong _profile_now() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ulong)ts.tv_sec * 1000000000UL + (ulong)ts.tv_nsec;
+}
+
+/**
+  Returns the bucket of a duration of t ns.
+  Durations below 2^PROFILE_SUB_BITS have their own bucket, the others are bucketed by
+  their leading bit and the PROFILE_SUB_BITS bits below it.
+*/
+static uint _profile_bucket(ulong t) {
+
+	if(t < (1UL << PROFILE_SUB_BITS)) return t;
+
+	uint e = 63 - __builtin_clzl(t);
+	uint m = (t >> (e - PROFILE_SUB_BITS)) & ((1UL << PROFILE_SUB_BITS) - 1);
+	return ((e - PROFILE_SUB_BITS + 1) << PROFILE_SUB_BITS) + m;
+}
+
+/**
+  Returns the middle of bucket b in ns.
+*/
+static ulong _profile_bucket_value(uint b) {
+
+	if(b < (1U << PROFILE_SUB_BITS)) return b;
+
+	uint e = (b >> PROFILE_SUB_BITS) + PROFILE_SUB_BITS - 1;
+	ulong m = b & ((1U << PROFILE_SUB_BITS) - 1);
+	ulong low = (1UL << e) + (m << (e - PROFILE_SUB_BITS));
+	return low + (1UL << (e - PROFILE_SUB_BITS)) / 2;
+}
+
+/**
+  Adds a sample of t ns to op.
+*/
+void profile_hist_add(profile_hist_t *op, ulong t) {
+
+	if(!op->count || t < op->min) op->min = t;
+	if(t > op->max) op->max = t;
+	op->count++;
+	op->sum += t;
+	op->buckets[_profile_bucket(t)]++;
+}
+
+/**
+  Adds the samples of op to rop.
+*/
+void profile_hist_merge(profile_hist_t *rop, profile_hist_t *op) {
+
+	if(!op->count) return;
+	if(!rop->count || op->min < rop->min) rop->min = op->min;
+	if(op->max > rop->max) rop->max = op->max;
+	rop->count += op->count;
+	rop->sum += op->sum;
+	for(uint b = 0; b < PROFILE_NB_BUCKETS; b++) rop->buckets[b] += op->buckets[b];
+}
+
+/**
+  Returns the q-quantile of the samples of op in ns, 0 <= q <= 1, up to the resolution of the buckets.
+  Returns 0 if op is empty.
+*/
+ulong profile_hist_percentile(profile_hist_t *op, double q) {
+
+	if(!op->count) return 0;
+
+	// Nearest rank: the smallest sample with at least q * count samples below or equal
+	ulong rank = (ulong)ceil(q * op->count);
+	if(rank < 1) rank = 1;
+	ulong seen = 0;
+	for(uint b = 0; b < PROFILE_NB_BUCKETS; b++) {
+		seen += op->buckets[b];
+		if(seen >= rank) {
+			ulong t = _profile_bucket_value(b);
+			if(t < op->min) t = op->min;
+			if(t > op->max) t = op->max;
+			return t;
+		}
+	}
+	return op->max;
+}
+
+/**
+  Charges the time elapsed since the last hook to the current phase of the current walk.
+*/
+static void _profile_tick() {
+
+	ulong now = _profile_now();
+	if(_profile_walk) _profile_walk->current[_profile_phase] += now - _profile_last;
+	_profile_last = now;
+}
+
+/**
+  Closes the ongoing step of op: the time of each phase used in the step is added to its histogram.
+  If complete = 0 the time is only recorded by phase, the step is not counted.
+*/
+static void _profile_close_step(profile_walk_t *op, int complete) {
+
+	ulong total = 0;
+	for(uint i = 0; i < OPCOUNT_NB_PHASES; i++) {
+		if(!op->current[i]) continue;
+		profile_hist_add(op->phases + i, op->current[i]);
+		total += op->current[i];
+		op->current[i] = 0;
+	}
+
+	if(complete) {
+		profile_hist_add(&op->total, total);
+		op->steps++;
+	}
+}
+
+/**
+  Listener for the walk hook, see opcount_set_walk.
+*/
+static void _profile_walk_hook(ulong l, int dir, uint r) {
+
+	profile_report_t *rep = _profile_report;
+	_profile_tick();
+	_profile_phase = OPCOUNT_OTHER;
+
+	for(uint i = 0; i < rep->nb_walks; i++) {
+		if(rep->walks[i].l == l && rep->walks[i].dir == dir && rep->walks[i].r == r) {
+			_profile_walk = rep->walks + i;
+			return;
+		}
+	}
+
+	if(rep->nb_walks == rep->alloc) {
+		rep->alloc = (rep->alloc ? 2 * rep->alloc : 16);
+		rep->walks = realloc(rep->walks, rep->alloc * sizeof(profile_walk_t));
+	}
+
+	_profile_walk = rep->walks + rep->nb_walks;
+	memset(_profile_walk, 0, sizeof(profile_walk_t));
+	_profile_walk->l = l;
+	_profile_walk->dir = dir;
+	_profile_walk->r = r;
+	rep->nb_walks++;
+}
+
+/**
+  Listener for the phase hook, see opcount_set_phase.
+*/
+static void _profile_phase_hook(uint phase) {
+
+	_profile_tick();
+	_profile_phase = phase;
+}
+
+/**
+  Listener for the step hook, see opcount_step.
+*/
+static void _profile_step_hook() {
+
+	_profile_tick();
+	if(_profile_walk) _profile_close_step(_profile_walk, 1);
+}
+
+static const opcount_listener_t _profile_listener = {_profile_walk_hook, _profile_phase_hook, _profile_step_hook};
+
+/**
+  Initializes op for use.
+  A corresponding call to profile_report_clear() must be made after finishing with op to free the memory.
+*/
+void profile_report_init(profile_report_t *op) {
+
+	op->nb_walks = 0;
+	op->alloc = 0;
+	op->walks = NULL;
+	op->elapsed = 0;
+}
+
+/**
+  Clears op, releasing any memory used.
+*/
+void profile_report_clear(profile_report_t *op) {
+
+	free(op->walks);
+	op->walks = NULL;
+	op->nb_walks = 0;
+	op->alloc = 0;
+}
+
+/**
+  Starts profiling the calling thread into op, which must be initialized.
+*/
+void profile_start(profile_report_t *op) {
+
+	_profile_report = op;
+	_profile_walk = NULL;
+	_profile_phase = OPCOUNT_OTHER;
+	opcount_set_listener(&_profile_listener);
+	_profile_last = _profile_now();
+	_profile_begin = _profile_last;
+	op->elapsed = 0;
+}
+
+/**
+  Stops profiling. The time spent after the last step of each walk is recorded by phase.
+*/
+void profile_stop() {
+
+	profile_report_t *rep = _profile_report;
+	if(!rep) return;
+
+	_profile_tick();
+	for(uint i = 0; i < rep->nb_walks; i++) _profile_close_step(rep->walks + i, 0);
+	rep->elapsed = _profile_last - _profile_begin;
+
+	opcount_set_listener(NULL);
+	_profile_report = NULL;
+	_profile_walk = NULL;
+}
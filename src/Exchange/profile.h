@@ -0,0 +1,61 @@
+#ifndef _profile_H_
+#define _profile_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "../../src/EllipticCurves/opcount.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+
+/*********************************************
+ Phase profiler for apply_key
+ Time is read from the monotonic clock in nanoseconds at every walk, phase and step hook
+ and accumulated by (walk, phase) over each step. When a step ends, the time spent in every
+ phase during the step goes into the histogram of that phase.
+ The hooks are only compiled in with -DPROFILE, -DVERBOSE or -DTIMING.
+ Each thread profiles into its own report; the tasks of the pool helpers are timed within the phase of the caller.
+*********************************************/
+// Logarithmic buckets with PROFILE_SUB_BITS bits of mantissa, about 12% resolution
+#define PROFILE_SUB_BITS 3
+#define PROFILE_NB_BUCKETS ((64 - PROFILE_SUB_BITS + 1) << PROFILE_SUB_BITS)
+
+typedef struct profile_hist_t{
+
+	ulong count;
+	ulong sum, min, max;		// in ns
+	ulong buckets[PROFILE_NB_BUCKETS];
+} profile_hist_t;
+
+typedef struct profile_walk_t{
+
+	ulong l;			// 0 for the work shared by several primes
+	int dir;			// 1 on the curve, -1 on the twist, 0 outside of a walk
+	uint r;				// extension degree
+	ulong steps;			// number of steps completed
+	profile_hist_t phases[OPCOUNT_NB_PHASES];	// time spent in each phase per step
+	profile_hist_t total;		// time per step
+	ulong current[OPCOUNT_NB_PHASES];	// time spent in each phase in the ongoing step
+} profile_walk_t;
+
+typedef struct profile_report_t{
+
+	uint nb_walks, alloc;
+	profile_walk_t *walks;
+	ulong elapsed;			// ns between profile_start and profile_stop
+} profile_report_t;
+
+void profile_report_init(profile_report_t *);
+void profile_report_clear(profile_report_t *);
+void profile_start(profile_report_t *);
+void profile_stop();
+
+void profile_hist_add(profile_hist_t *, ulong);
+void profile_hist_merge(profile_hist_t *, profile_hist_t *);
+ulong profile_hist_percentile(profile_hist_t *, double);
+
+#endif
@@ -0,0 +1,167 @@
+// @file schedule.c
+#include "schedule.h"
+
+/**
+  Auxiliary function for the cost estimates.
+  Returns the cost of a multiplication in the extension of degree r, in multiplications in the base field.
+*/
+static double _schedule_mul(uint r) {
+
+	return pow(r, 1.585);
+}
+
+/**
+  Auxiliary function for the cost estimates.
+  Returns the cost of sampling a point of order l on the curve (dir > 0) or its twist (dir < 0) over F,
+  in multiplications in F: two square tests on average, then the cofactor ladder, over E or over E and its twist.
+*/
+static double _schedule_sampling_cost(int dir, const fq_ctx_t F) {
+
+	double n = (double)fq_ctx_degree(F) * fmpz_bits(fq_ctx_prime(F));	// bits of p^r
+	return 2 * 1.5 * n + 9 * n * (dir < 0 ? 2 : 1);
+}
+
+/**
+  Returns the estimated cost of one step of lp in the direction dir, over the field F of degree lp->r,
+  in multiplications in the base field.
+  The model counts multiplications in F, each worth r^1.585 multiplications in the base field as with Karatsuba:
+  an l-th root for the radical primes, the sampling, torsion check, KPS and xISOG for the Velu primes,
+  over the Frobenius orbits of the kernel when it is cheaper, see velu_ws_set_orbits.
+*/
+double schedule_step_cost(lprime_t *lp, int dir, const fq_ctx_t F) {
+
+	uint r = fq_ctx_degree(F);
+	ulong l = fmpz_get_ui(lp->l);
+	uint s, m;
+	ulong c;
+	double cost, kernel, orbits;
+
+	if(lp->type == 1) {
+		//// One exponentiation of about log2(p^r) bits
+		cost = 1.5 * r * fmpz_bits(fq_ctx_prime(F));
+	}
+	else {
+		kernel = velu_kernel_cost(l, lp->b, lp->bprime, 0, 0);
+		if(velu_orbits(&s, &m, &c, l, r, dir < 0, fq_ctx_prime(F))) {
+			orbits = velu_kernel_cost(l, 0, 0, m, c);
+			if(orbits < kernel) kernel = orbits;
+		}
+
+		cost = _schedule_sampling_cost(dir, F);
+		cost += 6 * lp->daclen;
+		cost += kernel;
+	}
+
+	return cost * _schedule_mul(r);
+}
+
+/**
+  Returns the estimated cost of moving a curve to the field F, in multiplications in the base field.
+  The two coefficients lie in the base field and go through their string representation,
+  which is counted as 4r multiplications.
+*/
+double schedule_field_cost(const fq_ctx_t F) {
+
+	return 4.0 * fq_ctx_degree(F);
+}
+
+/**
+  Auxiliary function for schedule_plan: returns the estimated cost of group.
+  The Velu primes of a group of several primes share the sampling: one point per round and per direction.
+*/
+static double _schedule_group_cost(schedule_t *plan, schedule_group_t *group, key__t *key, cfg_t *cfg) {
+
+	const fq_ctx_t *F = cfg->fields + group->r - 1;
+	int batch = (group->type == 2 && group->n > 1);
+	ulong rounds[2] = {0, 0};
+	double cost = 0;
+
+	for(uint j = 0; j < group->n; j++) {
+		uint i = plan->order[group->first + j];
+		slong k = fmpz_get_si(key->steps[i]);
+		ulong steps = (k < 0) ? -k : k;
+
+		cost += steps * schedule_step_cost(key->lprimes + i, k, *F);
+		if(batch) {
+			cost -= steps * _schedule_sampling_cost(k, *F) * _schedule_mul(group->r);
+			if(steps > rounds[k < 0]) rounds[k < 0] = steps;
+		}
+	}
+
+	cost += (rounds[0] * _schedule_sampling_cost(1, *F) + rounds[1] * _schedule_sampling_cost(-1, *F)) * _schedule_mul(group->r);
+	return cost;
+}
+
+/**
+  Sets plan to the schedule of key, see schedule.h.
+  The base field is walked first since the start curve already lives there, then every other degree once
+  by increasing degree: the number of field changes is the number of degrees used, plus the coercion back
+  to the base field. In each degree the radical primes come first, one group each, then the Velu primes
+  in a single group, or one group each with -DTIMING which profiles every prime on its own.
+  key must have at most NB_PRIMES primes.
+*/
+void schedule_plan(schedule_t *plan, key__t *key, cfg_t *cfg) {
+
+	schedule_group_t *group;
+	lprime_t *lp;
+	uint last = 1;
+
+	plan->nb_primes = 0;
+	plan->nb_groups = 0;
+	plan->nb_fields = 0;
+	plan->field_cost = 0;
+	plan->cost = 0;
+
+	for(uint r = 1; r <= MAX_EXTENSION_DEGREE; r++) {
+
+		uint nb_groups = plan->nb_groups;
+
+		for(uint type = 1; type <= 2; type++) {
+			group = NULL;
+
+			for(uint i = 0; i < key->nb_primes; i++) {
+				lp = key->lprimes + i;
+				if(lp->r != r || lp->type != type || fmpz_is_zero(key->steps[i])) continue;
+
+				//// New group, unless the Velu primes of this degree share one
+				#ifdef TIMING
+				group = NULL;
+				#endif
+				if(!group || type == 1) {
+					group = plan->groups + plan->nb_groups;
+					group->r = r;
+					group->type = type;
+					group->first = plan->nb_primes;
+					group->n = 0;
+					group->steps = 0;
+					plan->nb_groups++;
+				}
+
+				plan->order[plan->nb_primes] = i;
+				plan->nb_primes++;
+				group->n++;
+				group->steps += labs(fmpz_get_si(key->steps[i]));
+			}
+		}
+
+		//// One field change per degree used
+		if(plan->nb_groups > nb_groups && r != last) {
+			plan->nb_fields++;
+			plan->field_cost += schedule_field_cost(cfg->fields[r - 1]);
+			last = r;
+		}
+	}
+
+	//// Coercion back to the base field
+	if(last != 1) {
+		plan->nb_fields++;
+		plan->field_cost += schedule_field_cost(cfg->fields[0]);
+	}
+
+	plan->cost = plan->field_cost;
+	for(uint g = 0; g < plan->nb_groups; g++) {
+		group = plan->groups + g;
+		group->cost = _schedule_group_cost(plan, group, key, cfg);
+		plan->cost += group->cost;
+	}
+}
@@ -0,0 +1,47 @@
+#ifndef _schedule_H_
+#define _schedule_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../../src/EllipticCurves/opcount.h"
+#include "../../src/Isogeny/velu.h"
+#include "../../src/Exchange/setup.h"
+#include "../../src/Exchange/keygen.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*********************************************
+ Walk schedule of apply_key
+ The class group action commutes, so the primes of a key can be walked in any order.
+ The schedule skips the primes with no step, walks every extension degree in one go starting
+ with the base field, and groups the Velu primes of a degree so that they share their torsion points.
+ Costs are estimated in multiplications in the base field, see schedule_step_cost.
+*********************************************/
+typedef struct schedule_group_t {
+
+	uint r;			// extension degree
+	uint type;		// Radical (1) or Velu (2)
+	uint first, n;		// the primes of the group are order[first], ..., order[first + n - 1]
+	ulong steps;		// sum of the absolute step counts
+	double cost;		// estimated cost of the walks, field change excluded
+} schedule_group_t;
+
+typedef struct schedule_t {
+
+	uint nb_primes, nb_groups;
+	uint order[NB_PRIMES];		// indices in the key of the primes to walk
+	schedule_group_t groups[NB_PRIMES];
+	uint nb_fields;			// field changes, the final coercion to the base field included
+	double field_cost;		// estimated cost of the field changes
+	double cost;			// estimated total cost
+} schedule_t;
+
+double schedule_step_cost(lprime_t *, int, const fq_ctx_t);
+double schedule_field_cost(const fq_ctx_t);
+void schedule_plan(schedule_t *, key__t *, cfg_t *);
+
+#endif
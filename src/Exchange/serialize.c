@@ -0,0 +1,207 @@
+// @file serialize.c
+#include "serialize.h"
+
+/**
+  Returns the number of bytes of an element of the prime field F.
+*/
+size_t fq_bytes(const fq_ctx_t F) {
+
+	return (fmpz_bits(fq_ctx_prime(F)) + 7) / 8;
+}
+
+/**
+  Writes op, an element of the prime field F, to buf on fq_bytes(F) bytes.
+*/
+void fq_export(unsigned char *buf, const fq_t op, const fq_ctx_t F) {
+
+	size_t len = fq_bytes(F);
+	fmpz_t a;
+
+	fmpz_init(a);
+	fq_get_fmpz(a, op, F);
+
+	for(size_t i = len; i > 0; i--) {
+		buf[i - 1] = fmpz_fdiv_ui(a, 256);
+		fmpz_fdiv_q_2exp(a, a, 8);
+	}
+
+	fmpz_clear(a);
+}
+
+/**
+  Sets rop to the element of the prime field F written in buf.
+  Returns 1 if successful and 0 if the integer read is not reduced modulo p.
+*/
+int fq_import(fq_t rop, const unsigned char *buf, const fq_ctx_t F) {
+
+	int ret;
+	size_t len = fq_bytes(F);
+	fmpz_t a;
+
+	fmpz_init(a);
+
+	for(size_t i = 0; i < len; i++) {
+		fmpz_mul_2exp(a, a, 8);
+		fmpz_add_ui(a, a, buf[i]);
+	}
+
+	ret = (fmpz_cmp(a, fq_ctx_prime(F)) < 0);
+	if(ret) fq_set_fmpz(rop, a, F);
+
+	fmpz_clear(a);
+	return ret;
+}
+
+/**
+  Returns the number of bytes of a curve over the base field of cfg.
+*/
+size_t MG_curve_bytes(cfg_t *cfg) {
+
+	return fq_bytes(cfg->fields[0]);
+}
+
+/**
+  Writes op to buf. op must be defined over the base field with B = 1, as the outputs of apply_key.
+*/
+void MG_curve_export(unsigned char *buf, MG_curve_t *op) {
+
+	fq_export(buf, op->A, *(op->F));
+}
+
+/**
+  Auxiliary function for MG_curve_import: returns 1 if [N]R = O for MG_IMPORT_POINTS random points R on E
+  and on its quadratic twist, with N = p + 1 - t and p + 1 + t respectively, t being the trace of the base curve.
+  Every curve isogenous to the base curve passes. The samples are seeded from the clock, so that a curve outside
+  the class cannot be crafted around them; such a curve only passes if the orders of all the samples divide N.
+*/
+static int _MG_curve_in_class(MG_curve_t *E) {
+
+	int ret = 1;
+	bool isinfty;
+	flint_rand_t state;
+	struct timespec ts;
+	fmpz_t t, N;
+	fq_t a24, c24;
+	MG_point_t R, Q;
+
+	const fq_ctx_t *F = E->F;
+
+	fmpz_init(t);
+	fmpz_init(N);
+	fq_init(a24, *F);
+	fq_init(c24, *F);
+	MG_point_init(&R, E);
+	MG_point_init(&Q, E);
+	flint_randinit(state);
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	flint_randseed(state, (ulong)ts.tv_nsec ^ (ulong)pthread_self(), (ulong)ts.tv_sec);
+
+	// (a24 : c24) = (A + 2 : 4) since B = 1
+	fq_set_ui(c24, 2, *F);
+	fq_add(a24, E->A, c24, *F);
+	fq_set_ui(c24, 4, *F);
+
+	MG_curve_trace(t);
+	for(int twist = 0; ret && twist < 2; twist++) {
+		fmpz_add_ui(N, fq_ctx_prime(*F), 1);
+		if(twist) fmpz_add(N, N, t);
+		else fmpz_sub(N, N, t);
+
+		for(uint i = 0; ret && i < MG_IMPORT_POINTS; i++) {
+			if(twist) MG_point_rand_ninfty_nsquare_proj(&R, a24, c24, state);
+			else MG_point_rand_ninfty_proj(&R, a24, c24, state);
+			MG_ladder_iter_proj_(&Q, N, &R, a24, c24);
+			MG_point_isinfty(&isinfty, &Q);
+			ret = isinfty;
+		}
+	}
+
+	fmpz_clear(t);
+	fmpz_clear(N);
+	fq_clear(a24, *F);
+	fq_clear(c24, *F);
+	MG_point_clear(&R);
+	MG_point_clear(&Q);
+	flint_randclear(state);
+
+	return ret;
+}
+
+/**
+  Sets rop to the curve written in buf, over the base field of cfg.
+  rop must be initialized over the base field.
+  Public curves come from peers, so the curve must also be isogenous to the base curve of cfg, see _MG_curve_in_class:
+  the walks from a curve outside the class would keep sampling for torsion points that do not exist.
+  Returns 1 if successful and 0 if buf does not hold a Montgomery curve of the isogeny class of the base curve.
+*/
+int MG_curve_import(MG_curve_t *rop, const unsigned char *buf, cfg_t *cfg) {
+
+	int ret;
+	const fq_ctx_t *F = cfg->fields;
+	fq_t A, B;
+
+	fq_init(A, *F);
+	fq_init(B, *F);
+
+	ret = fq_import(A, buf, *F);
+
+	//// Singular curves A = +/-2 are rejected
+	if(ret) {
+		fq_sqr(B, A, *F);
+		fq_sub_ui(B, B, 4, *F);
+		ret = !fq_is_zero(B, *F);
+	}
+	if(ret) {
+		fq_one(B, *F);
+		MG_curve_set(rop, F, A, B);
+		ret = _MG_curve_in_class(rop);
+	}
+
+	fq_clear(A, *F);
+	fq_clear(B, *F);
+	return ret;
+}
+
+/**
+  Returns the number of bytes of a key for cfg.
+*/
+size_t key_bytes(cfg_t *cfg) {
+
+	return 2 * cfg->nb_primes;
+}
+
+/**
+  Writes op to buf.
+*/
+void key_export(unsigned char *buf, key__t *op) {
+
+	for(uint i = 0; i < op->nb_primes; i++) {
+		slong s = fmpz_get_si((op->steps)[i]);
+		buf[2 * i] = ((uint16_t)s >> 8) & 0xff;
+		buf[2 * i + 1] = (uint16_t)s & 0xff;
+	}
+}
+
+/**
+  Sets the steps of rop to the key written in buf.
+  rop must be initialized with the config the key was written for.
+  Returns 1 if successful and 0 if a step is out of the bounds of its l-prime,
+  or walks backward for an l-prime that does not allow it.
+*/
+int key_import(key__t *rop, const unsigned char *buf) {
+
+	int ret = 1;
+
+	for(uint i = 0; i < rop->nb_primes; i++) {
+		lprime_t *lp = (rop->lprimes) + i;
+		slong s = (int16_t)((buf[2 * i] << 8) | buf[2 * i + 1]);
+
+		if(s > (slong)lp->hbound || -s > (slong)lp->hbound) ret = 0;
+		if(s < 0 && !lp->bkw) ret = 0;
+		if(s != 0 && lp->type == 0) ret = 0;
+		fmpz_set_si((rop->steps)[i], ret ? s : 0);
+	}
+
+	return ret;
+}
@@ -0,0 +1,42 @@
+#ifndef _serialize_H_
+#define _serialize_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+#include "../../src/EllipticCurves/auxiliary.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/Exchange/keygen.h"
+#include "../../src/Exchange/setup.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*********************************************
+   Compact binary format
+*********************************************/
+// Elements of the base field are written big-endian on fq_bytes(F) bytes
+// A key is written as one big-endian signed 16-bit step per l-prime, in the order of the config
+// A public curve BY^2 = X^3 + AX^2 + X over the base field is written as A, with B = 1
+// and only accepted on import if it is isogenous to the base curve, tested on MG_IMPORT_POINTS points on each side
+#define MG_IMPORT_POINTS 2
+
+size_t fq_bytes(const fq_ctx_t);
+void fq_export(unsigned char *, const fq_t, const fq_ctx_t);
+int fq_import(fq_t, const unsigned char *, const fq_ctx_t);
+
+size_t MG_curve_bytes(cfg_t *);
+void MG_curve_export(unsigned char *, MG_curve_t *);
+int MG_curve_import(MG_curve_t *, const unsigned char *, cfg_t *);
+
+size_t key_bytes(cfg_t *);
+void key_export(unsigned char *, key__t *);
+int key_import(key__t *, const unsigned char *);
+
+#endif
@@ -11,6 +11,8 @@
 void lprime_init(lprime_t *op){
 
 	fmpz_init(op->l);
+	op->b = 0;
+	op->bprime = 0;
 }
 
 /**
@@ -24,9 +26,10 @@ lprime_t *lprime_init_(){
 }
 
 /**
- Sets op to the lprime l with given type (0:unused, 1:radical, 2:velu), bounds, degree and possibility of backward walking.
+ Sets op to the lprime l with given type (0:unused, 1:radical, 2:velu), bounds, degree, possibility of backward walking
+ and differential addition chain for l.
 */
-void lprime_set(lprime_t *op, fmpz_t l, uint type, uint lbound, uint hbound, uint r, uint bkw){
+void lprime_set(lprime_t *op, fmpz_t l, uint type, uint lbound, uint hbound, uint r, uint bkw, ulong dac, uint daclen){
 
 	fmpz_set(op->l, l);
 
@@ -35,6 +38,8 @@ void lprime_set(lprime_t *op, fmpz_t l, uint type, uint lbound, uint hbound, uin
 	op->hbound = hbound;
 	op->r = r;
 	op->bkw = bkw;
+	op->dac = dac;
+	op->daclen = daclen;
 }
 
 /**
@@ -62,16 +67,19 @@ cfg_t* cfg_init_set() {
 	cfg->fields = (fq_ctx_t *)malloc(sizeof(fq_ctx_t) * MAX_EXTENSION_DEGREE);
 	char gen[] = "x";
 
-	//// Initialize extensions
+	//// Initialize extensions and their Frobenius tables, see fq_frob_register,
+	//// and the Montgomery context of the base prime, see fp512_register
 	fmpz_t base_p;
 	char base_p_str[] = BASE_p;
 
 	fmpz_init(base_p);
 	fmpz_set_str(base_p, base_p_str, 0);
+	fp512_register(base_p);
 
 	for(int i=1; i < MAX_EXTENSION_DEGREE + 1; i++) {
 
 		fq_ctx_init( (cfg->fields)[i-1], base_p, i , gen);
+		fq_frob_register( (cfg->fields)[i-1] );
 	}
 
 	//// Base field shortcut
@@ -127,6 +135,38 @@ cfg_t* cfg_init_set() {
 					1, 1, 0,
 					0,
 					1, 0};
+	//// Differential addition chains for l, found by optimization/dac_search.py
+	ulong l_PRIMES_DAC[NB_PRIMES] = {0, 0, 1,     1, 0, 5, 12,     1101, 3218, 3077, 14612,
+					4, 1568,
+					3073, 324,
+					8, 44, 7176,
+					10, 36, 128,
+					3078,
+					3, 1568};
+	uint l_PRIMES_DACLEN[NB_PRIMES] = {0, 1, 2,     3, 3, 4, 8,     12, 13, 13, 15,
+					4, 12,
+					13, 13,
+					5, 7, 14,
+					5, 7, 11,
+					13,
+					6, 14};
+
+	//// Sqrt-Velu splits (b, b') found by example/tune, (0, 0) for the default split of _init_lengths
+	uint l_PRIMES_B[NB_PRIMES] = {0, 0, 0,     0, 0, 0, 0,     0, 0, 0, 0,
+					0, 0,
+					0, 0,
+					0, 0, 0,
+					0, 0, 0,
+					0,
+					0, 0};
+
+	uint l_PRIMES_BPRIME[NB_PRIMES] = {0, 0, 0,     0, 0, 0, 0,     0, 0, 0, 0,
+					0, 0,
+					0, 0,
+					0, 0, 0,
+					0, 0, 0,
+					0,
+					0, 0};
 
 	//// Alloc lprimes array
 	cfg->lprimes = (lprime_t *)malloc(sizeof(lprime_t) * NB_PRIMES);
@@ -144,7 +184,7 @@ cfg_t* cfg_init_set() {
 		fmpz_set_ui(l_fmpz, l);
 
 		switch(l) {
-			case 3: case 5: case 7:
+			case 3: case 5: case 7: case 11: case 13:
 				type = 1;	//radical isogeny
 				lbound = l_PRIMES_LBOUNDS[i];
 				hbound = l_PRIMES_HBOUNDS[i];
@@ -161,18 +201,73 @@ cfg_t* cfg_init_set() {
 				break;
 		}
 		lprime_init(&(cfg->lprimes)[i]);
-		lprime_set(&(cfg->lprimes)[i], l_fmpz, type, lbound, hbound, r, bkw);
+		lprime_set(&(cfg->lprimes)[i], l_fmpz, type, lbound, hbound, r, bkw, l_PRIMES_DAC[i], l_PRIMES_DACLEN[i]);
+		(cfg->lprimes)[i].b = l_PRIMES_B[i];
+		(cfg->lprimes)[i].bprime = l_PRIMES_BPRIME[i];
 	}
 
 
 	//// Random seed for key generation
 	cfg->seed = 0;
 
+	//// No first steps from the base curve, see cfg_precompute
+	cfg->E_ext = NULL;
+	cfg->start = NULL;
+
 	fmpz_clear(l_fmpz);
 	fmpz_clear(base_p);
 	return cfg;
 }
 
+/**
+  Fills the first steps of the walks from the base curve, see cfg_start_t, so that apply_key
+  does not sample them for the first prime it walks from there.
+  This costs about two samplings per l-prime, one per direction, some of them in large extensions:
+  it pays off for a process that applies many keys, and is not done by cfg_init_set.
+  Must be called before cfg is shared between threads; the table is only read afterwards.
+  Returns 1 if every direction could be filled and 0 otherwise, the missing ones falling back to sampling:
+  947 and 1723 have no point of order l on the base curve, see keygen.
+*/
+int cfg_precompute(cfg_t *cfg) {
+
+	int ec = 1;
+	lprime_t *lp;
+	cfg_start_t *s;
+	MG_curve_t *E;
+
+	if(cfg->start) return 1;
+
+	//// Base curve over each extension
+	cfg->E_ext = malloc(sizeof(MG_curve_t) * MAX_EXTENSION_DEGREE);
+	for(int r = 0; r < MAX_EXTENSION_DEGREE; r++) {
+		MG_curve_init(&(cfg->E_ext)[r], cfg->fields);
+		MG_curve_set_(&(cfg->E_ext)[r], cfg->E);
+		if(r > 0) MG_curve_update_field_(&(cfg->E_ext)[r], cfg->fields + r);
+	}
+
+	//// Both directions of each l-prime
+	cfg->start = malloc(sizeof(cfg_start_t) * cfg->nb_primes);
+	for(uint i = 0; i < cfg->nb_primes; i++) {
+		lp = cfg->lprimes + i;
+		s = cfg->start + i;
+		E = cfg->E_ext + lp->r - 1;
+
+		for(int dir = 0; dir < 2; dir++) {
+			TN_curve_init(&s->TN[dir], lp->l, E->F);
+			MG_point_init(&s->P[dir], E);
+
+			s->ok[dir] = 0;
+			if(dir == 1 && !lp->bkw) continue;
+
+			if(lp->type == 1) s->ok[dir] = walk_rad_start(&s->TN[dir], E, lp->l, dir);
+			else s->ok[dir] = walk_velu_start(&s->P[dir], E, lp->l, lp->dac, lp->daclen, dir);
+			ec &= s->ok[dir];
+		}
+	}
+
+	return ec;
+}
+
 /**
   Prints a compact representation of the global configuration to stdout.
 */
@@ -200,12 +295,30 @@ void cfg_clear(cfg_t *op) {
 	MG_curve_clear(op->E);
 	free(op->E);
 
+	//// Clear the first steps from the base curve, if any
+	if(op->start) {
+		for(uint i = 0; i < op->nb_primes; i++) {
+			for(int dir = 0; dir < 2; dir++) {
+				TN_curve_clear(&(op->start)[i].TN[dir]);
+				MG_point_clear(&(op->start)[i].P[dir]);
+			}
+		}
+		for(int r = 0; r < MAX_EXTENSION_DEGREE; r++) MG_curve_clear(&(op->E_ext)[r]);
+		free(op->start);
+		free(op->E_ext);
+	}
+
 	//// Clear l-primes and free the array
 	for(int i = 0; i < NB_PRIMES; i++) lprime_clear( &(op->lprimes)[i] );
 	free(op->lprimes);
 
-	//// Clear the fields and free the array
-	for(int i = 0; i < MAX_EXTENSION_DEGREE; i++) fq_ctx_clear( (op->fields)[i] );
+	//// Clear the fields with their Frobenius tables and free the array
+	//// with the Montgomery context of the base prime
+	fp512_unregister(fq_ctx_prime( (op->fields)[0] ));
+	for(int i = 0; i < MAX_EXTENSION_DEGREE; i++) {
+		fq_frob_unregister( (op->fields)[i] );
+		fq_ctx_clear( (op->fields)[i] );
+	}
 	free(op->fields);
 
 	free(op);
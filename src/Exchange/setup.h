@@ -6,6 +6,9 @@
 
 #include "../../src/EllipticCurves/models.h"
 #include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/frobenius.h"
+#include "../../src/EllipticCurves/fp512.h"
+#include "../../src/Isogeny/walk.h"
 
 #include <gmp.h>
 #include <flint/fmpz.h>
@@ -32,8 +35,26 @@ typedef struct lprime_t{
 	uint lbound, hbound;	// Bounds for the walk
 	uint r;			// Working extension degree
 	uint bkw;		// 1 if backward walking possible
+	ulong dac;		// Differential addition chain computing l, see MG_xMUL_dac_proj
+	uint daclen;		// Length of the chain
+	uint b, bprime;		// Sqrt-Velu split, see velu_ws_init: (0, 0) for the default one
 } lprime_t ;
 
+/*********************************************
+   First steps from the base curve
+   Every public key is walked from the base curve, see apply_key. For each l-prime and each direction
+   (0: on the curve, 1: on its twist, only if it walks backward), cfg_precompute stores what the first walk
+   from the base curve over F_{p^r} would sample: the Tate normal form of the radical primes, whose point
+   (0, 0) has order l, or 9 for l = 3 on the curve, see walk_rad_start, and a point of order l for the Velu primes,
+   see walk_velu_start.
+*********************************************/
+typedef struct cfg_start_t{
+
+	int ok[2];		// 1 if the direction is filled
+	TN_curve_t TN[2];	// Radical primes
+	MG_point_t P[2];	// Velu primes, on the base curve over F_{p^r}
+} cfg_start_t;
+
 /*********************************************
    Global configuration structure
 *********************************************/
@@ -51,17 +72,22 @@ typedef struct cfg_t{
 
 	//// Random seed
 	uint seed;
+
+	//// First steps from the base curve, see cfg_precompute, NULL until then
+	MG_curve_t *E_ext;		// base curve over each extension
+	cfg_start_t *start;		// one per l-prime
 } cfg_t;
 
 
 void lprime_init(lprime_t *);
 lprime_t *lprime_init_();
-void lprime_set(lprime_t *, fmpz_t, uint, uint, uint, uint, uint);
+void lprime_set(lprime_t *, fmpz_t, uint, uint, uint, uint, uint, ulong, uint);
 void lprime_clear(lprime_t *);
 
 cfg_t *cfg_init_set();
 void cfg_print(cfg_t *);
 void cfg_clear(cfg_t *);
+int cfg_precompute(cfg_t *);
 
 #endif
 
@@ -0,0 +1,172 @@
+// @file tune.c
+#include "tune.h"
+
+/**
+  Returns the monotonic clock in seconds.
+*/
+static double _tune_now() {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/**
+  Auxiliary function for tune_split.
+  Sets (a24 : c24) to the codomain of the isogeny of kernel <P> with the split (b, b'), from the curve (a24_0 : c24_0),
+  and returns the fastest of reps runs in seconds. As in the walks, the isogeny goes over the Frobenius orbits
+  of the kernel when they are cheaper than the split, P being on the curve (twist = 0) or on its twist (twist = 1).
+*/
+static double _tune_time(fq_t a24, fq_t c24, MG_point_t P, const fq_t a24_0, const fq_t c24_0, uint l, uint b, uint bprime, int twist, uint reps) {
+
+	const fq_ctx_t *F = P.E->F;
+	double t, best = -1;
+	velu_ws_t ws;
+
+	velu_ws_init(&ws, l, b, bprime, P.E);
+	velu_ws_set_orbits(&ws, twist);
+
+	for(uint i = 0; i < reps; i++) {
+		fq_set(a24, a24_0, *F);
+		fq_set(c24, c24_0, *F);
+
+		t = _tune_now();
+		isogeny_from_torsion_proj(a24, c24, P, &ws);
+		t = _tune_now() - t;
+
+		if(best < 0 || t < best) best = t;
+	}
+
+	velu_ws_clear(&ws);
+
+	return best;
+}
+
+/**
+  Sets lp->b, lp->bprime to the fastest split of the steps of lp in its field cfg->fields[lp->r - 1],
+  timing reps isogenies on the same point of order l for each candidate, and fills rop with the timings.
+  The candidates are the default split of _init_lengths and the splits (b, (l-1)/4b) for b0/2 <= b <= 2b0,
+  where b0 is the default b: a smaller b' for the same b only makes K longer.
+  A candidate is only kept if its codomain is the one of the default split.
+  The point is sampled as in the walks, see walk_velu_start, on the curve or else on its twist.
+  A prime whose steps go over the Frobenius orbits of the kernel with the default split, see velu_ws_set_orbits,
+  does not use its split: it is skipped, with rop->orbits set and lp->b = lp->bprime = 0.
+  Returns 0 if lp is not a Velu prime or no point of order l was found, and leaves lp unchanged.
+*/
+int tune_split(tune_split_t *rop, lprime_t *lp, cfg_t *cfg, uint reps) {
+
+	if(lp->type != 2) return 0;
+
+	int ec, twist = 0;
+	uint l = fmpz_get_ui(lp->l);
+	uint b, bprime, lenK, b_min, b_max;
+	double t;
+
+	//// Init variables
+	const fq_ctx_t *F = cfg->fields + lp->r - 1;
+	fq_t a24_0, c24_0, a24, c24, a24_d, c24_d, u, v;
+	MG_curve_t E;
+	MG_point_t P;
+	velu_ws_t ws;
+
+	fq_init(a24_0, *F);
+	fq_init(c24_0, *F);
+	fq_init(a24, *F);
+	fq_init(c24, *F);
+	fq_init(a24_d, *F);
+	fq_init(c24_d, *F);
+	fq_init(u, *F);
+	fq_init(v, *F);
+	MG_curve_init(&E, F);
+	MG_point_init(&P, &E);
+
+	//// Base curve in the field of lp, as (A+2 : 4)
+	MG_curve_update_field(&E, cfg->E, F);
+	fq_add_ui(a24_0, E.A, 2, *F);
+	fq_set_ui(c24_0, 4, *F);
+
+	//// A point of order l, on the curve or on its twist
+	ec = walk_velu_start(&P, &E, lp->l, lp->dac, lp->daclen, twist);
+	if(!ec) ec = walk_velu_start(&P, &E, lp->l, lp->dac, lp->daclen, ++twist);
+
+	if(ec) {
+		_init_lengths(&rop->b0, &rop->bprime0, &lenK, l);
+		rop->l = l;
+		rop->r = lp->r;
+		rop->t0 = 0;
+		rop->t = 0;
+		rop->b = rop->b0;
+		rop->bprime = rop->bprime0;
+		rop->nb_candidates = 0;
+
+		//// Steps over the Frobenius orbits of the kernel
+		velu_ws_init(&ws, l, 0, 0, &E);
+		rop->orbits = velu_ws_set_orbits(&ws, twist);
+		velu_ws_clear(&ws);
+	}
+
+	if(ec && rop->orbits) {
+		lp->b = 0;
+		lp->bprime = 0;
+	}
+	else if(ec) {
+		//// Default split, the reference for the codomain
+		rop->t0 = _tune_time(a24_d, c24_d, P, a24_0, c24_0, l, rop->b0, rop->bprime0, twist, reps);
+		rop->t = rop->t0;
+		rop->nb_candidates = 1;
+
+		b_min = (rop->b0 > 1) ? rop->b0 / 2 : 1;
+		b_max = 2 * rop->b0;
+		for(b = b_min; b <= b_max; b++) {
+			bprime = (l - 1) / (4 * b);
+			if(!velu_split_valid(l, b, bprime) || (b == rop->b0 && bprime == rop->bprime0)) continue;
+
+			t = _tune_time(a24, c24, P, a24_0, c24_0, l, b, bprime, twist, reps);
+			rop->nb_candidates++;
+
+			//// Same codomain as the default split, up to the projective factor
+			fq_mul(u, a24, c24_d, *F);
+			fq_mul(v, a24_d, c24, *F);
+			if(!fq_equal(u, v, *F)) continue;
+
+			if(t < rop->t) {
+				rop->t = t;
+				rop->b = b;
+				rop->bprime = bprime;
+			}
+		}
+
+		lp->b = rop->b;
+		lp->bprime = rop->bprime;
+	}
+
+	fq_clear(a24_0, *F);
+	fq_clear(c24_0, *F);
+	fq_clear(a24, *F);
+	fq_clear(c24, *F);
+	fq_clear(a24_d, *F);
+	fq_clear(c24_d, *F);
+	fq_clear(u, *F);
+	fq_clear(v, *F);
+	MG_point_clear(&P);
+	MG_curve_clear(&E);
+
+	return ec;
+}
+
+/**
+  Tunes the split of every Velu prime of cfg with tune_split, timing reps isogenies per candidate.
+  Returns 1 if every Velu prime was tuned and 0 otherwise.
+*/
+int tune_cfg(cfg_t *cfg, uint reps) {
+
+	int ec = 1;
+	tune_split_t res;
+
+	for(uint i = 0; i < cfg->nb_primes; i++) {
+		if(cfg->lprimes[i].type != 2) continue;
+		ec &= tune_split(&res, cfg->lprimes + i, cfg, reps);
+	}
+
+	return ec;
+}
@@ -0,0 +1,41 @@
+#ifndef _tune_H_
+#define _tune_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../../src/EllipticCurves/models.h"
+#include "../../src/EllipticCurves/memory.h"
+#include "../../src/EllipticCurves/arithmetic.h"
+#include "../../src/Isogeny/velu.h"
+#include "../../src/Exchange/setup.h"
+
+#include <gmp.h>
+#include <flint/fmpz.h>
+#include <flint/fq.h>
+
+/*********************************************
+ Autotuner of the sqrt-Velu split
+ The default split (b, b') of _init_lengths balances the sizes of I and J, which only approximates
+ the real costs of the products, the multievaluation and the resultants in a given field.
+ The tuner times isogeny_from_torsion_proj on a point of order l of the base curve in the field of
+ each Velu prime, for the splits around the default one, and stores the fastest in lp->b, lp->bprime.
+ The primes whose steps go over the Frobenius orbits of the kernel, see velu_ws_set_orbits, keep the default split.
+ Tuning is done once after cfg_init_set, before any apply_key: the lprimes are only read afterwards.
+*********************************************/
+typedef struct tune_split_t {
+
+	ulong l;
+	uint r;				// extension degree
+	uint b, bprime;			// fastest split
+	uint b0, bprime0;		// default split
+	double t, t0;			// seconds per isogeny with the fastest and the default split
+	uint nb_candidates;
+	int orbits;			// 1 if the steps go over the Frobenius orbits of the kernel, the split is then not tuned
+} tune_split_t;
+
+int tune_split(tune_split_t *, lprime_t *, cfg_t *, uint);
+int tune_cfg(cfg_t *, uint);
+
+#endif
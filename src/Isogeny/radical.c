@@ -1,5 +1,39 @@
 // @file radical.c
 #include "radical.h"
+#include "radical_tables.h"
+
+/**
+  Prime field version of fq_nth_root_trick.
+  The exponentiation is done on the integer representative of op with fp512_powm, or fmpz_powm if p
+  is not registered or the fp512 kernel is not fast, which is much cheaper than the generic fq_pow on a degree 1 extension.
+  The sign is read off the quadratic character of op, since
+	(op ^ e)^l = op ^ ((p + 1) / 2) = op * (op / p).
+**/
+static void _fq_nth_root_trick_prime(fq_t rop, fq_t op, fmpz_t l, const fq_ctx_t F) {
+
+	fmpz_t a, e;
+	const fmpz *p = fq_ctx_prime(F);
+
+	fmpz_init(a);
+	fmpz_init(e);
+
+	//// Compute e = (p + 1) / 2l
+	fmpz_mul_ui(e, l, 2);
+	fmpz_add_ui(a, p, 1);
+	fmpz_fdiv_q(e, a, e);
+
+	//// Compute a = op ^ e, negated when op is not a square
+	fq_get_fmpz(a, op, F);
+	int sgn = fmpz_jacobi(a, p);
+	if(!fp512_powm(a, a, e, p)) fmpz_powm(a, a, e, p);
+	OPCOUNT_ADD(OPCOUNT_POW, F);
+	if(sgn == -1) fmpz_neg(a, a);
+
+	fq_set_fmpz(rop, a, F);
+
+	fmpz_clear(a);
+	fmpz_clear(e);
+}
 
 /**
   Extract n-th root of op using the following trick:
@@ -16,6 +50,14 @@
 **/
 void fq_nth_root_trick(fq_t rop, fq_t op, fmpz_t l, const fq_ctx_t F) {
 
+	OPCOUNT_ADD(OPCOUNT_ROOT, F);
+
+	//// Prime field, see _fq_nth_root_trick_prime
+	if(fq_ctx_degree(F) == 1) {
+		_fq_nth_root_trick_prime(rop, op, l, F);
+		return;
+	}
+
 	fmpz_t tmp, e, p;
 	fq_t sgn_check, alpha;
 
@@ -60,7 +102,43 @@ void fq_nth_root_trick_ui(fq_t rop, fq_t op, slong l, const fq_ctx_t F) {
 }
 
 /**
-  Sets rop as the target curve of k steps starting from op in the 3-isogeny graph
+  Sets rop to the l-th root op^e of op with e = 1/l mod q - 1, which is the only one when l is prime to q - 1.
+  It is used where 2l does not divide p + 1, as for the 9-th roots of radical_isogeny_9 with p = 2 mod 3.
+  Over a prime field the exponentiation goes through fp512_powm as in _fq_nth_root_trick_prime.
+**/
+static void _fq_nth_root_inv(fq_t rop, fq_t op, ulong l, const fq_ctx_t F) {
+
+	fmpz_t a, e;
+	const fmpz *p = fq_ctx_prime(F);
+
+	OPCOUNT_ADD(OPCOUNT_ROOT, F);
+	fmpz_init(a);
+	fmpz_init(e);
+
+	//// Compute e = 1/l mod q - 1
+	fq_ctx_order(a, F);
+	fmpz_sub_ui(a, a, 1);
+	fmpz_set_ui(e, l);
+	fmpz_invmod(e, e, a);
+
+	//// Compute rop = op ^ e
+	if(fq_ctx_degree(F) == 1) {
+		fq_get_fmpz(a, op, F);
+		if(!fp512_powm(a, a, e, p)) fmpz_powm(a, a, e, p);
+		OPCOUNT_ADD(OPCOUNT_POW, F);
+		fq_set_fmpz(rop, a, F);
+	}
+	else fq_pow(rop, op, e, F);
+
+	fmpz_clear(a);
+	fmpz_clear(e);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 3-isogeny graph.
+  The forward walks of walk_rad go two steps at a time with radical_isogeny_9 and only take their last odd step here,
+  while the backward ones take all their steps here: the twist has #E = 6 mod 9 and no point of order 9.
+  For 5 and 7 there is no such step in either direction: #E = 10 mod 25 and 42 mod 49, 5 and 7 mod 25 and 49 on the twist.
 */
 void radical_isogeny_3(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 
@@ -108,6 +186,8 @@ void radical_isogeny_3(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 		//// Copy buffer
 		fq_set(a1, tmp2, *F);
 		fq_set(a3, tmp3, *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
 	}
 	//// Set curve
 	fq_neg(tmp1, a1, *F);
@@ -150,6 +230,7 @@ void radical_isogeny_5(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 	fq_init(res, *F);
 	fq_init(num, *F);
 	fq_init(den, *F);
+	for(int i=0; i< 4; i++) fq_init(alpha_pow[i], *F);
 	fmpz_init_set_ui(l, 5);
 
 	// Init b = op->b
@@ -163,7 +244,6 @@ void radical_isogeny_5(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 
 		//// Store alpha ^ i for i = 1 to 4
 		for(int i=0; i< 4; i++){
-			fq_init(alpha_pow[i], *F);
 			if(i == 0) fq_set(alpha_pow[i], alpha, *F);
 			else fq_mul(alpha_pow[i], alpha_pow[i-1], alpha, *F);
 		}
@@ -194,11 +274,14 @@ void radical_isogeny_5(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 
 		//// Copy buffer
 		fq_set(b, res, *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
 	}
 	//// Set curve (here b = c)
 	TN_curve_set(rop, b, b, l, F);
 
 	fmpz_clear(l);
+	fq_clear(b, *F);
 	fq_clear(alpha, *F);
 	fq_clear(tmp1, *F);
 	fq_clear(tmp2, *F);
@@ -230,6 +313,8 @@ void radical_isogeny_7(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 	fq_init(tmp4, *F);
 	fq_init(num, *F);
 	fq_init(den, *F);
+	for(int i=0; i< 6; i++) fq_init(alpha_pow[i], *F);
+	for(int i=0; i< 4; i++) fq_init(A_pow[i], *F);
 	fmpz_init_set_ui(l, 7);
 
 	// We're only using A = b/c and b = A^2(A-1) in the loop
@@ -248,14 +333,12 @@ void radical_isogeny_7(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 
 		//// Store alpha ^ i for i = 1 to 6
 		for(int i=0; i< 6; i++){
-			fq_init(alpha_pow[i], *F);
 			if(i == 0) fq_set(alpha_pow[i], alpha, *F);
 			else fq_mul(alpha_pow[i], alpha_pow[i-1], alpha, *F);
 		}
 
 		//// Store A ^ i for i = 1 to 4
 		for(int i=0; i< 4; i++){
-			fq_init(A_pow[i], *F);
 			if(i == 0) fq_set(A_pow[i], A, *F);
 			else fq_mul(A_pow[i], A_pow[i-1], A, *F);
 		}
@@ -283,6 +366,8 @@ void radical_isogeny_7(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 		//// Finally compute A_new =  * num / den
 		fq_inv(tmp4, den, *F);
 		fq_mul(A, num, tmp4, *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
 	}
 	// Set curve (here c = A(A-1) and b = Ac)
 	fq_sub_ui(tmp4, A, 1, *F);
@@ -308,3 +393,1155 @@ void radical_isogeny_7(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
 	for(int i=0; i< 4; i++) fq_clear(A_pow[i], *F);
 }
 
+
+/**
+  Same as radical_isogeny_5 without any inversion in the loop.
+  The coefficient b is carried as a fraction N/D. Writing alpha = a/D, the root is extracted as
+	a = (N * D^4)^(1/5)
+  and the new fraction is read off the homogenized step formula, so that only the final b = N/D costs an inversion.
+*/
+void radical_isogeny_5_proj(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
+
+	// Nothing to do
+	if(fmpz_equal_ui(k, 0)) {
+		TN_curve_set_(rop, op);
+		return;
+	}
+
+	fmpz_t l;
+	fq_t N, D, a, a2, D2, aD, tmp1, tmp2, num, den;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N, *F);
+	fq_init(D, *F);
+	fq_init(a, *F);
+	fq_init(a2, *F);
+	fq_init(D2, *F);
+	fq_init(aD, *F);
+	fq_init(tmp1, *F);
+	fq_init(tmp2, *F);
+	fq_init(num, *F);
+	fq_init(den, *F);
+	fmpz_init_set_ui(l, 5);
+
+	// Init b = N/D = op->b/1
+	fq_set(N, op->b, *F);
+	fq_one(D, *F);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Extract root a of N * D^4 so that alpha = a/D
+		fq_sqr(D2, D, *F);
+		fq_sqr(tmp1, D2, *F);
+		fq_mul(tmp1, tmp1, N, *F);
+		fq_nth_root_trick_ui(a, tmp1, 5, *F);
+
+		fq_sqr(a2, a, *F);
+		fq_mul(aD, a, D, *F);
+
+		// Compute base shared by numerator and denominator: a^4 + 4a^2D^2 + D^4
+		fq_sqr(num, a2, *F);
+		fq_mul(tmp1, a2, D2, *F);
+		fq_mul_ui(tmp1, tmp1, 4, *F);
+		fq_add(num, num, tmp1, *F);
+		fq_sqr(tmp1, D2, *F);
+		fq_add(num, num, tmp1, *F);
+		fq_set(den, num, *F);
+
+		//// Finish num = base + aD(2D^2 + 3a^2)
+		fq_mul_ui(tmp1, D2, 2, *F);
+		fq_mul_ui(tmp2, a2, 3, *F);
+		fq_add(tmp1, tmp1, tmp2, *F);
+		fq_mul(tmp1, tmp1, aD, *F);
+		fq_add(num, num, tmp1, *F);
+
+		//// Finish den = base - aD(3D^2 + 2a^2)
+		fq_mul_ui(tmp1, D2, 3, *F);
+		fq_mul_ui(tmp2, a2, 2, *F);
+		fq_add(tmp1, tmp1, tmp2, *F);
+		fq_mul(tmp1, tmp1, aD, *F);
+		fq_sub(den, den, tmp1, *F);
+
+		//// New b = alpha * num / den = (a * num) / (D * den)
+		fq_mul(N, a, num, *F);
+		fq_mul(D, D, den, *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Set curve (here b = c)
+	fq_div(N, N, D, *F);
+	TN_curve_set(rop, N, N, l, F);
+
+	fmpz_clear(l);
+	fq_clear(N, *F);
+	fq_clear(D, *F);
+	fq_clear(a, *F);
+	fq_clear(a2, *F);
+	fq_clear(D2, *F);
+	fq_clear(aD, *F);
+	fq_clear(tmp1, *F);
+	fq_clear(tmp2, *F);
+	fq_clear(num, *F);
+	fq_clear(den, *F);
+}
+
+/**
+  Same as radical_isogeny_7 without any inversion in the loop.
+  The parameter A is carried as a fraction N/D. Writing alpha = a/D, the root is extracted as
+	a = (N^4 * (N - D) * D^2)^(1/7)
+  and the new fraction is read off the step formula multiplied by D^6, so that only the final A = N/D costs an inversion.
+*/
+void radical_isogeny_7_proj(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
+
+	fmpz_t l;
+	fq_t N, D, a, a2, a4, a6, N2, N3, N4D2, N3aD, tmp1, num, den, b, c;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N, *F);
+	fq_init(D, *F);
+	fq_init(a, *F);
+	fq_init(a2, *F);
+	fq_init(a4, *F);
+	fq_init(a6, *F);
+	fq_init(N2, *F);
+	fq_init(N3, *F);
+	fq_init(N4D2, *F);
+	fq_init(N3aD, *F);
+	fq_init(tmp1, *F);
+	fq_init(num, *F);
+	fq_init(den, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	fmpz_init_set_ui(l, 7);
+
+	// We're only using A = b/c = N/D in the loop
+	fq_set(N, op->b, *F);
+	fq_set(D, op->c, *F);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Set N^2, N^3 and N^4 * D^2
+		fq_sqr(N2, N, *F);
+		fq_mul(N3, N2, N, *F);
+		fq_mul(tmp1, N2, D, *F);
+		fq_sqr(N4D2, tmp1, *F);
+
+		//// Extract root a of N^4 * (N - D) * D^2 = D^7 * A^4(A-1) so that alpha = a/D
+		fq_sub(tmp1, N, D, *F);
+		fq_mul(tmp1, tmp1, N4D2, *F);
+		fq_nth_root_trick_ui(a, tmp1, 7, *F);
+
+		//// Store a^2, a^4, a^6 and N^3 * a * D
+		fq_sqr(a2, a, *F);
+		fq_sqr(a4, a2, *F);
+		fq_mul(a6, a4, a2, *F);
+		fq_mul(N3aD, N3, a, *F);
+		fq_mul(N3aD, N3aD, D, *F);
+
+		//// Compute num = a^6 + N*a^5 + 2N^3a^2D - N^3aD^2 + N^4D^2
+		fq_mul(num, a4, a, *F);
+		fq_mul(num, num, N, *F);
+		fq_add(num, num, a6, *F);
+		fq_add(num, num, N4D2, *F);
+		fq_mul(tmp1, N3aD, a, *F);
+		fq_mul_ui(tmp1, tmp1, 2, *F);
+		fq_add(num, num, tmp1, *F);
+		fq_mul(tmp1, N3aD, D, *F);
+		fq_sub(num, num, tmp1, *F);
+
+		//// Compute den = N^4D^2 - a^6 + N*a^4*D + N^3a^2D - 2N^3aD^2
+		fq_sub(den, N4D2, a6, *F);
+		fq_mul(tmp1, a4, N, *F);
+		fq_mul(tmp1, tmp1, D, *F);
+		fq_add(den, den, tmp1, *F);
+		fq_mul(tmp1, N3aD, a, *F);
+		fq_add(den, den, tmp1, *F);
+		fq_mul(tmp1, N3aD, D, *F);
+		fq_mul_ui(tmp1, tmp1, 2, *F);
+		fq_sub(den, den, tmp1, *F);
+
+		//// New A = num / den
+		fq_swap(N, num, *F);
+		fq_swap(D, den, *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	// Set curve (here A = N/D, c = A(A-1) and b = Ac)
+	fq_div(N, N, D, *F);
+	fq_sub_ui(tmp1, N, 1, *F);
+	fq_mul(c, tmp1, N, *F);
+
+	fq_mul(b, c, N, *F);
+
+	TN_curve_set(rop, b, c, l, F);
+
+	fmpz_clear(l);
+	fq_clear(N, *F);
+	fq_clear(D, *F);
+	fq_clear(a, *F);
+	fq_clear(a2, *F);
+	fq_clear(a4, *F);
+	fq_clear(a6, *F);
+	fq_clear(N2, *F);
+	fq_clear(N3, *F);
+	fq_clear(N4D2, *F);
+	fq_clear(N3aD, *F);
+	fq_clear(tmp1, *F);
+	fq_clear(num, *F);
+	fq_clear(den, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+}
+
+/**
+  Sets rop to the sum of c * x^i * mon[2j + k] over the terms {c, i, k, j} of tab.
+  xp holds the powers of x and mon the monomials in y and alpha.
+  Terms are sorted by (j, k) so that each monomial costs a single multiplication.
+*/
+static void _radical_eval(fq_t rop, const slong (*tab)[4], slong len, fq_t *xp, fq_t *mon, const fq_ctx_t F) {
+
+	fq_t grp, tmp;
+
+	fq_init(grp, F);
+	fq_init(tmp, F);
+	fq_zero(rop, F);
+
+	for(slong t = 0; t < len; t++) {
+
+		//// Accumulate the polynomial in x in front of the current monomial
+		fq_mul_si(tmp, xp[tab[t][1]], tab[t][0], F);
+		fq_add(grp, grp, tmp, F);
+
+		//// Close the group once the monomial changes
+		if(t == len - 1 || tab[t + 1][2] != tab[t][2] || tab[t + 1][3] != tab[t][3]) {
+			fq_mul(grp, grp, mon[2 * tab[t][3] + tab[t][2]], F);
+			fq_add(rop, rop, grp, F);
+			fq_zero(grp, F);
+		}
+	}
+
+	fq_clear(grp, F);
+	fq_clear(tmp, F);
+}
+
+/**
+  Sets (x, y) to the image point x' = xnum/xden, y' = ynum/yden on X_1(l), see radical_tables.h.
+  Both denominators share a single inversion.
+*/
+static void _radical_X1_step(fq_t x, fq_t y, fq_t *xp, fq_t *mon,
+		const slong (*xnum)[4], slong xnum_len, const slong (*xden)[4], slong xden_len,
+		const slong (*ynum)[4], slong ynum_len, const slong (*yden)[4], slong yden_len, const fq_ctx_t F) {
+
+	fq_t nx, dx, ny, dy, inv;
+
+	fq_init(nx, F);
+	fq_init(dx, F);
+	fq_init(ny, F);
+	fq_init(dy, F);
+	fq_init(inv, F);
+
+	_radical_eval(nx, xnum, xnum_len, xp, mon, F);
+	_radical_eval(dx, xden, xden_len, xp, mon, F);
+	_radical_eval(ny, ynum, ynum_len, xp, mon, F);
+	_radical_eval(dy, yden, yden_len, xp, mon, F);
+
+	//// inv = 1 / (dx * dy)
+	fq_mul(inv, dx, dy, F);
+	fq_inv(inv, inv, F);
+
+	fq_mul(x, nx, dy, F);
+	fq_mul(x, x, inv, F);
+	fq_mul(y, ny, dx, F);
+	fq_mul(y, y, inv, F);
+
+	fq_clear(nx, F);
+	fq_clear(dx, F);
+	fq_clear(ny, F);
+	fq_clear(dy, F);
+	fq_clear(inv, F);
+}
+
+/**
+  Sets rop as the target curve of 2k steps starting from op in the 3-isogeny graph, where op has a point (0, 0) of order 9.
+  The steps go two at a time as radical 9-isogenies on the parameter s = c^2/(b - c) of X_1(9), see radical_tables.h,
+  each with a single 9-th root where radical_isogeny_3 takes two cube roots. The curves of the class of the base curve
+  have #E = 18 mod 27 with a cyclic 3-part as p = 2 mod 3, so that the point of order 9 is kept along the walk.
+  rop is set to the Tate normal form of order 3 of the target with the point 3(0, 0), as radical_isogeny_3 takes it:
+  b = 1 and c = 1 - t with t = -(s^3 - 3s^2 + 1)/(s(s - 1)).
+*/
+void radical_isogeny_9(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
+
+	fmpz_t l;
+	fq_t s, a, num, den, tmp1, tmp2, b, c;
+	fq_t sp[13], mon[17];
+
+	const fq_ctx_t *F = op->F;
+	fq_init(s, *F);
+	fq_init(a, *F);
+	fq_init(num, *F);
+	fq_init(den, *F);
+	fq_init(tmp1, *F);
+	fq_init(tmp2, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	for(int i=0; i < 13; i++) fq_init(sp[i], *F);
+	for(int i=0; i < 17; i++) fq_init(mon[i], *F);
+	fmpz_init_set_ui(l, 3);
+
+	//// Point on X_1(9): s = c^2/(b - c)
+	fq_sub(tmp1, op->b, op->c, *F);
+	fq_sqr(s, op->c, *F);
+	fq_div(s, s, tmp1, *F);
+
+	// Main loop that goes through k double steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Powers of s
+		fq_one(sp[0], *F);
+		for(int i=1; i < 13; i++) fq_mul(sp[i], sp[i-1], s, *F);
+
+		//// Extract root a of s^4 (s - 1)(s^2 - s + 1)^3
+		fq_sub(tmp1, sp[2], s, *F);
+		fq_add_ui(tmp1, tmp1, 1, *F);
+		fq_sqr(tmp2, tmp1, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_mul(tmp1, tmp1, sp[4], *F);
+		fq_sub_ui(tmp2, s, 1, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		_fq_nth_root_inv(a, tmp1, 9, *F);
+
+		//// Monomials mon[2j] = a^j, the odd ones stay zero as there is no y on X_1(9)
+		fq_one(mon[0], *F);
+		for(int j=1; j < 9; j++) fq_mul(mon[2*j], mon[2*j - 2], a, *F);
+
+		//// s' = snum / sden
+		_radical_eval(num, _rad9_snum, _RAD_LEN(_rad9_snum), sp, mon, *F);
+		_radical_eval(den, _rad9_sden, _RAD_LEN(_rad9_sden), sp, mon, *F);
+		fq_div(s, num, den, *F);
+
+		OPCOUNT_STEP();
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Tate normal form of 3(0, 0): b = 1 and c = 1 - t = (s^3 - 2s^2 - s + 1)/(s^2 - s)
+	fq_sqr(tmp1, s, *F);
+	fq_sub(den, tmp1, s, *F);
+	fq_mul(num, tmp1, s, *F);
+	fq_mul_ui(tmp2, tmp1, 2, *F);
+	fq_sub(num, num, tmp2, *F);
+	fq_sub(num, num, s, *F);
+	fq_add_ui(num, num, 1, *F);
+	fq_div(c, num, den, *F);
+	fq_one(b, *F);
+
+	TN_curve_set(rop, b, c, l, F);
+
+	fmpz_clear(l);
+	fq_clear(s, *F);
+	fq_clear(a, *F);
+	fq_clear(num, *F);
+	fq_clear(den, *F);
+	fq_clear(tmp1, *F);
+	fq_clear(tmp2, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	for(int i=0; i < 13; i++) fq_clear(sp[i], *F);
+	for(int i=0; i < 17; i++) fq_clear(mon[i], *F);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 11-isogeny graph.
+  The walk takes place on the model y^2 + (x^2 + 1)y + x = 0 of X_1(11), related to
+  the Tate normal form through b = rs(r - 1), c = s(r - 1) with r = 1 + xy and s = 1 - x.
+*/
+void radical_isogeny_11(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
+
+	// Nothing to do
+	if(fmpz_equal_ui(k, 0)) {
+		TN_curve_set_(rop, op);
+		return;
+	}
+
+	fmpz_t l;
+	fq_t r, s, x, y, a, tmp1, tmp2, b, c;
+	fq_t xp[4], mon[20];
+
+	const fq_ctx_t *F = op->F;
+	fq_init(r, *F);
+	fq_init(s, *F);
+	fq_init(x, *F);
+	fq_init(y, *F);
+	fq_init(a, *F);
+	fq_init(tmp1, *F);
+	fq_init(tmp2, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	for(int i=0; i < 4; i++) fq_init(xp[i], *F);
+	for(int i=0; i < 20; i++) fq_init(mon[i], *F);
+	fmpz_init_set_ui(l, 11);
+
+	//// Point on X_1(11): r = b/c, s = c^2/(b - c), x = 1 - s and y = (r - 1)/x
+	fq_div(r, op->b, op->c, *F);
+	fq_sub(tmp1, op->b, op->c, *F);
+	fq_sqr(s, op->c, *F);
+	fq_div(s, s, tmp1, *F);
+	fq_one(x, *F);
+	fq_sub(x, x, s, *F);
+	fq_sub_ui(y, r, 1, *F);
+	fq_div(y, y, x, *F);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Powers of x
+		fq_one(xp[0], *F);
+		for(int i=1; i < 4; i++) fq_mul(xp[i], xp[i-1], x, *F);
+
+		//// Extract root a of x^3 y^2 (x - 1)(y + 1)
+		fq_sub_ui(tmp1, x, 1, *F);
+		fq_mul(tmp1, tmp1, xp[3], *F);
+		fq_add_ui(tmp2, y, 1, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_sqr(tmp2, y, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_nth_root_trick_ui(a, tmp1, 11, *F);
+
+		//// Monomials mon[2j + k] = y^k a^j
+		fq_one(mon[0], *F);
+		for(int j=1; j < 10; j++) fq_mul(mon[2*j], mon[2*j - 2], a, *F);
+		for(int j=0; j < 10; j++) fq_mul(mon[2*j + 1], mon[2*j], y, *F);
+
+		_radical_X1_step(x, y, xp, mon,
+				_rad11_xnum, _RAD_LEN(_rad11_xnum), _rad11_xden, _RAD_LEN(_rad11_xden),
+				_rad11_ynum, _RAD_LEN(_rad11_ynum), _rad11_yden, _RAD_LEN(_rad11_yden), *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Back to Tate normal form: r = 1 + xy, s = 1 - x
+	fq_mul(r, x, y, *F);
+	fq_add_ui(r, r, 1, *F);
+	fq_one(s, *F);
+	fq_sub(s, s, x, *F);
+
+	fq_sub_ui(tmp1, r, 1, *F);
+	fq_mul(c, s, tmp1, *F);
+	fq_mul(b, c, r, *F);
+
+	TN_curve_set(rop, b, c, l, F);
+
+	fmpz_clear(l);
+	fq_clear(r, *F);
+	fq_clear(s, *F);
+	fq_clear(x, *F);
+	fq_clear(y, *F);
+	fq_clear(a, *F);
+	fq_clear(tmp1, *F);
+	fq_clear(tmp2, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	for(int i=0; i < 4; i++) fq_clear(xp[i], *F);
+	for(int i=0; i < 20; i++) fq_clear(mon[i], *F);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 13-isogeny graph.
+  The walk takes place on the model y^2 + (x^3 + x^2 + 1)y - x^2 - x = 0 of X_1(13), related to
+  the Tate normal form through b = rs(r - 1), c = s(r - 1) with r = 1 - xy and s = 1 - xy/(y + 1).
+  The radicand has a denominator D = x(xy - y - 1)^5. Writing alpha = a/D, the root is extracted as
+	a = (D^12 * (x + 1)^4 y^3 (y + 1))^(1/13)
+  and the formulas are multiplied by D^10, so that each step costs a single inversion.
+*/
+void radical_isogeny_13(TN_curve_t *rop, TN_curve_t *op, fmpz_t k) {
+
+	// Nothing to do
+	if(fmpz_equal_ui(k, 0)) {
+		TN_curve_set_(rop, op);
+		return;
+	}
+
+	fmpz_t l;
+	fq_t r, s, x, y, a, D, tmp1, tmp2, b, c;
+	fq_t xp[8], ap[11], Dp[11], mon[22];
+
+	const fq_ctx_t *F = op->F;
+	fq_init(r, *F);
+	fq_init(s, *F);
+	fq_init(x, *F);
+	fq_init(y, *F);
+	fq_init(a, *F);
+	fq_init(D, *F);
+	fq_init(tmp1, *F);
+	fq_init(tmp2, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	for(int i=0; i < 8; i++) fq_init(xp[i], *F);
+	for(int i=0; i < 11; i++) fq_init(ap[i], *F);
+	for(int i=0; i < 11; i++) fq_init(Dp[i], *F);
+	for(int i=0; i < 22; i++) fq_init(mon[i], *F);
+	fmpz_init_set_ui(l, 13);
+
+	//// Point on X_1(13): r = b/c, s = c^2/(b - c), y = (s - r)/(1 - s) and x = (1 - r)/y
+	fq_div(r, op->b, op->c, *F);
+	fq_sub(tmp1, op->b, op->c, *F);
+	fq_sqr(s, op->c, *F);
+	fq_div(s, s, tmp1, *F);
+	fq_sub(y, s, r, *F);
+	fq_one(tmp1, *F);
+	fq_sub(tmp1, tmp1, s, *F);
+	fq_div(y, y, tmp1, *F);
+	fq_one(x, *F);
+	fq_sub(x, x, r, *F);
+	fq_div(x, x, y, *F);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Powers of x
+		fq_one(xp[0], *F);
+		for(int i=1; i < 8; i++) fq_mul(xp[i], xp[i-1], x, *F);
+
+		//// Denominator D = x(xy - y - 1)^5
+		fq_mul(tmp1, x, y, *F);
+		fq_sub(tmp1, tmp1, y, *F);
+		fq_sub_ui(tmp1, tmp1, 1, *F);
+		fq_sqr(D, tmp1, *F);
+		fq_sqr(D, D, *F);
+		fq_mul(D, D, tmp1, *F);
+		fq_mul(D, D, x, *F);
+
+		//// Powers of D up to D^10
+		fq_one(Dp[0], *F);
+		for(int j=1; j < 11; j++) fq_mul(Dp[j], Dp[j-1], D, *F);
+
+		//// Extract root a of D^12 (x + 1)^4 y^3 (y + 1) so that alpha = a/D
+		fq_add_ui(tmp1, x, 1, *F);
+		fq_sqr(tmp1, tmp1, *F);
+		fq_sqr(tmp1, tmp1, *F);
+		fq_sqr(tmp2, y, *F);
+		fq_mul(tmp2, tmp2, y, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_add_ui(tmp2, y, 1, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_mul(tmp1, tmp1, Dp[10], *F);
+		fq_sqr(tmp2, D, *F);
+		fq_mul(tmp1, tmp1, tmp2, *F);
+		fq_nth_root_trick_ui(a, tmp1, 13, *F);
+
+		//// Monomials mon[2j + k] = y^k a^j D^(10 - j)
+		fq_one(ap[0], *F);
+		for(int j=1; j < 11; j++) fq_mul(ap[j], ap[j-1], a, *F);
+		for(int j=0; j < 11; j++) {
+			fq_mul(mon[2*j], ap[j], Dp[10 - j], *F);
+			fq_mul(mon[2*j + 1], mon[2*j], y, *F);
+		}
+
+		_radical_X1_step(x, y, xp, mon,
+				_rad13_xnum, _RAD_LEN(_rad13_xnum), _rad13_xden, _RAD_LEN(_rad13_xden),
+				_rad13_ynum, _RAD_LEN(_rad13_ynum), _rad13_yden, _RAD_LEN(_rad13_yden), *F);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Back to Tate normal form: r = 1 - xy, s = 1 - xy/(y + 1)
+	fq_mul(tmp1, x, y, *F);
+	fq_one(r, *F);
+	fq_sub(r, r, tmp1, *F);
+	fq_add_ui(tmp2, y, 1, *F);
+	fq_div(tmp1, tmp1, tmp2, *F);
+	fq_one(s, *F);
+	fq_sub(s, s, tmp1, *F);
+
+	fq_sub_ui(tmp1, r, 1, *F);
+	fq_mul(c, s, tmp1, *F);
+	fq_mul(b, c, r, *F);
+
+	TN_curve_set(rop, b, c, l, F);
+
+	fmpz_clear(l);
+	fq_clear(r, *F);
+	fq_clear(s, *F);
+	fq_clear(x, *F);
+	fq_clear(y, *F);
+	fq_clear(a, *F);
+	fq_clear(D, *F);
+	fq_clear(tmp1, *F);
+	fq_clear(tmp2, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	for(int i=0; i < 8; i++) fq_clear(xp[i], *F);
+	for(int i=0; i < 11; i++) fq_clear(ap[i], *F);
+	for(int i=0; i < 11; i++) fq_clear(Dp[i], *F);
+	for(int i=0; i < 22; i++) fq_clear(mon[i], *F);
+}
+
+/**
+  Multi-lane version of fq_nth_root_trick: sets every lane of rop to the l-th root of the same lane of op.
+  The sign is checked with a second exponentiation rather than a quadratic character,
+  which would not be the same computation in every lane.
+*/
+void fpv_nth_root_trick(fpv_t *rop, fpv_t *op, ulong l, fpv_ctx_t *ctx) {
+
+	fmpz_t e, ll;
+	fpv_t alpha, sgn_check;
+	uint mask;
+
+	fmpz_init(e);
+	fmpz_init_set_ui(ll, l);
+
+	//// Compute e = (p + 1) / 2l
+	fmpz_add_ui(e, ctx->prime, 1);
+	fmpz_fdiv_q_ui(e, e, 2 * l);
+
+	//// Compute alpha = op ^ e
+	fpv_pow(&alpha, op, e, ctx);
+
+	//// Check for sign, lane by lane
+	fpv_pow(&sgn_check, &alpha, ll, ctx);
+	mask = fpv_equal(&sgn_check, op, ctx);
+	fpv_neg(rop, &alpha, ctx);
+	fpv_select(rop, &alpha, mask);
+
+	fmpz_clear(e);
+	fmpz_clear(ll);
+}
+
+/**
+  Auxiliary function for the multi-lane walks: returns the mask of the lanes among the n first ones
+  which still have a step to take after step steps.
+*/
+static uint _radical_lanes_active(fmpz_t *k, uint n, ulong step) {
+
+	uint mask = 0;
+
+	for(uint i = 0; i < n; i++) {
+		if(fmpz_cmp_ui(k[i], step) > 0) mask |= 1U << i;
+	}
+
+	return mask;
+}
+
+/**
+  Sets rop[i] as the target curve of k[i] steps starting from op[i] in the 3-isogeny graph, for i < n <= FPV_LANES.
+  The n walks run in lockstep, one per lane of ctx, whose field must be that of the curves;
+  a lane stops changing once its k[i] steps are taken. Same step formulas as radical_isogeny_3.
+*/
+void radical_isogeny_3_lanes(TN_curve_t *rop, TN_curve_t *op, fmpz_t *k, uint n, fpv_ctx_t *ctx) {
+
+	fmpz_t l;
+	fq_t b, c;
+	fpv_t a1, a3, tmp1, tmp2, tmp3, tmp4, alpha;
+	uint mask;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(b, *F);
+	fq_init(c, *F);
+	fmpz_init_set_ui(l, 3);
+	fpv_zero(&a1);
+	fpv_zero(&a3);
+
+	// a1 = 1-c, a3 = -b
+	for(uint i = 0; i < n; i++) {
+		fq_one(c, *F);
+		fq_sub(c, c, op[i].c, *F);
+		fpv_set_fq(&a1, i, c, *F, ctx);
+		fq_neg(b, op[i].b, *F);
+		fpv_set_fq(&a3, i, b, *F, ctx);
+	}
+
+	// Main loop, until the last lane is done
+	for(ulong step = 0; (mask = _radical_lanes_active(k, n, step)); step++) {
+
+		//// Extract root of rho = -a3 = b
+		fpv_neg(&tmp1, &a3, ctx);
+		fpv_nth_root_trick(&alpha, &tmp1, 3, ctx);
+
+		//// Compute new a1 = -6*alpha + a1
+		fpv_mul_ui(&tmp2, &alpha, 6, ctx);
+		fpv_sub(&tmp2, &a1, &tmp2, ctx);
+
+		//// Compute new a3' = 3*a1*alpha^2 - a1*alpha + 9*a3
+		fpv_mul_ui(&tmp3, &a3, 9, ctx);
+
+		fpv_mul_ui(&tmp4, &alpha, 3, ctx);
+		fpv_sub(&tmp4, &tmp4, &a1, ctx);
+		fpv_mul(&tmp4, &tmp4, &alpha, ctx);
+		fpv_mul(&tmp4, &tmp4, &a1, ctx);
+
+		fpv_add(&tmp3, &tmp3, &tmp4, ctx);
+
+		//// Copy buffer in the active lanes
+		fpv_select(&a1, &tmp2, mask);
+		fpv_select(&a3, &tmp3, mask);
+		if(walk_yield()) break;
+	}
+	//// Set curves
+	for(uint i = 0; i < n; i++) {
+		fpv_get_fq(c, &a1, i, *F, ctx);
+		fq_neg(c, c, *F);
+		fq_add_ui(c, c, 1, *F);
+		fpv_get_fq(b, &a3, i, *F, ctx);
+		fq_neg(b, b, *F);
+		TN_curve_set(rop + i, b, c, l, F);
+	}
+
+	//// Clear
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	fmpz_clear(l);
+}
+
+/**
+  Sets rop[i] as the target curve of k[i] steps starting from op[i] in the 5-isogeny graph, for i < n <= FPV_LANES.
+  The n walks run in lockstep as in radical_isogeny_3_lanes, with the formulas of radical_isogeny_5_proj.
+*/
+void radical_isogeny_5_lanes(TN_curve_t *rop, TN_curve_t *op, fmpz_t *k, uint n, fpv_ctx_t *ctx) {
+
+	fmpz_t l;
+	fq_t N_i, D_i;
+	fpv_t N, D, a, a2, D2, aD, tmp1, tmp2, num, den;
+	uint mask;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N_i, *F);
+	fq_init(D_i, *F);
+	fmpz_init_set_ui(l, 5);
+	fpv_zero(&N);
+	fpv_one(&D, ctx);
+
+	// Init b = N/D = op->b/1
+	for(uint i = 0; i < n; i++) fpv_set_fq(&N, i, op[i].b, *F, ctx);
+
+	// Main loop, until the last lane is done
+	for(ulong step = 0; (mask = _radical_lanes_active(k, n, step)); step++) {
+
+		//// Extract root a of N * D^4 so that alpha = a/D
+		fpv_sqr(&D2, &D, ctx);
+		fpv_sqr(&tmp1, &D2, ctx);
+		fpv_mul(&tmp1, &tmp1, &N, ctx);
+		fpv_nth_root_trick(&a, &tmp1, 5, ctx);
+
+		fpv_sqr(&a2, &a, ctx);
+		fpv_mul(&aD, &a, &D, ctx);
+
+		// Compute base shared by numerator and denominator: a^4 + 4a^2D^2 + D^4
+		fpv_sqr(&num, &a2, ctx);
+		fpv_mul(&tmp1, &a2, &D2, ctx);
+		fpv_mul_ui(&tmp1, &tmp1, 4, ctx);
+		fpv_add(&num, &num, &tmp1, ctx);
+		fpv_sqr(&tmp1, &D2, ctx);
+		fpv_add(&num, &num, &tmp1, ctx);
+		fpv_set(&den, &num);
+
+		//// Finish num = base + aD(2D^2 + 3a^2)
+		fpv_mul_ui(&tmp1, &D2, 2, ctx);
+		fpv_mul_ui(&tmp2, &a2, 3, ctx);
+		fpv_add(&tmp1, &tmp1, &tmp2, ctx);
+		fpv_mul(&tmp1, &tmp1, &aD, ctx);
+		fpv_add(&num, &num, &tmp1, ctx);
+
+		//// Finish den = base - aD(3D^2 + 2a^2)
+		fpv_mul_ui(&tmp1, &D2, 3, ctx);
+		fpv_mul_ui(&tmp2, &a2, 2, ctx);
+		fpv_add(&tmp1, &tmp1, &tmp2, ctx);
+		fpv_mul(&tmp1, &tmp1, &aD, ctx);
+		fpv_sub(&den, &den, &tmp1, ctx);
+
+		//// New b = alpha * num / den = (a * num) / (D * den), in the active lanes
+		fpv_mul(&num, &a, &num, ctx);
+		fpv_mul(&den, &D, &den, ctx);
+		fpv_select(&N, &num, mask);
+		fpv_select(&D, &den, mask);
+		if(walk_yield()) break;
+	}
+	//// Set curves (here b = c)
+	for(uint i = 0; i < n; i++) {
+		fpv_get_fq(N_i, &N, i, *F, ctx);
+		fpv_get_fq(D_i, &D, i, *F, ctx);
+		fq_div(N_i, N_i, D_i, *F);
+		TN_curve_set(rop + i, N_i, N_i, l, F);
+	}
+
+	//// Clear
+	fq_clear(N_i, *F);
+	fq_clear(D_i, *F);
+	fmpz_clear(l);
+}
+
+/**
+  Sets rop[i] as the target curve of k[i] steps starting from op[i] in the 7-isogeny graph, for i < n <= FPV_LANES.
+  The n walks run in lockstep as in radical_isogeny_3_lanes, with the formulas of radical_isogeny_7_proj.
+*/
+void radical_isogeny_7_lanes(TN_curve_t *rop, TN_curve_t *op, fmpz_t *k, uint n, fpv_ctx_t *ctx) {
+
+	fmpz_t l;
+	fq_t N_i, D_i, b, c;
+	fpv_t N, D, a, a2, a4, a6, N2, N3, N4D2, N3aD, tmp1, num, den;
+	uint mask;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N_i, *F);
+	fq_init(D_i, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	fmpz_init_set_ui(l, 7);
+	fpv_one(&N, ctx);
+	fpv_one(&D, ctx);
+
+	// We're only using A = b/c = N/D in the loop
+	for(uint i = 0; i < n; i++) {
+		fpv_set_fq(&N, i, op[i].b, *F, ctx);
+		fpv_set_fq(&D, i, op[i].c, *F, ctx);
+	}
+
+	// Main loop, until the last lane is done
+	for(ulong step = 0; (mask = _radical_lanes_active(k, n, step)); step++) {
+
+		//// Set N^2, N^3 and N^4 * D^2
+		fpv_sqr(&N2, &N, ctx);
+		fpv_mul(&N3, &N2, &N, ctx);
+		fpv_mul(&tmp1, &N2, &D, ctx);
+		fpv_sqr(&N4D2, &tmp1, ctx);
+
+		//// Extract root a of N^4 * (N - D) * D^2 = D^7 * A^4(A-1) so that alpha = a/D
+		fpv_sub(&tmp1, &N, &D, ctx);
+		fpv_mul(&tmp1, &tmp1, &N4D2, ctx);
+		fpv_nth_root_trick(&a, &tmp1, 7, ctx);
+
+		//// Store a^2, a^4, a^6 and N^3 * a * D
+		fpv_sqr(&a2, &a, ctx);
+		fpv_sqr(&a4, &a2, ctx);
+		fpv_mul(&a6, &a4, &a2, ctx);
+		fpv_mul(&N3aD, &N3, &a, ctx);
+		fpv_mul(&N3aD, &N3aD, &D, ctx);
+
+		//// Compute num = a^6 + N*a^5 + 2N^3a^2D - N^3aD^2 + N^4D^2
+		fpv_mul(&num, &a4, &a, ctx);
+		fpv_mul(&num, &num, &N, ctx);
+		fpv_add(&num, &num, &a6, ctx);
+		fpv_add(&num, &num, &N4D2, ctx);
+		fpv_mul(&tmp1, &N3aD, &a, ctx);
+		fpv_mul_ui(&tmp1, &tmp1, 2, ctx);
+		fpv_add(&num, &num, &tmp1, ctx);
+		fpv_mul(&tmp1, &N3aD, &D, ctx);
+		fpv_sub(&num, &num, &tmp1, ctx);
+
+		//// Compute den = N^4D^2 - a^6 + N*a^4*D + N^3a^2D - 2N^3aD^2
+		fpv_sub(&den, &N4D2, &a6, ctx);
+		fpv_mul(&tmp1, &a4, &N, ctx);
+		fpv_mul(&tmp1, &tmp1, &D, ctx);
+		fpv_add(&den, &den, &tmp1, ctx);
+		fpv_mul(&tmp1, &N3aD, &a, ctx);
+		fpv_add(&den, &den, &tmp1, ctx);
+		fpv_mul(&tmp1, &N3aD, &D, ctx);
+		fpv_mul_ui(&tmp1, &tmp1, 2, ctx);
+		fpv_sub(&den, &den, &tmp1, ctx);
+
+		//// New A = num / den, in the active lanes
+		fpv_select(&N, &num, mask);
+		fpv_select(&D, &den, mask);
+		if(walk_yield()) break;
+	}
+	//// Set curves (here A = N/D, c = A(A-1) and b = Ac)
+	for(uint i = 0; i < n; i++) {
+		fpv_get_fq(N_i, &N, i, *F, ctx);
+		fpv_get_fq(D_i, &D, i, *F, ctx);
+		fq_div(N_i, N_i, D_i, *F);
+		fq_sub_ui(D_i, N_i, 1, *F);
+		fq_mul(c, D_i, N_i, *F);
+		fq_mul(b, c, N_i, *F);
+		TN_curve_set(rop + i, b, c, l, F);
+	}
+
+	//// Clear
+	fq_clear(N_i, *F);
+	fq_clear(D_i, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	fmpz_clear(l);
+}
+
+/**
+  Auxiliary function for the fp512 walks: sets rop to the Montgomery form of op, an element of the prime field F.
+*/
+static void _radical_fp512_set_fq(fp512_t rop, const fq_t op, const fq_ctx_t F, const fp512_ctx_t *ctx) {
+
+	fmpz_t tmp;
+
+	fmpz_init(tmp);
+	fq_get_fmpz(tmp, op, F);
+	fp512_set_fmpz(rop, tmp, ctx);
+	fmpz_clear(tmp);
+}
+
+/**
+  Auxiliary function for the fp512 walks: sets rop to the element of the prime field F of Montgomery form op.
+*/
+static void _radical_fp512_get_fq(fq_t rop, const fp512_t op, const fq_ctx_t F, const fp512_ctx_t *ctx) {
+
+	fmpz_t tmp;
+
+	fmpz_init(tmp);
+	fp512_get_fmpz(tmp, op, ctx);
+	fq_set_fmpz(rop, tmp, F);
+	fmpz_clear(tmp);
+}
+
+/**
+  Montgomery form version of fq_nth_root_trick over F_p: sets rop to the l-th root of op, for e = (p + 1) / 2l.
+  The sign is checked with a second exponentiation, to l, as in fpv_nth_root_trick, which saves leaving Montgomery form.
+*/
+static void _radical_fp512_root(fp512_t rop, const fp512_t op, const fmpz_t e, const fmpz_t l, const fq_ctx_t F, const fp512_ctx_t *ctx) {
+
+	fp512_t alpha, sgn_check;
+
+	OPCOUNT_ADD(OPCOUNT_ROOT, F);
+	OPCOUNT_ADD(OPCOUNT_POW, F);
+
+	fp512_pow(alpha, op, e, ctx);
+	fp512_pow(sgn_check, alpha, l, ctx);
+	if(fp512_equal(sgn_check, op)) memcpy(rop, alpha, sizeof(fp512_t));
+	else fp512_neg(rop, alpha, ctx);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 3-isogeny graph, for a curve over the prime field
+  registered as ctx with fp512. Same step formulas as radical_isogeny_3, in Montgomery form from the first step
+  to the last so that every multiplication is a single call to the fp512 kernel and nothing goes through fq.
+  Only the roots and the steps are counted with -DOPCOUNT.
+*/
+void radical_isogeny_3_fp512(TN_curve_t *rop, TN_curve_t *op, fmpz_t k, const fp512_ctx_t *ctx) {
+
+	fmpz_t l, e;
+	fq_t b, c;
+	fp512_t a1, a3, tmp1, tmp2, tmp3, tmp4, alpha;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(b, *F);
+	fq_init(c, *F);
+	fmpz_init_set_ui(l, 3);
+	fmpz_init(e);
+
+	//// Compute e = (p + 1) / 2l
+	fmpz_add_ui(e, ctx->prime, 1);
+	fmpz_fdiv_q_ui(e, e, 6);
+
+	// a1 = 1-c, a3 = -b
+	fq_one(c, *F);
+	fq_sub(c, c, op->c, *F);
+	_radical_fp512_set_fq(a1, c, *F, ctx);
+	fq_neg(b, op->b, *F);
+	_radical_fp512_set_fq(a3, b, *F, ctx);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Extract root of rho = -a3 = b
+		fp512_neg(tmp1, a3, ctx);
+		_radical_fp512_root(alpha, tmp1, e, l, *F, ctx);
+
+		//// Compute new a1 = -6*alpha + a1
+		fp512_mul_ui(tmp2, alpha, 6, ctx);
+		fp512_sub(tmp2, a1, tmp2, ctx);
+
+		//// Compute new a3' = 3*a1*alpha^2 - a1*alpha + 9*a3
+		fp512_mul_ui(tmp3, a3, 9, ctx);
+
+		fp512_mul_ui(tmp4, alpha, 3, ctx);
+		fp512_sub(tmp4, tmp4, a1, ctx);
+		fp512_mul(tmp4, tmp4, alpha, ctx);
+		fp512_mul(tmp4, tmp4, a1, ctx);
+
+		fp512_add(tmp3, tmp3, tmp4, ctx);
+
+		//// Copy buffer
+		memcpy(a1, tmp2, sizeof(fp512_t));
+		memcpy(a3, tmp3, sizeof(fp512_t));
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Set curve
+	_radical_fp512_get_fq(c, a1, *F, ctx);
+	fq_neg(c, c, *F);
+	fq_add_ui(c, c, 1, *F);
+	_radical_fp512_get_fq(b, a3, *F, ctx);
+	fq_neg(b, b, *F);
+	TN_curve_set(rop, b, c, l, F);
+
+	//// Clear
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	fmpz_clear(l);
+	fmpz_clear(e);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 5-isogeny graph, for a curve over the prime field
+  registered as ctx with fp512, as in radical_isogeny_3_fp512 with the formulas of radical_isogeny_5_proj.
+*/
+void radical_isogeny_5_fp512(TN_curve_t *rop, TN_curve_t *op, fmpz_t k, const fp512_ctx_t *ctx) {
+
+	fmpz_t l, e;
+	fq_t N_i, D_i;
+	fp512_t N, D, a, a2, D2, aD, tmp1, tmp2, num, den;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N_i, *F);
+	fq_init(D_i, *F);
+	fmpz_init_set_ui(l, 5);
+	fmpz_init(e);
+
+	//// Compute e = (p + 1) / 2l
+	fmpz_add_ui(e, ctx->prime, 1);
+	fmpz_fdiv_q_ui(e, e, 10);
+
+	// Init b = N/D = op->b/1
+	_radical_fp512_set_fq(N, op->b, *F, ctx);
+	memcpy(D, ctx->one, sizeof(fp512_t));
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Extract root a of N * D^4 so that alpha = a/D
+		fp512_sqr(D2, D, ctx);
+		fp512_sqr(tmp1, D2, ctx);
+		fp512_mul(tmp1, tmp1, N, ctx);
+		_radical_fp512_root(a, tmp1, e, l, *F, ctx);
+
+		fp512_sqr(a2, a, ctx);
+		fp512_mul(aD, a, D, ctx);
+
+		// Compute base shared by numerator and denominator: a^4 + 4a^2D^2 + D^4
+		fp512_sqr(num, a2, ctx);
+		fp512_mul(tmp1, a2, D2, ctx);
+		fp512_mul_ui(tmp1, tmp1, 4, ctx);
+		fp512_add(num, num, tmp1, ctx);
+		fp512_sqr(tmp1, D2, ctx);
+		fp512_add(num, num, tmp1, ctx);
+		memcpy(den, num, sizeof(fp512_t));
+
+		//// Finish num = base + aD(2D^2 + 3a^2)
+		fp512_mul_ui(tmp1, D2, 2, ctx);
+		fp512_mul_ui(tmp2, a2, 3, ctx);
+		fp512_add(tmp1, tmp1, tmp2, ctx);
+		fp512_mul(tmp1, tmp1, aD, ctx);
+		fp512_add(num, num, tmp1, ctx);
+
+		//// Finish den = base - aD(3D^2 + 2a^2)
+		fp512_mul_ui(tmp1, D2, 3, ctx);
+		fp512_mul_ui(tmp2, a2, 2, ctx);
+		fp512_add(tmp1, tmp1, tmp2, ctx);
+		fp512_mul(tmp1, tmp1, aD, ctx);
+		fp512_sub(den, den, tmp1, ctx);
+
+		//// New b = alpha * num / den = (a * num) / (D * den)
+		fp512_mul(N, a, num, ctx);
+		fp512_mul(D, D, den, ctx);
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Set curve (here b = c)
+	_radical_fp512_get_fq(N_i, N, *F, ctx);
+	_radical_fp512_get_fq(D_i, D, *F, ctx);
+	fq_div(N_i, N_i, D_i, *F);
+	TN_curve_set(rop, N_i, N_i, l, F);
+
+	//// Clear
+	fq_clear(N_i, *F);
+	fq_clear(D_i, *F);
+	fmpz_clear(l);
+	fmpz_clear(e);
+}
+
+/**
+  Sets rop as the target curve of k steps starting from op in the 7-isogeny graph, for a curve over the prime field
+  registered as ctx with fp512, as in radical_isogeny_3_fp512 with the formulas of radical_isogeny_7_proj.
+*/
+void radical_isogeny_7_fp512(TN_curve_t *rop, TN_curve_t *op, fmpz_t k, const fp512_ctx_t *ctx) {
+
+	fmpz_t l, e;
+	fq_t N_i, D_i, b, c;
+	fp512_t N, D, a, a2, a4, a6, N2, N3, N4D2, N3aD, tmp1, num, den;
+
+	const fq_ctx_t *F = op->F;
+	fq_init(N_i, *F);
+	fq_init(D_i, *F);
+	fq_init(b, *F);
+	fq_init(c, *F);
+	fmpz_init_set_ui(l, 7);
+	fmpz_init(e);
+
+	//// Compute e = (p + 1) / 2l
+	fmpz_add_ui(e, ctx->prime, 1);
+	fmpz_fdiv_q_ui(e, e, 14);
+
+	// We're only using A = b/c = N/D in the loop
+	_radical_fp512_set_fq(N, op->b, *F, ctx);
+	_radical_fp512_set_fq(D, op->c, *F, ctx);
+
+	// Main loop that goes through k isogeny steps
+	for(int step=0; fmpz_cmp_ui(k, step) > 0; step++) {
+
+		//// Set N^2, N^3 and N^4 * D^2
+		fp512_sqr(N2, N, ctx);
+		fp512_mul(N3, N2, N, ctx);
+		fp512_mul(tmp1, N2, D, ctx);
+		fp512_sqr(N4D2, tmp1, ctx);
+
+		//// Extract root a of N^4 * (N - D) * D^2 = D^7 * A^4(A-1) so that alpha = a/D
+		fp512_sub(tmp1, N, D, ctx);
+		fp512_mul(tmp1, tmp1, N4D2, ctx);
+		_radical_fp512_root(a, tmp1, e, l, *F, ctx);
+
+		//// Store a^2, a^4, a^6 and N^3 * a * D
+		fp512_sqr(a2, a, ctx);
+		fp512_sqr(a4, a2, ctx);
+		fp512_mul(a6, a4, a2, ctx);
+		fp512_mul(N3aD, N3, a, ctx);
+		fp512_mul(N3aD, N3aD, D, ctx);
+
+		//// Compute num = a^6 + N*a^5 + 2N^3a^2D - N^3aD^2 + N^4D^2
+		fp512_mul(num, a4, a, ctx);
+		fp512_mul(num, num, N, ctx);
+		fp512_add(num, num, a6, ctx);
+		fp512_add(num, num, N4D2, ctx);
+		fp512_mul(tmp1, N3aD, a, ctx);
+		fp512_mul_ui(tmp1, tmp1, 2, ctx);
+		fp512_add(num, num, tmp1, ctx);
+		fp512_mul(tmp1, N3aD, D, ctx);
+		fp512_sub(num, num, tmp1, ctx);
+
+		//// Compute den = N^4D^2 - a^6 + N*a^4*D + N^3a^2D - 2N^3aD^2
+		fp512_sub(den, N4D2, a6, ctx);
+		fp512_mul(tmp1, a4, N, ctx);
+		fp512_mul(tmp1, tmp1, D, ctx);
+		fp512_add(den, den, tmp1, ctx);
+		fp512_mul(tmp1, N3aD, a, ctx);
+		fp512_add(den, den, tmp1, ctx);
+		fp512_mul(tmp1, N3aD, D, ctx);
+		fp512_mul_ui(tmp1, tmp1, 2, ctx);
+		fp512_sub(den, den, tmp1, ctx);
+
+		//// New A = num / den
+		memcpy(N, num, sizeof(fp512_t));
+		memcpy(D, den, sizeof(fp512_t));
+		OPCOUNT_STEP();
+		if(walk_yield()) break;
+	}
+	//// Set curve (here A = N/D, c = A(A-1) and b = Ac)
+	_radical_fp512_get_fq(N_i, N, *F, ctx);
+	_radical_fp512_get_fq(D_i, D, *F, ctx);
+	fq_div(N_i, N_i, D_i, *F);
+	fq_sub_ui(D_i, N_i, 1, *F);
+	fq_mul(c, D_i, N_i, *F);
+	fq_mul(b, c, N_i, *F);
+	TN_curve_set(rop, b, c, l, F);
+
+	//// Clear
+	fq_clear(N_i, *F);
+	fq_clear(D_i, *F);
+	fq_clear(b, *F);
+	fq_clear(c, *F);
+	fmpz_clear(l);
+	fmpz_clear(e);
+}
@@ -10,6 +10,10 @@
 
 #include "../EllipticCurves/models.h"
 #include "../EllipticCurves/memory.h"
+#include "../EllipticCurves/fpv.h"
+#include "../EllipticCurves/fp512.h"
+
+#include "yield.h"
 
 void fq_nth_root_trick(fq_t, fq_t, fmpz_t, const fq_ctx_t);
 void fq_nth_root_trick_ui(fq_t, fq_t, slong, const fq_ctx_t);
@@ -17,6 +21,22 @@ void fq_nth_root_trick_ui(fq_t, fq_t, slong, const fq_ctx_t);
 void radical_isogeny_3(TN_curve_t *, TN_curve_t *, fmpz_t);
 void radical_isogeny_5(TN_curve_t *, TN_curve_t *, fmpz_t);
 void radical_isogeny_7(TN_curve_t *, TN_curve_t *, fmpz_t);
+void radical_isogeny_9(TN_curve_t *, TN_curve_t *, fmpz_t);
+
+void radical_isogeny_5_proj(TN_curve_t *, TN_curve_t *, fmpz_t);
+void radical_isogeny_7_proj(TN_curve_t *, TN_curve_t *, fmpz_t);
+
+void radical_isogeny_11(TN_curve_t *, TN_curve_t *, fmpz_t);
+void radical_isogeny_13(TN_curve_t *, TN_curve_t *, fmpz_t);
+
+void fpv_nth_root_trick(fpv_t *, fpv_t *, ulong, fpv_ctx_t *);
+void radical_isogeny_3_lanes(TN_curve_t *, TN_curve_t *, fmpz_t *, uint, fpv_ctx_t *);
+void radical_isogeny_5_lanes(TN_curve_t *, TN_curve_t *, fmpz_t *, uint, fpv_ctx_t *);
+void radical_isogeny_7_lanes(TN_curve_t *, TN_curve_t *, fmpz_t *, uint, fpv_ctx_t *);
+
+void radical_isogeny_3_fp512(TN_curve_t *, TN_curve_t *, fmpz_t, const fp512_ctx_t *);
+void radical_isogeny_5_fp512(TN_curve_t *, TN_curve_t *, fmpz_t, const fp512_ctx_t *);
+void radical_isogeny_7_fp512(TN_curve_t *, TN_curve_t *, fmpz_t, const fp512_ctx_t *);
 
 #endif
 
@@ -0,0 +1,160 @@
+#ifndef _RADICAL_TABLES_H_
+#define _RADICAL_TABLES_H_
+
+/**
+  Radical isogeny formulas for l = 11 and 13 on the models of X_1(l)
+	l = 11:  y^2 + (x^2 + 1)y + x = 0,		alpha^11 = x^3 y^2 (x - 1)(y + 1)
+	l = 13:  y^2 + (x^3 + x^2 + 1)y - x^2 - x = 0,	alpha^13 = (x + 1)^4 y^3 (y + 1) / (x (xy - y - 1)^5)
+  The image point is x' = xnum / xden and y' = ynum / yden, where each polynomial is stored as
+  its terms {c, i, k, j} standing for c * x^i * y^k * alpha^j, sorted by (j, k).
+  The coefficients were obtained by interpolation against Velu's formulas and checked over several primes.
+
+  The radical 9-isogeny works on the parameter s of X_1(9), which has genus 0, with b = s^2(s - 1)(s^2 - s + 1)
+  and c = s^2(s - 1), and alpha^9 = s^4 (s - 1)(s^2 - s + 1)^3. The image is s' = snum / sden with the same
+  layout, x standing for s and k = 0. These were interpolated against two steps of radical_isogeny_3.
+*/
+
+#define _RAD_LEN(tab) ((slong) (sizeof(tab) / sizeof(*(tab))))
+
+static const slong _rad11_xnum[44][4] = {
+	{-22, 2, 1, 0}, {22, 3, 1, 0}, {-14, 2, 0, 1}, {11, 3, 0, 1}, {1, 2, 1, 1}, {-4, 3, 1, 1},
+	{7, 1, 0, 2}, {-8, 2, 0, 2}, {-7, 3, 0, 2}, {7, 1, 1, 2}, {-38, 2, 1, 2}, {23, 3, 1, 2},
+	{9, 1, 0, 3}, {2, 2, 0, 3}, {-22, 3, 0, 3}, {-8, 1, 1, 3}, {3, 2, 1, 3}, {-9, 3, 1, 3},
+	{-25, 1, 0, 4}, {29, 2, 0, 4}, {-8, 1, 1, 4}, {13, 2, 1, 4}, {14, 0, 0, 5}, {-12, 1, 0, 5},
+	{19, 2, 0, 5}, {3, 0, 1, 5}, {21, 1, 1, 5}, {-8, 2, 1, 5}, {18, 0, 0, 6}, {-8, 1, 0, 6},
+	{-12, 2, 0, 6}, {17, 0, 1, 6}, {-4, 1, 1, 6}, {-6, 0, 0, 7}, {-23, 1, 0, 7}, {-4, 2, 0, 7},
+	{-16, 0, 1, 7}, {-46, 0, 0, 8}, {12, 1, 0, 8}, {-15, 2, 0, 8}, {-15, 0, 1, 8}, {15, 0, 0, 9},
+	{-5, 2, 0, 9}, {-5, 0, 1, 9}
+};
+
+static const slong _rad11_xden[42][4] = {
+	{14, 2, 0, 0}, {-17, 3, 0, 0}, {-2, 2, 1, 0}, {-1, 3, 1, 0}, {-3, 2, 0, 1}, {10, 3, 0, 1},
+	{11, 2, 1, 1}, {-4, 3, 1, 1}, {-23, 2, 0, 2}, {7, 3, 0, 2}, {11, 1, 1, 2}, {-57, 2, 1, 2},
+	{30, 3, 1, 2}, {7, 1, 0, 3}, {26, 2, 0, 3}, {-5, 3, 0, 3}, {18, 1, 1, 3}, {19, 2, 1, 3},
+	{-12, 3, 1, 3}, {7, 0, 0, 4}, {-16, 1, 0, 4}, {7, 0, 1, 4}, {-6, 1, 1, 4}, {-3, 2, 1, 4},
+	{2, 0, 0, 5}, {-40, 1, 0, 5}, {25, 2, 0, 5}, {-20, 0, 1, 5}, {-6, 1, 1, 5}, {-20, 0, 0, 6},
+	{14, 1, 0, 6}, {-26, 2, 0, 6}, {-10, 0, 1, 6}, {8, 1, 1, 6}, {15, 0, 0, 7}, {8, 1, 0, 7},
+	{13, 2, 0, 7}, {9, 0, 1, 7}, {-6, 0, 0, 8}, {-8, 1, 0, 8}, {-17, 2, 0, 8}, {-17, 0, 1, 8}
+};
+
+static const slong _rad11_ynum[46][4] = {
+	{14, 2, 0, 0}, {-13, 3, 0, 0}, {10, 2, 1, 0}, {-9, 3, 1, 0}, {-31, 2, 0, 1}, {29, 3, 0, 1},
+	{-25, 2, 1, 1}, {23, 3, 1, 1}, {28, 1, 0, 2}, {-19, 3, 0, 2}, {43, 1, 1, 2}, {-42, 2, 1, 2},
+	{8, 3, 1, 2}, {-34, 1, 0, 3}, {6, 2, 0, 3}, {-5, 3, 0, 3}, {-67, 1, 1, 3}, {40, 2, 1, 3},
+	{-6, 3, 1, 3}, {-61, 1, 0, 4}, {73, 2, 0, 4}, {5, 1, 1, 4}, {2, 2, 1, 4}, {6, 3, 1, 4},
+	{-14, 0, 0, 5}, {41, 1, 0, 5}, {-41, 2, 0, 5}, {-29, 0, 1, 5}, {-1, 1, 1, 5}, {16, 2, 1, 5},
+	{-39, 0, 0, 6}, {20, 1, 0, 6}, {-6, 2, 0, 6}, {-36, 0, 1, 6}, {14, 1, 1, 6}, {-2, 0, 0, 7},
+	{25, 1, 0, 7}, {-11, 2, 0, 7}, {13, 0, 1, 7}, {50, 0, 0, 8}, {-12, 1, 0, 8}, {13, 2, 0, 8},
+	{13, 0, 1, 8}, {-32, 0, 0, 9}, {-12, 2, 0, 9}, {-12, 0, 1, 9}
+};
+
+static const slong _rad11_yden[48][4] = {
+	{-42, 2, 0, 0}, {41, 3, 0, 0}, {-23, 2, 1, 0}, {22, 3, 1, 0}, {23, 2, 0, 1}, {-20, 3, 0, 1},
+	{59, 2, 1, 1}, {-56, 3, 1, 1}, {14, 1, 0, 2}, {-50, 2, 0, 2}, {28, 3, 0, 2}, {-1, 1, 1, 2},
+	{-2, 2, 1, 2}, {-5, 3, 1, 2}, {25, 1, 0, 3}, {-3, 2, 0, 3}, {16, 3, 0, 3}, {54, 1, 1, 3},
+	{-40, 2, 1, 3}, {24, 3, 1, 3}, {-28, 0, 0, 4}, {88, 1, 0, 4}, {-83, 2, 0, 4}, {12, 3, 0, 4},
+	{-28, 0, 1, 4}, {41, 1, 1, 4}, {-24, 2, 1, 4}, {20, 0, 0, 5}, {-31, 1, 0, 5}, {32, 2, 0, 5},
+	{50, 0, 1, 5}, {-30, 1, 1, 5}, {36, 0, 0, 6}, {-14, 1, 0, 6}, {-19, 2, 0, 6}, {11, 0, 1, 6},
+	{-6, 1, 1, 6}, {32, 0, 0, 7}, {-11, 1, 0, 7}, {18, 2, 0, 7}, {14, 0, 1, 7}, {10, 0, 0, 8},
+	{-18, 1, 0, 8}, {16, 2, 0, 8}, {16, 0, 1, 8}, {31, 0, 0, 9}, {17, 2, 0, 9}, {17, 0, 1, 9}
+};
+
+static const slong _rad13_xnum[90][4] = {
+	{1, 1, 0, 0}, {4, 2, 0, 0}, {6, 3, 0, 0}, {4, 4, 0, 0}, {1, 5, 0, 0}, {-1, 1, 0, 1},
+	{-4, 2, 0, 1}, {-6, 3, 0, 1}, {-4, 4, 0, 1}, {-1, 5, 0, 1}, {2, 0, 1, 1}, {6, 1, 1, 1},
+	{6, 2, 1, 1}, {2, 3, 1, 1}, {1, 1, 0, 2}, {5, 2, 0, 2}, {9, 3, 0, 2}, {7, 4, 0, 2},
+	{2, 5, 0, 2}, {1, 0, 1, 2}, {3, 1, 1, 2}, {3, 2, 1, 2}, {1, 3, 1, 2}, {1, 1, 0, 3},
+	{4, 2, 0, 3}, {7, 3, 0, 3}, {6, 4, 0, 3}, {2, 5, 0, 3}, {1, 0, 1, 3}, {2, 1, 1, 3},
+	{1, 2, 1, 3}, {2, 1, 0, 4}, {6, 2, 0, 4}, {8, 3, 0, 4}, {6, 4, 0, 4}, {2, 5, 0, 4},
+	{2, 1, 1, 4}, {4, 2, 1, 4}, {2, 3, 1, 4}, {2, 1, 0, 5}, {5, 2, 0, 5}, {4, 3, 0, 5},
+	{2, 4, 0, 5}, {1, 5, 0, 5}, {2, 1, 1, 5}, {3, 2, 1, 5}, {-1, 3, 1, 5}, {-2, 4, 1, 5},
+	{1, 1, 0, 6}, {-1, 2, 0, 6}, {-5, 3, 0, 6}, {-3, 4, 0, 6}, {1, 1, 1, 6}, {-2, 2, 1, 6},
+	{-4, 3, 1, 6}, {1, 4, 1, 6}, {2, 5, 1, 6}, {3, 1, 0, 7}, {7, 2, 0, 7}, {4, 3, 0, 7},
+	{-1, 4, 0, 7}, {3, 1, 1, 7}, {4, 2, 1, 7}, {-3, 3, 1, 7}, {-2, 4, 1, 7}, {1, 5, 1, 7},
+	{2, 1, 0, 8}, {4, 2, 0, 8}, {2, 3, 0, 8}, {2, 1, 1, 8}, {2, 2, 1, 8}, {-2, 3, 1, 8},
+	{1, 0, 0, 9}, {6, 1, 0, 9}, {9, 2, 0, 9}, {3, 3, 0, 9}, {-2, 4, 0, 9}, {1, 0, 1, 9},
+	{5, 1, 1, 9}, {3, 2, 1, 9}, {-5, 3, 1, 9}, {-1, 4, 1, 9}, {2, 5, 1, 9}, {1, 0, 0, 10},
+	{3, 1, 0, 10}, {3, 2, 0, 10}, {1, 0, 1, 10}, {2, 1, 1, 10}, {-2, 3, 1, 10}, {1, 4, 1, 10}
+};
+
+static const slong _rad13_xden[80][4] = {
+	{1, 1, 0, 1}, {4, 2, 0, 1}, {6, 3, 0, 1}, {4, 4, 0, 1}, {1, 5, 0, 1}, {-2, 0, 1, 1},
+	{-6, 1, 1, 1}, {-6, 2, 1, 1}, {-2, 3, 1, 1}, {-2, 1, 0, 2}, {-7, 2, 0, 2}, {-9, 3, 0, 2},
+	{-5, 4, 0, 2}, {-1, 5, 0, 2}, {1, 0, 1, 2}, {3, 1, 1, 2}, {3, 2, 1, 2}, {1, 3, 1, 2},
+	{1, 1, 0, 3}, {4, 2, 0, 3}, {5, 3, 0, 3}, {2, 4, 0, 3}, {-1, 0, 1, 3}, {-2, 1, 1, 3},
+	{-1, 2, 1, 3}, {-1, 3, 0, 4}, {-2, 4, 0, 4}, {-1, 5, 0, 4}, {-2, 2, 1, 4}, {-4, 3, 1, 4},
+	{-2, 4, 1, 4}, {1, 2, 0, 5}, {2, 3, 0, 5}, {1, 4, 0, 5}, {1, 2, 1, 5}, {4, 3, 1, 5},
+	{3, 4, 1, 5}, {1, 0, 0, 6}, {3, 1, 0, 6}, {3, 2, 0, 6}, {1, 3, 0, 6}, {1, 0, 1, 6},
+	{2, 1, 1, 6}, {-1, 3, 1, 6}, {-3, 1, 0, 7}, {-6, 2, 0, 7}, {-2, 3, 0, 7}, {1, 4, 0, 7},
+	{-3, 1, 1, 7}, {-3, 2, 1, 7}, {4, 3, 1, 7}, {-2, 5, 1, 7}, {1, 0, 0, 8}, {3, 1, 0, 8},
+	{3, 2, 0, 8}, {-1, 3, 0, 8}, {-2, 4, 0, 8}, {1, 0, 1, 8}, {2, 1, 1, 8}, {-3, 3, 1, 8},
+	{2, 5, 1, 8}, {-2, 1, 0, 9}, {-4, 2, 0, 9}, {-2, 3, 0, 9}, {1, 4, 0, 9}, {-2, 1, 1, 9},
+	{-2, 2, 1, 9}, {2, 3, 1, 9}, {1, 4, 1, 9}, {-1, 5, 1, 9}, {-1, 0, 0, 10}, {-4, 1, 0, 10},
+	{-5, 2, 0, 10}, {-1, 3, 0, 10}, {1, 4, 0, 10}, {-1, 0, 1, 10}, {-3, 1, 1, 10}, {-1, 2, 1, 10},
+	{3, 3, 1, 10}, {-1, 5, 1, 10}
+};
+
+static const slong _rad13_ynum[117][4] = {
+	{1, 1, 0, 0}, {5, 2, 0, 0}, {8, 3, 0, 0}, {2, 4, 0, 0}, {-7, 5, 0, 0}, {-7, 6, 0, 0},
+	{-2, 7, 0, 0}, {-1, 0, 1, 0}, {-5, 1, 1, 0}, {-9, 2, 1, 0}, {-7, 3, 1, 0}, {-2, 4, 1, 0},
+	{1, 1, 0, 1}, {2, 2, 0, 1}, {-2, 3, 0, 1}, {-10, 4, 0, 1}, {-13, 5, 0, 1}, {-8, 6, 0, 1},
+	{-2, 7, 0, 1}, {-1, 0, 1, 1}, {-3, 1, 1, 1}, {-3, 2, 1, 1}, {-1, 3, 1, 1}, {2, 3, 0, 2},
+	{5, 4, 0, 2}, {3, 5, 0, 2}, {-1, 6, 0, 2}, {-1, 7, 0, 2}, {2, 1, 1, 2}, {6, 2, 1, 2},
+	{6, 3, 1, 2}, {2, 4, 1, 2}, {-1, 1, 0, 3}, {6, 3, 0, 3}, {8, 4, 0, 3}, {3, 5, 0, 3},
+	{-2, 2, 1, 3}, {-5, 3, 1, 3}, {-4, 4, 1, 3}, {-1, 5, 1, 3}, {-3, 3, 0, 4}, {-5, 4, 0, 4},
+	{-2, 5, 0, 4}, {1, 3, 1, 4}, {2, 4, 1, 4}, {1, 5, 1, 4}, {1, 1, 0, 5}, {-1, 2, 0, 5},
+	{-4, 3, 0, 5}, {-1, 4, 0, 5}, {1, 5, 0, 5}, {1, 1, 1, 5}, {-2, 2, 1, 5}, {-3, 3, 1, 5},
+	{3, 1, 0, 6}, {8, 2, 0, 6}, {9, 3, 0, 6}, {2, 4, 0, 6}, {-1, 5, 0, 6}, {3, 1, 1, 6},
+	{5, 2, 1, 6}, {1, 3, 1, 6}, {-4, 4, 1, 6}, {1, 5, 1, 6}, {1, 6, 1, 6}, {1, 1, 0, 7},
+	{5, 2, 0, 7}, {10, 3, 0, 7}, {5, 4, 0, 7}, {1, 1, 1, 7}, {4, 2, 1, 7}, {5, 3, 1, 7},
+	{-4, 4, 1, 7}, {-2, 5, 1, 7}, {2, 6, 1, 7}, {1, 0, 0, 8}, {3, 1, 0, 8}, {3, 2, 0, 8},
+	{-2, 3, 0, 8}, {-4, 4, 0, 8}, {-2, 5, 0, 8}, {2, 6, 0, 8}, {1, 0, 1, 8}, {2, 1, 1, 8},
+	{-4, 3, 1, 8}, {-1, 4, 1, 8}, {2, 5, 1, 8}, {2, 6, 1, 8}, {-2, 7, 1, 8}, {1, 0, 0, 9},
+	{4, 1, 0, 9}, {4, 2, 0, 9}, {-3, 3, 0, 9}, {-6, 4, 0, 9}, {-1, 5, 0, 9}, {2, 6, 0, 9},
+	{1, 0, 1, 9}, {3, 1, 1, 9}, {-6, 3, 1, 9}, {-1, 4, 1, 9}, {4, 5, 1, 9}, {1, 6, 1, 9},
+	{-2, 7, 1, 9}, {2, 0, 0, 10}, {6, 1, 0, 10}, {5, 2, 0, 10}, {-1, 3, 0, 10}, {1, 4, 0, 10},
+	{2, 5, 0, 10}, {-1, 6, 0, 10}, {2, 0, 1, 10}, {4, 1, 1, 10}, {-1, 2, 1, 10}, {-4, 3, 1, 10},
+	{4, 4, 1, 10}, {-2, 6, 1, 10}, {1, 7, 1, 10}
+};
+
+static const slong _rad13_yden[116][4] = {
+	{-2, 2, 0, 0}, {-4, 3, 0, 0}, {4, 4, 0, 0}, {16, 5, 0, 0}, {14, 6, 0, 0}, {4, 7, 0, 0},
+	{4, 1, 1, 0}, {12, 2, 1, 0}, {12, 3, 1, 0}, {4, 4, 1, 0}, {-2, 1, 0, 1}, {-3, 2, 0, 1},
+	{1, 3, 0, 1}, {-1, 4, 0, 1}, {-9, 5, 0, 1}, {-8, 6, 0, 1}, {-2, 7, 0, 1}, {1, 0, 1, 1},
+	{-2, 1, 1, 1}, {-12, 2, 1, 1}, {-14, 3, 1, 1}, {-5, 4, 1, 1}, {1, 2, 0, 2}, {4, 3, 0, 2},
+	{5, 4, 0, 2}, {2, 5, 0, 2}, {1, 0, 1, 2}, {-5, 2, 1, 2}, {-6, 3, 1, 2}, {-2, 4, 1, 2},
+	{-1, 1, 0, 3}, {-6, 2, 0, 3}, {-13, 3, 0, 3}, {-10, 4, 0, 3}, {2, 6, 0, 3}, {-1, 1, 1, 3},
+	{-1, 2, 1, 3}, {1, 3, 1, 3}, {1, 4, 1, 3}, {4, 1, 0, 4}, {13, 2, 0, 4}, {16, 3, 0, 4},
+	{8, 4, 0, 4}, {1, 5, 0, 4}, {4, 1, 1, 4}, {9, 2, 1, 4}, {1, 3, 1, 4}, {-9, 4, 1, 4},
+	{-5, 5, 1, 4}, {-1, 1, 0, 5}, {2, 2, 0, 5}, {7, 3, 0, 5}, {4, 4, 0, 5}, {-1, 5, 0, 5},
+	{-1, 6, 0, 5}, {-1, 1, 1, 5}, {3, 2, 1, 5}, {5, 3, 1, 5}, {-1, 5, 1, 5}, {-1, 1, 0, 6},
+	{-2, 2, 0, 6}, {-3, 3, 0, 6}, {-2, 4, 0, 6}, {-1, 5, 0, 6}, {-1, 1, 1, 6}, {-1, 2, 1, 6},
+	{-1, 3, 1, 6}, {2, 6, 1, 6}, {-3, 1, 0, 7}, {-11, 2, 0, 7}, {-16, 3, 0, 7}, {-4, 4, 0, 7},
+	{-3, 1, 1, 7}, {-8, 2, 1, 7}, {-5, 3, 1, 7}, {9, 4, 1, 7}, {-1, 5, 1, 7}, {-1, 6, 1, 7},
+	{1, 1, 0, 8}, {4, 2, 0, 8}, {5, 3, 0, 8}, {-1, 5, 0, 8}, {1, 1, 1, 8}, {3, 2, 1, 8},
+	{1, 3, 1, 8}, {-4, 4, 1, 8}, {1, 5, 1, 8}, {1, 6, 1, 8}, {-1, 0, 0, 9}, {-1, 1, 0, 9},
+	{3, 2, 0, 9}, {8, 3, 0, 9}, {4, 4, 0, 9}, {2, 5, 0, 9}, {-2, 6, 0, 9}, {-1, 0, 1, 9},
+	{4, 2, 1, 9}, {4, 3, 1, 9}, {-3, 4, 1, 9}, {-2, 6, 1, 9}, {2, 7, 1, 9}, {1, 0, 0, 10},
+	{2, 1, 0, 10}, {1, 2, 0, 10}, {-2, 3, 0, 10}, {-1, 4, 0, 10}, {-2, 5, 0, 10}, {1, 6, 0, 10},
+	{1, 0, 1, 10}, {1, 1, 1, 10}, {-1, 2, 1, 10}, {-2, 3, 1, 10}, {1, 4, 1, 10}, {-1, 5, 1, 10},
+	{2, 6, 1, 10}, {-1, 7, 1, 10}
+};
+
+static const slong _rad9_snum[50][4] = {
+	{2, 3, 0, 0}, {-4, 4, 0, 0}, {1, 5, 0, 0}, {14, 6, 0, 0}, {-35, 7, 0, 0}, {47, 8, 0, 0},
+	{-41, 9, 0, 0}, {23, 10, 0, 0}, {-8, 11, 0, 0}, {1, 12, 0, 0}, {1, 3, 0, 1}, {-5, 4, 0, 1},
+	{12, 5, 0, 1}, {-19, 6, 0, 1}, {20, 7, 0, 1}, {-15, 8, 0, 1}, {7, 9, 0, 1}, {-2, 10, 0, 1},
+	{-1, 2, 0, 2}, {6, 4, 0, 2}, {-17, 5, 0, 2}, {24, 6, 0, 2}, {-21, 7, 0, 2}, {11, 8, 0, 2},
+	{-3, 9, 0, 2}, {1, 2, 0, 3}, {-3, 4, 0, 3}, {8, 5, 0, 3}, {-9, 6, 0, 3}, {6, 7, 0, 3},
+	{-2, 8, 0, 3}, {2, 2, 0, 4}, {-5, 3, 0, 4}, {8, 4, 0, 4}, {-7, 5, 0, 4}, {4, 6, 0, 4},
+	{-1, 7, 0, 4}, {-2, 1, 0, 5}, {1, 2, 0, 5}, {-2, 4, 0, 5}, {1, 5, 0, 5}, {-3, 1, 0, 6},
+	{6, 2, 0, 6}, {-6, 3, 0, 6}, {3, 4, 0, 6}, {2, 0, 0, 7}, {2, 3, 0, 7}, {2, 0, 0, 8},
+	{-5, 1, 0, 8}, {2, 2, 0, 8}
+};
+
+static const slong _rad9_sden[9][4] = {
+	{1, 3, 0, 0}, {-9, 5, 0, 0}, {30, 6, 0, 0}, {-54, 7, 0, 0}, {63, 8, 0, 0}, {-51, 9, 0, 0},
+	{27, 10, 0, 0}, {-9, 11, 0, 0}, {1, 12, 0, 0}
+};
+
+#endif
@@ -15,7 +15,108 @@ void _init_lengths(uint* b, uint* bprime, uint* lenK, uint l) {
 }
 
 /**
-  Fills the arrays I,J,K with the multiples of P required by xISOG
+  Returns 1 if (b, b') is a valid split for xISOG in degree l and 0 otherwise.
+  I +/- J covers the odd multiples of P up to 4bb', and K the remaining ones up to l - 2,
+  so any b, b' >= 1 with 4bb' <= l - 1 is valid.
+*/
+int velu_split_valid(uint l, uint b, uint bprime) {
+
+	return (b >= 1) && (bprime >= 1) && (4 * (ulong)b * bprime <= l - 1);
+}
+
+/**
+  Same as _init_lengths, keeping the split (*b, *bprime) when it is valid, see velu_split_valid.
+  The default split is used otherwise, in particular for *b = *bprime = 0.
+*/
+void _init_lengths_(uint *b, uint *bprime, uint *lenK, uint l) {
+
+	if(!velu_split_valid(l, *b, *bprime)) _init_lengths(b, bprime, lenK, l);
+	else *lenK = (l-1-4*(*b)*(*bprime))/2;
+}
+
+/**
+  Returns the estimated cost of KPS and xISOG in degree l, in multiplications in the field of the step:
+  with the split (b, b') if m = 0, over m Frobenius orbits with representatives c^j P otherwise, see velu_orbits.
+  A norm to F_p is one resultant over F_p, counted as 2 multiplications.
+*/
+double velu_kernel_cost(uint l, uint b, uint bprime, uint m, ulong c) {
+
+	uint lenK;
+
+	if(m) return m * ((c == 2) ? 5 : 10 * log2(c)) + m * 2 * 2 + 3 * log2(l) + 20;
+
+	_init_lengths_(&b, &bprime, &lenK, l);
+	//// The three chains, E0 and E1, their multievaluation at I, the products over K and the codomain
+	return 6 * (b + bprime + lenK) + 6.0 * b * b + 4.0 * b * bprime + 4 * lenK + 3 * log2(l) + 20;
+}
+
+/**
+  Auxiliary function for velu_orbits: returns the order of x in (Z/lZ)^* / {1, -1}.
+*/
+static uint _velu_order_pm(ulong x, ulong l) {
+
+	ulong y = x % l;
+	uint o = 1;
+
+	while (y != 1 && y != l-1) {
+		y = (y * x) % l;
+		o++;
+	}
+	return o;
+}
+
+/**
+  Computes the Frobenius orbits of the kernels of the steps of degree l over F_{p^r}, on the curve (twist = 0)
+  or on its quadratic twist (twist = 1), for the curves isogenous to the base curve.
+  The p-power Frobenius acts on the kernel <P> as a root lambda of X^2 - tX + p mod l, with lambda^r = 1 on the curve
+  and lambda^r = -1 on the twist, whose points are those of E(F_{p^2r}) with pi^r P = -P, so that the x-coordinates of the kernel split into m = (l-1)/2s orbits of size s,
+  the order of lambda up to sign. The orbits are the cosets of the subgroup of order s of (Z/lZ)^* / {1, -1},
+  and c is the smallest generator of the quotient: the orbits of the c^j P for j < m are the whole kernel.
+  Returns 1 if the orbits can replace the kernel in xISOG, that is s >= 2, both roots agree on s and r/s divides 8;
+  returns 0 otherwise and leaves s, m, c unchanged.
+*/
+int velu_orbits(uint *s, uint *m, ulong *c, uint l, uint r, int twist, const fmpz_t p) {
+
+	fmpz_t t;
+	ulong t_l, p_l, target, y;
+	uint s_ = 0, m_;
+
+	fmpz_init(t);
+	MG_curve_trace(t);
+	t_l = fmpz_fdiv_ui(t, l);
+	p_l = fmpz_fdiv_ui(p, l);
+	fmpz_clear(t);
+
+	//// Eigenvalues of the Frobenius on the l-torsion with the right power
+	target = twist ? l-1 : 1;
+	for (ulong x=1; x<l; x++) {
+		if ((x * x + l * l - t_l * x + p_l) % l) continue;
+
+		y = 1;
+		for (uint i=0; i<r; i++) y = (y * x) % l;
+		if (y != target) continue;
+
+		if (s_ && s_ != _velu_order_pm(x, l)) return 0;
+		s_ = _velu_order_pm(x, l);
+	}
+
+	if (s_ < 2 || 8 % (r / s_) || r % s_) return 0;
+
+	//// Smallest c with c^j outside of the subgroup of order s for 0 < j < m
+	m_ = (l-1) / (2*s_);
+	for (*c=2; *c<l; (*c)++) {
+		y = 1;
+		for (uint i=0; i<s_; i++) y = (y * (*c)) % l;	// c^s generates the quotient iff its order up to sign is m
+		if (_velu_order_pm(y, l) == m_) break;
+	}
+
+	*s = s_;
+	*m = m_;
+	return 1;
+}
+
+/**
+  Fills the arrays I,J,K with the multiples of P required by xISOG, for any valid split (b, b'), see velu_split_valid.
 */
 void KPS(MG_point_t *I, MG_point_t *J, MG_point_t *K, MG_point_t P, uint l, uint b, uint bprime, uint lenK) {
 	// array I of length brpime
@@ -36,9 +137,7 @@ void KPS(MG_point_t *I, MG_point_t *J, MG_point_t *K, MG_point_t P, uint l, uint
 	//computing J = {(2j+1)*P for j = 1, ..., b-1}
 	MG_point_set_(&J[0], &P);
 
-	// If l>17 then bprime >= b >= 2 therefore J has at least two elements
-	// If l = 11 or 13, then b = 1, bprime >= 2
-	if(l >= 17) MG_xADD(&(J[1]), P, P2, P); //J[1] = 3*P
+	if(b >= 2) MG_xADD(&(J[1]), P, P2, P); //J[1] = 3*P
 
 	for (int j=2; j<b; j++) {
 		MG_xADD(&(J[j]), J[j-1], P2, J[j-2]);
@@ -55,7 +154,7 @@ void KPS(MG_point_t *I, MG_point_t *J, MG_point_t *K, MG_point_t P, uint l, uint
 	}
 
 	MG_xDBL(&P4b, I[0]); // P4b = 4b*P
-	MG_xADD(&I[1], P4b, I[0], I[0]); // I[1] = 6b*P = 4b*P + 2b*P
+	if(bprime >= 2) MG_xADD(&I[1], P4b, I[0], I[0]); // I[1] = 6b*P = 4b*P + 2b*P
 
 	for (int i=2; i<bprime; i++) {
 		MG_xADD(&I[i], I[i-1], P4b, I[i-2]);
@@ -124,12 +223,17 @@ void xISOG(fq_t *A2, MG_point_t P, uint l, MG_point_t I[], MG_point_t J[], MG_po
 	fq_poly_clear(c, *F);
 	*/
 
+	// normalizing J, I, K with a single inversion
+	MG_point_t *pts[b + bprime + lenK];
+	for (uint j=0; j<b; j++) pts[j] = J + j;
+	for (uint i=0; i<bprime; i++) pts[b + i] = I + i;
+	for (uint i=0; i<lenK; i++) pts[b + bprime + i] = K + i;
+	MG_point_normalize_batch(pts, b + bprime + lenK);
+
 	// computing E0, E1
 	fq_poly_one(E0, *F);
 	fq_poly_one(E1, *F);
 	for (uint j=0; j<b; j++) {
-		//// NORMALIZE
-		MG_point_normalize(J+j);
 		_F0pF1pF2_F0mF1pF2(&tmp1, &tmp2, J[j], *F);
 		fq_poly_mul(E0, E0, tmp1, *F);
 		fq_poly_mul(E1, E1, tmp2, *F);
@@ -143,8 +247,6 @@ void xISOG(fq_t *A2, MG_point_t P, uint l, MG_point_t I[], MG_point_t J[], MG_po
 	fq_t eval[bprime];
 	for (uint i=0; i<bprime; i++) {
 		fq_init(Ix[i], *F);
-		/// NORMALIZE
-		MG_point_normalize(I+i);
 		fq_set(Ix[i], I[i].X, *F);
 		//Ix[i] = I[i].X;
 		fq_init(eval[i], *F);
@@ -166,8 +268,6 @@ void xISOG(fq_t *A2, MG_point_t P, uint l, MG_point_t I[], MG_point_t J[], MG_po
 	fq_one(M0, *F);
 	fq_one(M1, *F);
 	for (uint i=0; i<lenK; i++) {
-		//// NORMALIZE
-		MG_point_normalize(K+i);
 		fq_sub_one(tmp, K[i].X, *F);
 		fq_neg(tmp, tmp, *F);
 		fq_mul(M0, M0, tmp, *F);
@@ -290,3 +390,753 @@ void isogeny_from_torsion(fq_t *A2, MG_point_t P, uint l) {
 	}
 }
 
+
+/**
+  Initializes ws for the steps of degree l with the split (b, b'), with points on the curve E.
+  The default split of _init_lengths is used if (b, b') is not valid, for instance (0, 0).
+  A corresponding call to velu_ws_clear() must be made after finishing with ws.
+*/
+void velu_ws_init(velu_ws_t *ws, uint l, uint b, uint bprime, MG_curve_t *E) {
+
+	const fq_ctx_t *F = E->F;
+
+	ws->E = E;
+	ws->l = l;
+	ws->b = b;
+	ws->bprime = bprime;
+	_init_lengths_(&ws->b, &ws->bprime, &ws->lenK, l);
+	ws->s = 1;
+	ws->m = 0;
+	ws->c = 0;
+	ws->spec = velu_spec_get(l, ws->b, ws->bprime);
+
+	ws->I = malloc(sizeof(MG_point_t) * ws->bprime);
+	ws->J = malloc(sizeof(MG_point_t) * ws->b);
+	ws->K = malloc(sizeof(MG_point_t) * ws->lenK);
+	for (uint i=0; i<ws->bprime; i++) MG_point_init(&ws->I[i], E);
+	for (uint i=0; i<ws->b; i++) MG_point_init(&ws->J[i], E);
+	for (uint i=0; i<ws->lenK; i++) MG_point_init(&ws->K[i], E);
+	MG_point_init(&ws->P2, E);
+	MG_point_init(&ws->P4, E);
+	MG_point_init(&ws->P4b, E);
+
+	ws->IX = malloc(sizeof(fq_t) * ws->bprime);
+	ws->IZ = malloc(sizeof(fq_t) * ws->bprime);
+	ws->eval[0] = malloc(sizeof(fq_t) * ws->bprime);
+	ws->eval[1] = malloc(sizeof(fq_t) * ws->bprime);
+	for (uint i=0; i<ws->bprime; i++) {
+		fq_init(ws->IX[i], *F);
+		fq_init(ws->IZ[i], *F);
+		fq_init(ws->eval[0][i], *F);
+		fq_init(ws->eval[1][i], *F);
+	}
+	fq_poly_btree_init(&ws->T, F);
+
+	for (uint t=0; t<2; t++) {
+		fq_poly_init(ws->E01[t], *F);
+		fq_poly_init(ws->tmp[t][0], *F);
+		fq_poly_init(ws->tmp[t][1], *F);
+	}
+	fq_init(ws->R0, *F);
+	fq_init(ws->R1, *F);
+	fq_init(ws->M0, *F);
+	fq_init(ws->M1, *F);
+	for (uint i=0; i<5; i++) fq_init(ws->C[i], *F);
+}
+
+/**
+  Clears ws, releasing any memory used.
+*/
+void velu_ws_clear(velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	for (uint i=0; i<ws->bprime; i++) MG_point_clear(&ws->I[i]);
+	for (uint i=0; i<ws->b; i++) MG_point_clear(&ws->J[i]);
+	for (uint i=0; i<ws->lenK; i++) MG_point_clear(&ws->K[i]);
+	MG_point_clear(&ws->P2);
+	MG_point_clear(&ws->P4);
+	MG_point_clear(&ws->P4b);
+	free(ws->I);
+	free(ws->J);
+	free(ws->K);
+
+	for (uint i=0; i<ws->bprime; i++) {
+		fq_clear(ws->IX[i], *F);
+		fq_clear(ws->IZ[i], *F);
+		fq_clear(ws->eval[0][i], *F);
+		fq_clear(ws->eval[1][i], *F);
+	}
+	free(ws->IX);
+	free(ws->IZ);
+	free(ws->eval[0]);
+	free(ws->eval[1]);
+	fq_poly_btree_clear(&ws->T);
+
+	for (uint t=0; t<2; t++) {
+		fq_poly_clear(ws->E01[t], *F);
+		fq_poly_clear(ws->tmp[t][0], *F);
+		fq_poly_clear(ws->tmp[t][1], *F);
+	}
+	fq_clear(ws->R0, *F);
+	fq_clear(ws->R1, *F);
+	fq_clear(ws->M0, *F);
+	fq_clear(ws->M1, *F);
+	for (uint i=0; i<5; i++) fq_clear(ws->C[i], *F);
+}
+
+/**
+  Sets ws to compute the steps over the Frobenius orbits of their kernel when walking on the curve (twist = 0)
+  or on its quadratic twist (twist = 1), see velu_orbits, if their estimated cost is below the one of the split of ws.
+  isogeny_from_torsion_proj then only computes one point per orbit; the arrays of ws remain in use by
+  isogeny_from_torsion_eval_proj, which needs the whole kernel.
+  Returns 1 if the orbits are used and 0 otherwise.
+*/
+int velu_ws_set_orbits(velu_ws_t *ws, int twist) {
+
+	const fq_ctx_t *F = ws->E->F;
+	uint s, m;
+	ulong c;
+
+	ws->s = 1;
+	ws->m = 0;
+	ws->c = 0;
+	if(!velu_orbits(&s, &m, &c, ws->l, fq_ctx_degree(*F), twist, fq_ctx_prime(*F))) return 0;
+	if(velu_kernel_cost(ws->l, 0, 0, m, c) >= velu_kernel_cost(ws->l, ws->b, ws->bprime, 0, 0)) return 0;
+
+	ws->s = s;
+	ws->m = m;
+	ws->c = c;
+	return 1;
+}
+
+/**
+  Auxiliary function for KPS_proj: fills the remainder tree of ws with the points of I.
+*/
+static void _velu_ws_tree(velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	for (uint i=0; i<ws->bprime; i++) {
+		fq_set(ws->IX[i], ws->I[i].X, *F);
+		fq_set(ws->IZ[i], ws->I[i].Z, *F);
+	}
+	remainderTree_proj(&ws->T, ws->IX, ws->IZ, ws->bprime, F);
+}
+
+/**
+  Auxiliary function for KPS_proj: fills J and I from P and P2 = 2*P.
+*/
+static void _KPS_proj_IJ(MG_point_t *I, MG_point_t *J, MG_point_t P, MG_point_t P2, uint l, uint b, uint bprime, const fq_t a24, const fq_t c24) {
+
+	MG_point_t P4b;
+
+	MG_point_init(&P4b, P.E);
+
+	//computing J = {(2j+1)*P for j = 1, ..., b-1}
+	MG_point_set_(&J[0], &P);
+
+	if(b >= 2) MG_xADD(&(J[1]), P, P2, P); //J[1] = 3*P
+
+	for (int j=2; j<b; j++) {
+		MG_xADD(&(J[j]), J[j-1], P2, J[j-2]);
+	}
+
+	//computing I = {2b(2i+1)*P for i = 1, ..., bprime-1}
+	if (b%2 == 0) {
+		MG_xADD(&I[0], J[b/2], J[b-(b/2) - 1], P2);
+	}
+	else {
+		MG_xDBL_proj(&I[0], J[b/2], a24, c24);
+	}
+
+	MG_xDBL_proj(&P4b, I[0], a24, c24); // P4b = 4b*P
+	if(bprime >= 2) MG_xADD(&I[1], P4b, I[0], I[0]); // I[1] = 6b*P = 4b*P + 2b*P
+
+	for (int i=2; i<bprime; i++) {
+		MG_xADD(&I[i], I[i-1], P4b, I[i-2]);
+	}
+
+	MG_point_clear(&P4b);
+}
+
+/**
+  Auxiliary function for KPS_proj: fills K from P2 = 2*P and P4 = 4*P.
+*/
+static void _KPS_proj_K(MG_point_t *K, MG_point_t P2, MG_point_t P4, uint lenK) {
+
+	//computing K = {i*P for i = 4*b*bprime+1, ..., l-4, l-2}
+	if (lenK>0) {
+		MG_point_set_(&(K[lenK-1]), &P2); // (l-2)*P = -2*P
+		if (lenK>1) {
+			MG_point_set_(&(K[lenK-2]), &P4); // (l-4)*P = -4*P
+		}
+	}
+
+	for (int i = lenK-3; i>=0; i--) {
+		MG_xADD(&K[i], K[i+1], P2, K[i+2]);
+	}
+}
+
+/**
+  Same as KPS on the curve given projectively by (a24 : c24) = (A+2C : 4C), filling the arrays of ws
+  and the remainder tree of I.
+  The coefficients of P.E are not read.
+*/
+void KPS_proj(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24); //P2 = 2*P
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24); //P4 = 4*P
+
+	_KPS_proj_IJ(ws->I, ws->J, P, ws->P2, ws->l, ws->b, ws->bprime, a24, c24);
+	_KPS_proj_K(ws->K, ws->P2, ws->P4, ws->lenK);
+	_velu_ws_tree(ws);
+}
+
+/**
+  Auxiliary function for xISOG_proj.
+  Sets R to the resultant of E0 (twist = 0) or E1 (twist = 1) with the polynomial of roots I, up to a factor
+  that does not depend on twist. Only the buffers of ws for this twist are written.
+*/
+static void _xISOG_proj_R(fq_t R, velu_ws_t *ws, const fq_t a24, const fq_t c24, int twist) {
+
+	const fq_ctx_t *F = ws->E->F;
+	fq_poly_struct *E = ws->E01[twist];
+	fq_t *eval = ws->eval[twist];
+
+	// computing E0 or E1, scaled by c24*Z^2 for each point of J
+	fq_poly_one(E, *F);
+	for (uint j=0; j<ws->b; j++) {
+		_F0pF1pF2_F0mF1pF2_proj(&ws->tmp[twist][0], &ws->tmp[twist][1], ws->J[j], a24, c24, *F);
+		fq_poly_mul(E, E, ws->tmp[twist][twist], *F);
+	}
+
+	fq_poly_multieval_proj_tree(eval, &ws->T, E, 2*ws->b, F);
+	fq_one(R, *F);
+	for (uint i=0; i<ws->bprime; i++) {
+		fq_mul(R, R, eval[i], *F);
+	}
+}
+
+/**
+  Auxiliary function for xISOG_proj: sets (M0, M1) to the products over K, up to the same factor prod Z.
+*/
+static void _xISOG_proj_M(fq_t M0, fq_t M1, MG_point_t K[], uint lenK, const fq_ctx_t *F) {
+
+	fq_t tmp;
+
+	fq_init(tmp, *F);
+
+	fq_one(M0, *F);
+	fq_one(M1, *F);
+	for (uint i=0; i<lenK; i++) {
+		fq_sub(tmp, K[i].Z, K[i].X, *F);
+		fq_mul(M0, M0, tmp, *F);
+		fq_add(tmp, K[i].X, K[i].Z, *F);
+		fq_neg(tmp, tmp, *F);
+		fq_mul(M1, M1, tmp, *F);
+	}
+
+	fq_clear(tmp, *F);
+}
+
+/**
+  Auxiliary function for xISOG_proj: overwrites (a24 : c24) with the codomain given the 8-th powers M0, M1
+  of the products of (X - Z) and (X + Z) over the kernel, up to the same factor.
+  M0 and M1 are overwritten.
+*/
+static void _xISOG_proj_codomain_pow(fq_t a24, fq_t c24, fq_t M0, fq_t M1, uint l, const fq_ctx_t *F) {
+
+	fq_t tmp;
+
+	fq_init(tmp, *F);
+
+	// computing d = (M0 : M1) = ( (a24-c24)^l * M0 : a24^l * M1 )
+	fq_sub(tmp, a24, c24, *F);
+	fq_pow_ui(tmp, tmp, l, *F);
+	fq_mul(M0, M0, tmp, *F);
+
+	fq_pow_ui(tmp, a24, l, *F);
+	fq_mul(M1, M1, tmp, *F);
+
+	// A' = 2(d+1)/(1-d) gives (A'+2C' : 4C') = (M1 : M1 - M0)
+	fq_set(a24, M1, *F);
+	fq_sub(c24, M1, M0, *F);
+
+	fq_clear(tmp, *F);
+}
+
+/**
+  Auxiliary function for xISOG_proj: overwrites (a24 : c24) with the codomain given the products R0, R1, M0, M1.
+  M0 and M1 are overwritten.
+*/
+static void _xISOG_proj_codomain(fq_t a24, fq_t c24, fq_t R0, fq_t R1, fq_t M0, fq_t M1, uint l, const fq_ctx_t *F) {
+
+	fq_mul(M0, M0, R0, *F);
+	fq_pow_ui(M0, M0, 8, *F);
+	fq_mul(M1, M1, R1, *F);
+	fq_pow_ui(M1, M1, 8, *F);
+
+	_xISOG_proj_codomain_pow(a24, c24, M0, M1, l, F);
+}
+
+/**
+  Projective version of xISOG.
+  On input (a24 : c24) = (A+2C : 4C) describes the domain curve, on output it is overwritten with the codomain.
+  ws must be filled via KPS_proj; its points need not be normalized: no inversion is performed.
+*/
+void xISOG_proj(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	// computing resultants R0, R1 up to the same factor
+	_xISOG_proj_R(ws->R0, ws, a24, c24, 0);
+	_xISOG_proj_R(ws->R1, ws, a24, c24, 1);
+
+	// computing M0, M1 up to the same factor prod Z
+	_xISOG_proj_M(ws->M0, ws->M1, ws->K, ws->lenK, ws->E->F);
+
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, ws->l, ws->E->F);
+}
+
+/**
+   Projective version of _F0pF1pF2_F0mF1pF2.
+   Both polynomials are built from (X : Z) and (a24 : c24) = (A+2C : 4C) and are scaled by the same factor c24*Z^2.
+*/
+void _F0pF1pF2_F0mF1pF2_proj(fq_poly_t *rop1, fq_poly_t *rop2, MG_point_t P, const fq_t a24, const fq_t c24, const fq_ctx_t ctx) {
+	fq_poly_zero(*rop1, ctx);
+	fq_poly_zero(*rop2, ctx);
+	fq_t tmp1, tmp2, XZ;
+	fq_init(tmp1, ctx);
+	fq_init(tmp2, ctx);
+	fq_init(XZ, ctx);
+
+	// set XZ = 8XZ
+	fq_mul(XZ, P.X, P.Z, ctx);
+	fq_mul_ui(XZ, XZ, 8, ctx);
+
+	// set tmp1 = c24(X - Z)^2
+	fq_sub(tmp1, P.X, P.Z, ctx);
+	fq_sqr(tmp1, tmp1, ctx);
+	fq_mul(tmp1, tmp1, c24, ctx);
+	fq_poly_set_coeff(*rop1, 2, tmp1, ctx);
+	fq_poly_set_coeff(*rop1, 0, tmp1, ctx);
+
+	// set tmp1 = -2(c24(X - Z)^2 + 8a24XZ)
+	fq_mul(tmp2, a24, XZ, ctx);
+	fq_add(tmp1, tmp1, tmp2, ctx);
+	fq_mul_si(tmp1, tmp1, -2, ctx);
+	fq_poly_set_coeff(*rop1, 1, tmp1, ctx);
+
+	// set tmp1 = c24(X + Z)^2
+	fq_add(tmp1, P.X, P.Z, ctx);
+	fq_sqr(tmp1, tmp1, ctx);
+	fq_mul(tmp1, tmp1, c24, ctx);
+	fq_poly_set_coeff(*rop2, 2, tmp1, ctx);
+	fq_poly_set_coeff(*rop2, 0, tmp1, ctx);
+
+	// set tmp1 = 2(c24(X + Z)^2 + 8(a24 - c24)XZ)
+	fq_sub(tmp2, a24, c24, ctx);
+	fq_mul(tmp2, tmp2, XZ, ctx);
+	fq_add(tmp1, tmp1, tmp2, ctx);
+	fq_mul_ui(tmp1, tmp1, 2, ctx);
+	fq_poly_set_coeff(*rop2, 1, tmp1, ctx);
+
+	fq_clear(tmp1, ctx);
+	fq_clear(tmp2, ctx);
+	fq_clear(XZ, ctx);
+}
+
+// Shared state of the tasks of _isogeny_from_torsion_proj_par
+typedef struct _velu_step_t {
+
+	velu_ws_t *ws;
+	MG_point_t P;
+	const fq_t *a24, *c24;
+} _velu_step_t;
+
+static void _velu_task_IJ(void *arg) {
+
+	_velu_step_t *s = arg;
+	velu_ws_t *ws = s->ws;
+	_KPS_proj_IJ(ws->I, ws->J, s->P, ws->P2, ws->l, ws->b, ws->bprime, *(s->a24), *(s->c24));
+	_velu_ws_tree(ws);
+}
+
+static void _velu_task_KM(void *arg) {
+
+	_velu_step_t *s = arg;
+	velu_ws_t *ws = s->ws;
+	_KPS_proj_K(ws->K, ws->P2, ws->P4, ws->lenK);
+	_xISOG_proj_M(ws->M0, ws->M1, ws->K, ws->lenK, ws->E->F);
+}
+
+static void _velu_task_R0(void *arg) {
+
+	_velu_step_t *s = arg;
+	_xISOG_proj_R(s->ws->R0, s->ws, *(s->a24), *(s->c24), 0);
+}
+
+static void _velu_task_R1(void *arg) {
+
+	_velu_step_t *s = arg;
+	_xISOG_proj_R(s->ws->R1, s->ws, *(s->a24), *(s->c24), 1);
+}
+
+/**
+  Auxiliary function for isogeny_from_torsion_proj: same computation, spread over the task pool.
+  The J and I chains and the remainder tree run next to the K chain and the products over K,
+  then the two resultants run side by side, each on its own buffers of ws.
+*/
+static void _isogeny_from_torsion_proj_par(fq_t a24, fq_t c24, MG_point_t P, velu_ws_t *ws) {
+
+	_velu_step_t s;
+	pool_task_t kernel[2] = {{_velu_task_IJ, &s}, {_velu_task_KM, &s}};
+	pool_task_t codomain[2] = {{_velu_task_R0, &s}, {_velu_task_R1, &s}};
+
+	s.ws = ws;
+	s.P = P;
+	s.a24 = (const fq_t *)a24;
+	s.c24 = (const fq_t *)c24;
+
+	OPCOUNT_PHASE(OPCOUNT_KERNEL);
+	MG_xDBL_proj(&ws->P2, P, a24, c24); //P2 = 2*P
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24); //P4 = 4*P
+	pool_run(kernel, 2);
+
+	OPCOUNT_PHASE(OPCOUNT_CODOMAIN);
+	pool_run(codomain, 2);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, ws->l, ws->E->F);
+}
+
+/**
+  Auxiliary function for isogeny_from_torsion_proj: same computation over the Frobenius orbits of the kernel, see velu_ws_set_orbits.
+  The orbit of c^j P contributes the norm from F_{p^s} of (X - Z) and (X + Z) to the products over the kernel.
+  Norms are taken from the whole field F_{p^r} in one resultant over F_p each: they are the norms from F_{p^s}
+  to the power e = r/s, which divides 8, so that the 8-th powers of the products are the (8/e)-th powers of their products.
+*/
+static void _isogeny_from_torsion_proj_orbits(fq_t a24, fq_t c24, MG_point_t P, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+	const fmpz *p = fq_ctx_prime(*F);
+	uint e = fq_ctx_degree(*F) / ws->s;
+	fmpz_t N0, N1, n, c;
+	fq_t tmp;
+	MG_point_t R;
+
+	fmpz_init(N0);
+	fmpz_init(N1);
+	fmpz_init(n);
+	fmpz_init_set_ui(c, ws->c);
+	fq_init(tmp, *F);
+	MG_point_init(&R, P.E);
+
+	OPCOUNT_PHASE(OPCOUNT_KERNEL);
+	MG_point_set_(&R, &P);
+	fmpz_one(N0);
+	fmpz_one(N1);
+	for (uint j=0; j<ws->m; j++) {
+		if (j > 0) {
+			if (ws->c == 2) MG_xDBL_proj(&R, R, a24, c24);
+			else MG_ladder_iter_proj_(&R, c, &R, a24, c24);
+		}
+
+		fq_sub(tmp, R.X, R.Z, *F);
+		fq_norm_itoh(n, tmp, *F);
+		fmpz_mul(N0, N0, n);
+		fmpz_mod(N0, N0, p);
+
+		fq_add(tmp, R.X, R.Z, *F);
+		fq_norm_itoh(n, tmp, *F);
+		fmpz_mul(N1, N1, n);
+		fmpz_mod(N1, N1, p);
+	}
+
+	OPCOUNT_PHASE(OPCOUNT_CODOMAIN);
+	fq_set_fmpz(ws->M0, N0, *F);
+	fq_pow_ui(ws->M0, ws->M0, 8 / e, *F);
+	fq_set_fmpz(ws->M1, N1, *F);
+	fq_pow_ui(ws->M1, ws->M1, 8 / e, *F);
+	_xISOG_proj_codomain_pow(a24, c24, ws->M0, ws->M1, ws->l, F);
+
+	fmpz_clear(N0);
+	fmpz_clear(N1);
+	fmpz_clear(n);
+	fmpz_clear(c);
+	fq_clear(tmp, *F);
+	MG_point_clear(&R);
+}
+
+/**
+  Auxiliary function for the specialised xISOG: sets IX[i] = X^2 + Z^2 and IZ[i] = XZ for the point i of I,
+  so that a quadratic c(x^2 + 1) + ux is c IX[i] + u IZ[i] at (X : Z), up to Z^2.
+*/
+static void _velu_spec_I(velu_ws_t *ws, uint i) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_sqr(ws->IX[i], ws->I[i].X, *F);
+	fq_sqr(ws->C[4], ws->I[i].Z, *F);
+	fq_add(ws->IX[i], ws->IX[i], ws->C[4], *F);
+	fq_mul(ws->IZ[i], ws->I[i].X, ws->I[i].Z, *F);
+}
+
+/**
+  Auxiliary function for the specialised xISOG: sets C[0..3] to the coefficients (c, u) of the quadratics
+  c(x^2 + 1) + ux of the point j of J for E0 and E1, see _F0pF1pF2_F0mF1pF2_proj.
+*/
+static void _velu_spec_J(velu_ws_t *ws, uint j, const fq_t a24, const fq_t c24) {
+
+	const fq_ctx_t *F = ws->E->F;
+	fq_t *C = ws->C;
+
+	// C[4] = 8XZ
+	fq_mul(C[4], ws->J[j].X, ws->J[j].Z, *F);
+	fq_mul_ui(C[4], C[4], 8, *F);
+
+	// E0: c24(X - Z)^2 and -2(c24(X - Z)^2 + 8a24XZ)
+	fq_sub(C[0], ws->J[j].X, ws->J[j].Z, *F);
+	fq_sqr(C[0], C[0], *F);
+	fq_mul(C[0], C[0], c24, *F);
+	fq_mul(C[1], a24, C[4], *F);
+	fq_add(C[1], C[1], C[0], *F);
+	fq_mul_si(C[1], C[1], -2, *F);
+
+	// E1: c24(X + Z)^2 and 2(c24(X + Z)^2 + 8(a24 - c24)XZ)
+	fq_add(C[2], ws->J[j].X, ws->J[j].Z, *F);
+	fq_sqr(C[2], C[2], *F);
+	fq_mul(C[2], C[2], c24, *F);
+	fq_sub(C[3], a24, c24, *F);
+	fq_mul(C[3], C[3], C[4], *F);
+	fq_add(C[3], C[3], C[2], *F);
+	fq_mul_ui(C[3], C[3], 2, *F);
+}
+
+/**
+  Auxiliary function for the specialised xISOG: multiplies R0 and R1 by the quadratics of C at the point i of I.
+  Over I x J, the products are the resultants of xISOG_proj up to a factor that does not depend on the twist.
+*/
+static void _velu_spec_R(velu_ws_t *ws, uint i) {
+
+	const fq_ctx_t *F = ws->E->F;
+	fq_t *C = ws->C;
+
+	fq_mul(C[4], C[0], ws->IX[i], *F);
+	fq_mul(ws->eval[0][i], C[1], ws->IZ[i], *F);
+	fq_add(C[4], C[4], ws->eval[0][i], *F);
+	fq_mul(ws->R0, ws->R0, C[4], *F);
+
+	fq_mul(C[4], C[2], ws->IX[i], *F);
+	fq_mul(ws->eval[1][i], C[3], ws->IZ[i], *F);
+	fq_add(C[4], C[4], ws->eval[1][i], *F);
+	fq_mul(ws->R1, ws->R1, C[4], *F);
+}
+
+/**
+  Auxiliary function for the specialised xISOG: multiplies M0 and M1 by the factors of the point i of K, see _xISOG_proj_M.
+*/
+static void _velu_spec_K(velu_ws_t *ws, uint i) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_sub(ws->C[4], ws->K[i].Z, ws->K[i].X, *F);
+	fq_mul(ws->M0, ws->M0, ws->C[4], *F);
+	fq_add(ws->C[4], ws->K[i].X, ws->K[i].Z, *F);
+	fq_neg(ws->C[4], ws->C[4], *F);
+	fq_mul(ws->M1, ws->M1, ws->C[4], *F);
+}
+
+#include "velu_spec.h"
+
+/**
+  Returns the specialised KPS and xISOG of degree l for the split (b, b'), or NULL if l has none or
+  if the split is not its default one, see velu_spec.h. Looked up once per walk by velu_ws_init.
+*/
+const velu_spec_t *velu_spec_get(uint l, uint b, uint bprime) {
+
+	const velu_spec_t *spec;
+
+	if (l > VELU_SPEC_MAX_L || _velu_spec_index[l] == 0) return NULL;
+
+	spec = _velu_specs + _velu_spec_index[l] - 1;
+	if (spec->b != b || spec->bprime != bprime) return NULL;
+	return spec;
+}
+
+/**
+  Projective version of isogeny_from_torsion, for the degree of ws.
+  (a24 : c24) = (A+2C : 4C) describes the domain curve on input and the codomain on output.
+  When ws is set to the Frobenius orbits of the kernel, see velu_ws_set_orbits, only one point per orbit is computed.
+  Otherwise the specialised KPS and xISOG of ws are used if there are, see velu_spec_get, and for l >= POOL_MIN_L
+  the step is spread over the task pool when it has several threads, see pool_init.
+  The remainder tree of ws is not filled by the specialised steps.
+*/
+void isogeny_from_torsion_proj(fq_t a24, fq_t c24, MG_point_t P, velu_ws_t *ws) {
+
+	if(ws->m) _isogeny_from_torsion_proj_orbits(a24, c24, P, ws);
+	else if(ws->spec) {
+		OPCOUNT_PHASE(OPCOUNT_KERNEL);
+		ws->spec->kps(ws, P, a24, c24);
+
+		OPCOUNT_PHASE(OPCOUNT_CODOMAIN);
+		ws->spec->xisog(a24, c24, ws);
+	}
+	else if(pool_enabled(ws->l)) _isogeny_from_torsion_proj_par(a24, c24, P, ws);
+	else {
+		OPCOUNT_PHASE(OPCOUNT_KERNEL);
+		KPS_proj(ws, P, a24, c24);
+
+		OPCOUNT_PHASE(OPCOUNT_CODOMAIN);
+		xISOG_proj(a24, c24, ws);
+	}
+}
+
+/**
+  Sets rop to Xq^2 F0(X, x) + XqZq F1(X, x) + Zq^2 F2(X, x) where x = x(P) and Q = (Xq : Zq),
+  on the curve given projectively by (a24 : c24) = (A+2C : 4C).
+  The polynomial is scaled by c24*Z^2, where Z is the coordinate of P.
+  Swapping Xq and Zq reverses its coefficients.
+*/
+void _F0F1F2_eval_proj(fq_poly_t *rop, MG_point_t P, MG_point_t Q, const fq_t a24, const fq_t c24, const fq_ctx_t ctx) {
+
+	fq_t tmp1, tmp2, XZ;
+	fq_init(tmp1, ctx);
+	fq_init(tmp2, ctx);
+	fq_init(XZ, ctx);
+	fq_poly_zero(*rop, ctx);
+
+	// set X^2 coefficient to c24(XqZ - ZqX)^2
+	fq_mul(tmp1, Q.X, P.Z, ctx);
+	fq_mul(tmp2, Q.Z, P.X, ctx);
+	fq_sub(tmp1, tmp1, tmp2, ctx);
+	fq_sqr(tmp1, tmp1, ctx);
+	fq_mul(tmp1, tmp1, c24, ctx);
+	fq_poly_set_coeff(*rop, 2, tmp1, ctx);
+
+	// set constant coefficient to c24(XqX - ZqZ)^2
+	fq_mul(tmp1, Q.X, P.X, ctx);
+	fq_mul(tmp2, Q.Z, P.Z, ctx);
+	fq_sub(tmp1, tmp1, tmp2, ctx);
+	fq_sqr(tmp1, tmp1, ctx);
+	fq_mul(tmp1, tmp1, c24, ctx);
+	fq_poly_set_coeff(*rop, 0, tmp1, ctx);
+
+	// set tmp1 = XqZq(c24(X^2 + Z^2) + (8a24 - 4c24)XZ)
+	fq_mul(XZ, P.X, P.Z, ctx);
+	fq_mul_ui(tmp1, a24, 8, ctx);
+	fq_mul_ui(tmp2, c24, 4, ctx);
+	fq_sub(tmp1, tmp1, tmp2, ctx);
+	fq_mul(tmp1, tmp1, XZ, ctx);
+	fq_sqr(tmp2, P.X, ctx);
+	fq_mul(tmp2, tmp2, c24, ctx);
+	fq_add(tmp1, tmp1, tmp2, ctx);
+	fq_sqr(tmp2, P.Z, ctx);
+	fq_mul(tmp2, tmp2, c24, ctx);
+	fq_add(tmp1, tmp1, tmp2, ctx);
+	fq_mul(tmp2, Q.X, Q.Z, ctx);
+	fq_mul(tmp1, tmp1, tmp2, ctx);
+
+	// set X coefficient to -2(c24XZ(Xq^2 + Zq^2) + tmp1)
+	fq_mul(XZ, XZ, c24, ctx);
+	fq_sqr(tmp2, Q.X, ctx);
+	fq_mul(XZ, XZ, tmp2, ctx);
+	fq_add(tmp1, tmp1, XZ, ctx);
+	fq_mul(XZ, P.X, P.Z, ctx);
+	fq_mul(XZ, XZ, c24, ctx);
+	fq_sqr(tmp2, Q.Z, ctx);
+	fq_mul(XZ, XZ, tmp2, ctx);
+	fq_add(tmp1, tmp1, XZ, ctx);
+	fq_mul_si(tmp1, tmp1, -2, ctx);
+	fq_poly_set_coeff(*rop, 1, tmp1, ctx);
+
+	fq_clear(tmp1, ctx);
+	fq_clear(tmp2, ctx);
+	fq_clear(XZ, ctx);
+}
+
+/**
+  Projective point evaluation, the counterpart of xISOG_proj.
+  Sets Q to its image under the isogeny of kernel <P>, using
+	phi(x) = x * h(1/x)^2 / h(x)^2,	h(x) = prod (x - x(sP)) over s in (I +/- J) u K
+  With x = Xq/Zq, the products computed from I, J and K are h(x) and h(1/x) scaled by Zq^((l-1)/2)
+  and Xq^((l-1)/2) times the same factor, so that phi(Q) = (Xq * H1^2 : Zq * H0^2).
+  ws must be filled via KPS_proj on the curve (a24 : c24). No inversion is performed.
+*/
+void xEVAL_proj(MG_point_t *Q, velu_ws_t *ws, const fq_t a24, const fq_t c24) {
+
+	const fq_ctx_t *F = ws->E->F;
+	fq_t R0, R1, M0, M1, tmp, tmp2;
+
+	fq_init(R0, *F);
+	fq_init(R1, *F);
+	fq_init(M0, *F);
+	fq_init(M1, *F);
+	fq_init(tmp, *F);
+	fq_init(tmp2, *F);
+
+	// computing E0, the polynomial for x, and E1 for 1/x which is its reverse
+	fq_poly_one(ws->E01[0], *F);
+	for (uint j=0; j<ws->b; j++) {
+		_F0F1F2_eval_proj(&ws->tmp[0][0], ws->J[j], *Q, a24, c24, *F);
+		fq_poly_mul(ws->E01[0], ws->E01[0], ws->tmp[0][0], *F);
+	}
+	fq_poly_reverse(ws->E01[1], ws->E01[0], 2*ws->b + 1, *F);
+
+	// computing resultants R0, R1 up to the same factor
+	fq_one(R0, *F);
+	fq_one(R1, *F);
+
+	fq_poly_multieval_proj_tree(ws->eval[0], &ws->T, ws->E01[0], 2*ws->b, F);
+	fq_poly_multieval_proj_tree(ws->eval[1], &ws->T, ws->E01[1], 2*ws->b, F);
+	for (uint i=0; i<ws->bprime; i++) {
+		fq_mul(R0, R0, ws->eval[0][i], *F);
+		fq_mul(R1, R1, ws->eval[1][i], *F);
+	}
+
+	// computing M0 = prod (XqZ - ZqX) and M1 = prod (ZqZ - XqX) over K
+	fq_one(M0, *F);
+	fq_one(M1, *F);
+	for (uint i=0; i<ws->lenK; i++) {
+		fq_mul(tmp, Q->X, ws->K[i].Z, *F);
+		fq_mul(tmp2, Q->Z, ws->K[i].X, *F);
+		fq_sub(tmp, tmp, tmp2, *F);
+		fq_mul(M0, M0, tmp, *F);
+		fq_mul(tmp, Q->Z, ws->K[i].Z, *F);
+		fq_mul(tmp2, Q->X, ws->K[i].X, *F);
+		fq_sub(tmp, tmp, tmp2, *F);
+		fq_mul(M1, M1, tmp, *F);
+	}
+
+	// phi(Q) = (Xq * (M1*R1)^2 : Zq * (M0*R0)^2)
+	fq_mul(M0, M0, R0, *F);
+	fq_sqr(M0, M0, *F);
+	fq_mul(Q->Z, Q->Z, M0, *F);
+
+	fq_mul(M1, M1, R1, *F);
+	fq_sqr(M1, M1, *F);
+	fq_mul(Q->X, Q->X, M1, *F);
+
+	// Memory clear
+	fq_clear(R0, *F);
+	fq_clear(R1, *F);
+	fq_clear(M0, *F);
+	fq_clear(M1, *F);
+	fq_clear(tmp, *F);
+	fq_clear(tmp2, *F);
+}
+
+/**
+  Same as isogeny_from_torsion_proj, also pushing the n points of Q through the isogeny.
+  The points of Q are evaluated on the domain curve before (a24 : c24) is overwritten with the codomain.
+*/
+void isogeny_from_torsion_eval_proj(fq_t a24, fq_t c24, MG_point_t P, velu_ws_t *ws, MG_point_t *Q, uint n) {
+
+	OPCOUNT_PHASE(OPCOUNT_KERNEL);
+	KPS_proj(ws, P, a24, c24);
+
+	OPCOUNT_PHASE(OPCOUNT_EVALUATION);
+	for (uint i=0; i<n; i++) {
+		xEVAL_proj(&Q[i], ws, a24, c24);
+	}
+
+	OPCOUNT_PHASE(OPCOUNT_CODOMAIN);
+	xISOG_proj(a24, c24, ws);
+}
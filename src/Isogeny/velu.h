@@ -1,12 +1,19 @@
 #ifndef _VELU_H_
 #define _VELU_H_
 
+#include <math.h>
+
 #include "../EllipticCurves/models.h"
 #include "../EllipticCurves/memory.h"
 #include "../EllipticCurves/arithmetic.h"
+#include "../EllipticCurves/pool.h"
 #include "../Polynomials/multieval.h"
 
 void _init_lengths(uint *, uint *, uint *, uint);
+int velu_split_valid(uint, uint, uint);
+void _init_lengths_(uint *, uint *, uint *, uint);
+double velu_kernel_cost(uint, uint, uint, uint, ulong);
+int velu_orbits(uint *, uint *, ulong *, uint, uint, int, const fmpz_t);
 void _F0pF1pF2_F0mF1pF2(fq_poly_t *, fq_poly_t *, MG_point_t, const fq_ctx_t);
 
 void KPS(MG_point_t *, MG_point_t *, MG_point_t *, MG_point_t, uint, uint, uint, uint);
@@ -14,5 +21,55 @@ void xISOG(fq_t *, MG_point_t, uint, MG_point_t *, MG_point_t *, MG_point_t *, u
 
 void isogeny_from_torsion(fq_t *, MG_point_t, uint);
 
+/*********************************************
+ Workspace of the projective Velu steps
+ Everything a step of degree l needs besides its kernel point, allocated once
+ and reused by all the steps of a walk.
+*********************************************/
+typedef struct velu_ws_t {
+
+	MG_curve_t *E;			// curve of the points, only its field is read
+	uint l, b, bprime, lenK;	// degree and lengths of the KPS arrays, see _init_lengths_
+	MG_point_t *I, *J, *K;		// KPS arrays
+	MG_point_t P2, P4, P4b;
+	fq_t *IX, *IZ;			// coordinates of I, the roots of T
+	fq_poly_btree_t T;		// remainder tree of I, shared by all the evaluations of a step
+	fq_t *eval[2];			// evaluations at I, one array per resultant
+	fq_poly_t E01[2], tmp[2][2];	// E0 and E1 and the buffers for their factors
+	fq_t R0, R1, M0, M1;
+	uint s, m;			// Frobenius orbits of the kernel: m orbits of size s, see velu_ws_set_orbits
+	ulong c;			// c^j P for j < m are the representatives of the orbits
+	const struct velu_spec_t *spec;	// specialised KPS and xISOG for l and the split, NULL if none, see velu_spec_get
+	fq_t C[5];			// quadratics of a point of J and a temporary, for the specialised xISOG
+} velu_ws_t;
+
+/*********************************************
+ Specialised steps of the small Velu primes
+ For the configured primes with few products in I x J, velu_spec.h holds KPS and xISOG written out for
+ their default split, generated by optimization/velu_spec.py: the chains have their lengths and branches
+ resolved, and the resultants are direct products over I x J instead of polynomial products and a remainder tree.
+*********************************************/
+typedef struct velu_spec_t {
+
+	uint l, b, bprime, lenK;
+	void (*kps)(velu_ws_t *, MG_point_t, const fq_t, const fq_t);	// KPS_proj without the remainder tree
+	void (*xisog)(fq_t, fq_t, velu_ws_t *);				// xISOG_proj
+} velu_spec_t;
+
+const velu_spec_t *velu_spec_get(uint, uint, uint);
+
+void velu_ws_init(velu_ws_t *, uint, uint, uint, MG_curve_t *);
+void velu_ws_clear(velu_ws_t *);
+int velu_ws_set_orbits(velu_ws_t *, int);
+
+void _F0pF1pF2_F0mF1pF2_proj(fq_poly_t *, fq_poly_t *, MG_point_t, const fq_t, const fq_t, const fq_ctx_t);
+void KPS_proj(velu_ws_t *, MG_point_t, const fq_t, const fq_t);
+void xISOG_proj(fq_t, fq_t, velu_ws_t *);
+void isogeny_from_torsion_proj(fq_t, fq_t, MG_point_t, velu_ws_t *);
+
+void _F0F1F2_eval_proj(fq_poly_t *, MG_point_t, MG_point_t, const fq_t, const fq_t, const fq_ctx_t);
+void xEVAL_proj(MG_point_t *, velu_ws_t *, const fq_t, const fq_t);
+void isogeny_from_torsion_eval_proj(fq_t, fq_t, MG_point_t, velu_ws_t *, MG_point_t *, uint);
+
 #endif
 
@@ -0,0 +1,407 @@
+#ifndef _VELU_SPEC_H_
+#define _VELU_SPEC_H_
+
+/**
+  KPS and xISOG specialised to the default split of the small Velu primes of setup.c, see velu_spec_get.
+  Generated by optimization/velu_spec.py, do not edit. Only included by velu.c.
+*/
+
+#define VELU_SPEC_MAX_L 103
+
+/* l = 17: b = 2, b' = 2, lenK = 0 */
+static void _KPS_spec_17(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&I[0], J[1], J[0], ws->P2);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+}
+
+static void _xISOG_spec_17(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 17, F);
+}
+
+/* l = 19: b = 2, b' = 2, lenK = 1 */
+static void _KPS_spec_19(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J, *K = ws->K;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&I[0], J[1], J[0], ws->P2);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_point_set_(&K[0], &ws->P2);
+}
+
+static void _xISOG_spec_19(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_velu_spec_K(ws, 0);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 19, F);
+}
+
+/* l = 29: b = 2, b' = 3, lenK = 2 */
+static void _KPS_spec_29(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J, *K = ws->K;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&I[0], J[1], J[0], ws->P2);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+	MG_point_set_(&K[1], &ws->P2);
+	MG_point_set_(&K[0], &ws->P4);
+}
+
+static void _xISOG_spec_29(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_velu_spec_K(ws, 0);
+	_velu_spec_K(ws, 1);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 29, F);
+}
+
+/* l = 31: b = 2, b' = 3, lenK = 3 */
+static void _KPS_spec_31(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J, *K = ws->K;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&I[0], J[1], J[0], ws->P2);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+	MG_point_set_(&K[2], &ws->P2);
+	MG_point_set_(&K[1], &ws->P4);
+	MG_xADD(&K[0], K[1], ws->P2, K[2]);
+}
+
+static void _xISOG_spec_31(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_velu_spec_K(ws, 0);
+	_velu_spec_K(ws, 1);
+	_velu_spec_K(ws, 2);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 31, F);
+}
+
+/* l = 37: b = 3, b' = 3, lenK = 0 */
+static void _KPS_spec_37(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&J[2], J[1], ws->P2, J[0]);
+	MG_xDBL_proj(&I[0], J[1], a24, c24);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+}
+
+static void _xISOG_spec_37(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_J(ws, 2, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 37, F);
+}
+
+/* l = 61: b = 3, b' = 5, lenK = 0 */
+static void _KPS_spec_61(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&J[2], J[1], ws->P2, J[0]);
+	MG_xDBL_proj(&I[0], J[1], a24, c24);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+	MG_xADD(&I[3], I[2], ws->P4b, I[1]);
+	MG_xADD(&I[4], I[3], ws->P4b, I[2]);
+}
+
+static void _xISOG_spec_61(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_I(ws, 3);
+	_velu_spec_I(ws, 4);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 2, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 61, F);
+}
+
+/* l = 71: b = 4, b' = 4, lenK = 3 */
+static void _KPS_spec_71(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J, *K = ws->K;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&J[2], J[1], ws->P2, J[0]);
+	MG_xADD(&J[3], J[2], ws->P2, J[1]);
+	MG_xADD(&I[0], J[2], J[1], ws->P2);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+	MG_xADD(&I[3], I[2], ws->P4b, I[1]);
+	MG_point_set_(&K[2], &ws->P2);
+	MG_point_set_(&K[1], &ws->P4);
+	MG_xADD(&K[0], K[1], ws->P2, K[2]);
+}
+
+static void _xISOG_spec_71(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_I(ws, 3);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_J(ws, 2, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_J(ws, 3, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_velu_spec_K(ws, 0);
+	_velu_spec_K(ws, 1);
+	_velu_spec_K(ws, 2);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 71, F);
+}
+
+/* l = 103: b = 5, b' = 5, lenK = 1 */
+static void _KPS_spec_103(velu_ws_t *ws, MG_point_t P, const fq_t a24, const fq_t c24) {
+
+	MG_point_t *I = ws->I, *J = ws->J, *K = ws->K;
+
+	MG_xDBL_proj(&ws->P2, P, a24, c24);
+	MG_xDBL_proj(&ws->P4, ws->P2, a24, c24);
+	MG_point_set_(&J[0], &P);
+	MG_xADD(&J[1], P, ws->P2, P);
+	MG_xADD(&J[2], J[1], ws->P2, J[0]);
+	MG_xADD(&J[3], J[2], ws->P2, J[1]);
+	MG_xADD(&J[4], J[3], ws->P2, J[2]);
+	MG_xDBL_proj(&I[0], J[2], a24, c24);
+	MG_xDBL_proj(&ws->P4b, I[0], a24, c24);
+	MG_xADD(&I[1], ws->P4b, I[0], I[0]);
+	MG_xADD(&I[2], I[1], ws->P4b, I[0]);
+	MG_xADD(&I[3], I[2], ws->P4b, I[1]);
+	MG_xADD(&I[4], I[3], ws->P4b, I[2]);
+	MG_point_set_(&K[0], &ws->P2);
+}
+
+static void _xISOG_spec_103(fq_t a24, fq_t c24, velu_ws_t *ws) {
+
+	const fq_ctx_t *F = ws->E->F;
+
+	fq_one(ws->R0, *F);
+	fq_one(ws->R1, *F);
+	_velu_spec_I(ws, 0);
+	_velu_spec_I(ws, 1);
+	_velu_spec_I(ws, 2);
+	_velu_spec_I(ws, 3);
+	_velu_spec_I(ws, 4);
+	_velu_spec_J(ws, 0, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 1, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 2, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 3, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	_velu_spec_J(ws, 4, a24, c24);
+	_velu_spec_R(ws, 0);
+	_velu_spec_R(ws, 1);
+	_velu_spec_R(ws, 2);
+	_velu_spec_R(ws, 3);
+	_velu_spec_R(ws, 4);
+	fq_one(ws->M0, *F);
+	fq_one(ws->M1, *F);
+	_velu_spec_K(ws, 0);
+	_xISOG_proj_codomain(a24, c24, ws->R0, ws->R1, ws->M0, ws->M1, 103, F);
+}
+
+static const velu_spec_t _velu_specs[] = {
+	{17, 2, 2, 0, _KPS_spec_17, _xISOG_spec_17},
+	{19, 2, 2, 1, _KPS_spec_19, _xISOG_spec_19},
+	{29, 2, 3, 2, _KPS_spec_29, _xISOG_spec_29},
+	{31, 2, 3, 3, _KPS_spec_31, _xISOG_spec_31},
+	{37, 3, 3, 0, _KPS_spec_37, _xISOG_spec_37},
+	{61, 3, 5, 0, _KPS_spec_61, _xISOG_spec_61},
+	{71, 4, 4, 3, _KPS_spec_71, _xISOG_spec_71},
+	{103, 5, 5, 1, _KPS_spec_103, _xISOG_spec_103}
+};
+
+// Index of the specialisation of l in _velu_specs plus one, 0 if there is none
+static const uint _velu_spec_index[VELU_SPEC_MAX_L + 1] = {
+	[17] = 1,
+	[19] = 2,
+	[29] = 3,
+	[31] = 4,
+	[37] = 5,
+	[61] = 6,
+	[71] = 7,
+	[103] = 8
+};
+
+#endif
@@ -2,34 +2,22 @@
 #include "walk.h"
 
 /**
-  Take k steps in the l-isogeny graph using radical isogeny.
-	MG_get_TN should return an int error code.
-	radical_isogeny should return an int error code.
+  Auxiliary function for the radical walks: sets rop to op in Tate normal form,
+  with a point of order l on op (k >= 0) or on its twist (k < 0) so that the walk goes in the direction of k.
+  Returns 1 if successful and 0 if no point of order l was found.
 **/
-int walk_rad(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
-
-	int ec = 1;
-
-	// Nothing to do
-	if(fmpz_equal_ui(k, 0)) {
-		MG_curve_set_(rop, op);
-		return ec;
-	}
+static int _walk_rad_to_TN(TN_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 
-	//// Init variables
-	fmpz_t k_local;
+	int ec;
 	MG_point_t P;
-	TN_curve_t E_TN_tmp1, E_TN_tmp2;
 	fmpz_t card, r;
 
 	fmpz_init(card);
-	fmpz_init_set(k_local, k);
-	MG_point_init(&P, op);
-	TN_curve_init(&E_TN_tmp1, l, op->F);
-	TN_curve_init(&E_TN_tmp2, l, op->F);
 	fmpz_init(r);
+	MG_point_init(&P, op);
 
 	//// Direction of the walk
+	OPCOUNT_PHASE(OPCOUNT_SAMPLING);
 	if(fmpz_cmp_ui(k, 0) >= 0) {
 		// case k>0
 		fmpz_set_ui(r, 1);
@@ -39,29 +27,291 @@ int walk_rad(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 	else {
 		// case k<0
 		fmpz_set_ui(r, 2);
-		fmpz_neg(k_local, k_local);
 		MG_curve_card_ext(card, op, r);
 		ec = MG_curve_rand_torsion_(&P, l, card);
 	}
 
 	//// Transform op in Tate-normal form
-	MG_get_TN(&E_TN_tmp1, op, &P, l);
+	OPCOUNT_PHASE(OPCOUNT_CONVERSION);
+	if(ec) MG_get_TN(rop, op, &P, l);
+
+	//// Clear
+	MG_point_clear(&P);
+	fmpz_clear(r);
+	fmpz_clear(card);
+
+	return ec;
+}
+
+/**
+  Same as _walk_rad_to_TN, except for the forward walks of degree 3 which get a point of order 9 on op,
+  so that walk_rad_from can go two steps at a time with radical_isogeny_9. The twist has none, see radical_isogeny_3,
+  and a point of order 3 is used if op has none either.
+  Returns 1 if successful and 0 if no point of order l was found.
+**/
+static int _walk_rad_start(TN_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
+
+	int ec = 0;
+	MG_point_t P;
+	fmpz_t card, r;
+
+	if(fmpz_equal_ui(l, 3) && fmpz_sgn(k) > 0) {
+
+		fmpz_init(card);
+		fmpz_init_set_ui(r, 1);
+		MG_point_init(&P, op);
+
+		OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+		MG_curve_card_ext(card, op, r);
+		ec = MG_curve_rand_torsion_sq(&P, l, card);
+
+		//// Tate normal form of order 9
+		OPCOUNT_PHASE(OPCOUNT_CONVERSION);
+		fmpz_set_ui(r, 9);
+		if(ec) MG_get_TN(rop, op, &P, r);
+
+		MG_point_clear(&P);
+		fmpz_clear(r);
+		fmpz_clear(card);
+	}
+
+	if(!ec) ec = _walk_rad_to_TN(rop, op, l, k);
+
+	return ec;
+}
+
+/**
+  Sets rop to op in Tate normal form with a point of order l on op (twist = 0) or on its twist (twist = 1),
+  as the first step of walk_rad in that direction, so that it can be precomputed for a fixed op, see walk_rad_from.
+  For l = 3 on op the point has order 9, see _walk_rad_start.
+  Returns 1 if successful and 0 if no point of order l was found.
+**/
+int walk_rad_start(TN_curve_t *rop, MG_curve_t *op, fmpz_t l, int twist) {
+
+	int ec;
+	fmpz_t k;
+
+	fmpz_init(k);
+	fmpz_set_si(k, twist ? -1 : 1);
+	ec = _walk_rad_start(rop, op, l, k);
+	fmpz_clear(k);
+
+	return ec;
+}
+
+/**
+  Take k steps in the l-isogeny graph using radical isogeny.
+	MG_get_TN should return an int error code.
+	radical_isogeny should return an int error code.
+**/
+int walk_rad(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 
-	//// Walk
-	if(fmpz_equal_ui(l, 3)) radical_isogeny_3(&E_TN_tmp2, &E_TN_tmp1, k_local);
-	else if(fmpz_equal_ui(l, 5)) radical_isogeny_5(&E_TN_tmp2, &E_TN_tmp1, k_local);
-	else if(fmpz_equal_ui(l, 7)) radical_isogeny_7(&E_TN_tmp2, &E_TN_tmp1, k_local);
-	else return 0;
+	return walk_rad_from(rop, op, l, k, NULL);
+}
+
+/**
+  Same as walk_rad, starting from the Tate normal form start of op given by walk_rad_start in the direction of k
+  instead of sampling one if start is not NULL.
+  The walks of degree 3, 5 and 7 over a prime field registered with fp512 run in Montgomery form when its kernel is fast.
+  The forward walks of degree 3 take k/2 double steps with radical_isogeny_9 from a point of order 9, see _walk_rad_start,
+  and only their odd step, if any, with radical_isogeny_3.
+**/
+int walk_rad_from(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k, TN_curve_t *start) {
+
+	int ec = 1;
+
+	// Nothing to do
+	if(fmpz_equal_ui(k, 0)) {
+		MG_curve_set_(rop, op);
+		return ec;
+	}
+
+	//// Init variables
+	fmpz_t k_local, k_half;
+	TN_curve_t E_TN_tmp1, E_TN_tmp2;
+
+	// Montgomery form over F_p when the fp512 kernel is faster than FLINT, see radical_isogeny_3_fp512
+	const fp512_ctx_t *ctx = NULL;
+	if(fq_ctx_degree(*(op->F)) == 1 && fp512_kernel()->fast) ctx = fp512_get(fq_ctx_prime(*(op->F)));
+
+	fmpz_init(k_local);
+	fmpz_init(k_half);
+	fmpz_abs(k_local, k);
+	TN_curve_init(&E_TN_tmp1, l, op->F);
+	TN_curve_init(&E_TN_tmp2, l, op->F);
+
+	OPCOUNT_WALK(fmpz_get_ui(l), fmpz_sgn(k), fq_ctx_degree(*(op->F)));
+	if(start) TN_curve_set_(&E_TN_tmp1, start);
+	else ec = _walk_rad_start(&E_TN_tmp1, op, l, k);
+
+	//// Double steps, leaving the odd one to the walk of degree 3
+	if(ec && fmpz_equal_ui(E_TN_tmp1.l, 9)) {
+		OPCOUNT_PHASE(OPCOUNT_RADICAL);
+		fmpz_fdiv_q_2exp(k_half, k_local, 1);
+		radical_isogeny_9(&E_TN_tmp2, &E_TN_tmp1, k_half);
+		TN_curve_set_(&E_TN_tmp1, &E_TN_tmp2);
+		fmpz_set_ui(k_local, fmpz_is_odd(k_local));
+	}
+
+	if(ec) {
+		//// Walk
+		OPCOUNT_PHASE(OPCOUNT_RADICAL);
+		if(ctx && fmpz_equal_ui(l, 3)) radical_isogeny_3_fp512(&E_TN_tmp2, &E_TN_tmp1, k_local, ctx);
+		else if(ctx && fmpz_equal_ui(l, 5)) radical_isogeny_5_fp512(&E_TN_tmp2, &E_TN_tmp1, k_local, ctx);
+		else if(ctx && fmpz_equal_ui(l, 7)) radical_isogeny_7_fp512(&E_TN_tmp2, &E_TN_tmp1, k_local, ctx);
+		else if(fmpz_equal_ui(l, 3)) radical_isogeny_3(&E_TN_tmp2, &E_TN_tmp1, k_local);
+		else if(fmpz_equal_ui(l, 5)) radical_isogeny_5_proj(&E_TN_tmp2, &E_TN_tmp1, k_local);
+		else if(fmpz_equal_ui(l, 7)) radical_isogeny_7_proj(&E_TN_tmp2, &E_TN_tmp1, k_local);
+		else if(fmpz_equal_ui(l, 11)) radical_isogeny_11(&E_TN_tmp2, &E_TN_tmp1, k_local);
+		else if(fmpz_equal_ui(l, 13)) radical_isogeny_13(&E_TN_tmp2, &E_TN_tmp1, k_local);
+		else ec = 0;
+
+		// The radical chains stop early when the yield hook asks for it
+		if(walk_yield()) ec = 0;
+	}
 
 	//// Transform result back into Mongomery form
-	ec = TN_get_MG(rop, &E_TN_tmp2);
+	OPCOUNT_PHASE(OPCOUNT_CONVERSION);
+	if(ec) ec = TN_get_MG(rop, &E_TN_tmp2);
 
 	//// Clear
 	fmpz_clear(k_local);
-	MG_point_clear(&P);
+	fmpz_clear(k_half);
 	TN_curve_clear(&E_TN_tmp1);
 	TN_curve_clear(&E_TN_tmp2);
+
+	return ec;
+}
+
+/**
+  Takes k[i] steps from op[i] in the l-isogeny graph for i < n, and sets rop[i] to the target curve.
+  The walks run FPV_LANES at a time in lockstep on the multi-lane field arithmetic of fpv.h,
+  which needs l in {3, 5, 7} and curves over the same prime field; the other cases go through walk_rad one by one,
+  as do all of them when the kernel of fpv.h in use is not fast, i.e. not faster than walk_rad.
+  The curves may belong to independent exchanges, with any steps in either direction.
+  Returns 1 if every walk succeeded and 0 otherwise.
+**/
+int walk_rad_lanes(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t *k, uint n) {
+
+	int ec = 1;
+	fpv_ctx_t ctx;
+	ulong ll = fmpz_get_ui(l);
+
+	//// One by one when the lanes do not apply or do not pay off
+	if((ll != 3 && ll != 5 && ll != 7) || !fpv_ctx_init(&ctx, *(op->F)) || !fpv_kernel()->fast) {
+		for(uint i = 0; i < n; i++) ec &= walk_rad(rop + i, op + i, l, k[i]);
+		if(ll == 3 || ll == 5 || ll == 7) fpv_ctx_clear(&ctx);
+		return ec;
+	}
+
+	//// Init variables
+	TN_curve_t E_TN_tmp1[FPV_LANES], E_TN_tmp2[FPV_LANES];
+	fmpz_t k_local[FPV_LANES];
+	uint lanes, idx[FPV_LANES];
+
+	for(uint i = 0; i < FPV_LANES; i++) {
+		TN_curve_init(E_TN_tmp1 + i, l, op->F);
+		TN_curve_init(E_TN_tmp2 + i, l, op->F);
+		fmpz_init(k_local[i]);
+	}
+
+	for(uint first = 0; first < n; first += FPV_LANES) {
+
+		//// Fill the lanes with the curves to walk, the others are copied
+		lanes = 0;
+		for(uint i = first; i < n && i < first + FPV_LANES; i++) {
+			if(fmpz_is_zero(k[i])) {
+				MG_curve_set_(rop + i, op + i);
+				continue;
+			}
+			if(!_walk_rad_to_TN(E_TN_tmp1 + lanes, op + i, l, k[i])) {
+				ec = 0;
+				continue;
+			}
+			fmpz_abs(k_local[lanes], k[i]);
+			idx[lanes] = i;
+			lanes++;
+		}
+		if(!lanes) continue;
+
+		//// Walk
+		if(ll == 3) radical_isogeny_3_lanes(E_TN_tmp2, E_TN_tmp1, k_local, lanes, &ctx);
+		else if(ll == 5) radical_isogeny_5_lanes(E_TN_tmp2, E_TN_tmp1, k_local, lanes, &ctx);
+		else radical_isogeny_7_lanes(E_TN_tmp2, E_TN_tmp1, k_local, lanes, &ctx);
+
+		// The lanes stop early when the yield hook asks for it
+		if(walk_yield()) {
+			ec = 0;
+			break;
+		}
+
+		//// Transform results back into Mongomery form
+		for(uint j = 0; j < lanes; j++) ec &= TN_get_MG(rop + idx[j], E_TN_tmp2 + j);
+	}
+
+	//// Clear
+	for(uint i = 0; i < FPV_LANES; i++) {
+		TN_curve_clear(E_TN_tmp1 + i);
+		TN_curve_clear(E_TN_tmp2 + i);
+		fmpz_clear(k_local[i]);
+	}
+	fpv_ctx_clear(&ctx);
+
+	return ec;
+}
+
+/**
+  Auxiliary function for the sqrt-velu walks: sets card to the order of the group in which the points of order l
+  are sampled, #E(F_q) on the curve (twist = 0) and #E^t(F_q) = #E(F_q^2) / #E(F_q) on its quadratic twist (twist = 1).
+**/
+static void _walk_velu_card(fmpz_t card, MG_curve_t *op, int twist) {
+
+	fmpz_t r, card2;
+
+	fmpz_init_set_ui(r, fq_ctx_degree(*(op->F)));
+	fmpz_init(card2);
+
+	MG_curve_card_ext(card, op, r);
+	if(twist) {
+		fmpz_mul_ui(r, r, 2);
+		MG_curve_card_ext(card2, op, r);
+		fmpz_divexact(card, card2, card);
+	}
+
 	fmpz_clear(r);
+	fmpz_clear(card2);
+}
+
+/**
+  Sets P to a point of order l on op (twist = 0) or on its twist (twist = 1), sampled as the first step of walk_velu
+  in that direction, so that it can be precomputed for a fixed op, see walk_velu_from.
+  (dac, daclen) is the differential addition chain of l, see walk_velu. P must be initialized on op.
+  Returns 1 if successful and 0 if no point of order l was found.
+**/
+int walk_velu_start(MG_point_t *P, MG_curve_t *op, fmpz_t l, ulong dac, uint daclen, int twist) {
+
+	int ec;
+	fq_t a24, c24;
+	fmpz_t card;
+	MG_frob_t frob;
+
+	fq_init(a24, *(op->F));
+	fq_init(c24, *(op->F));
+	fmpz_init(card);
+
+	fq_add_ui(a24, op->A, 2, *(op->F));
+	fq_set_ui(c24, 4, *(op->F));
+	_walk_velu_card(card, op, twist);
+
+	if(twist) ec = MG_curve_rand_torsion_proj_(P, l, dac, daclen, card, a24, c24);
+	else {
+		MG_frob_init(&frob, op);
+		ec = MG_curve_rand_torsion_frob_proj(P, l, dac, daclen, &frob, card, a24, c24);
+		MG_frob_clear(&frob);
+	}
+
+	fq_clear(a24, *(op->F));
+	fq_clear(c24, *(op->F));
 	fmpz_clear(card);
 
 	return ec;
@@ -69,8 +319,21 @@ int walk_rad(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 
 /**
   Take k steps in the l-isogeny graph using the sqrt-velu algorithm.
+  (dac, daclen) is the differential addition chain of l used for the torsion checks, see MG_xMUL_dac_proj.
+  (b, bprime) is the sqrt-velu split, see velu_ws_init: (0, 0) for the default one.
+  The curve coefficient is carried projectively as (A+2C : 4C) from one step to the next,
+  so that the whole walk costs a single inversion.
 **/
-int walk_velu(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
+int walk_velu(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, ulong dac, uint daclen, uint b, uint bprime, fmpz_t k) {
+
+	return walk_velu_from(rop, op, l, dac, daclen, b, bprime, k, NULL);
+}
+
+/**
+  Same as walk_velu, the first step using the point start of order l on op given by walk_velu_start
+  in the direction of k instead of sampling one if start is not NULL.
+**/
+int walk_velu_from(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, ulong dac, uint daclen, uint b, uint bprime, fmpz_t k, MG_point_t *start) {
 
 	int ec = 1;
 
@@ -81,47 +344,79 @@ int walk_velu(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 	}
 
 	//// Init variables
-	fq_t new_A, new_B;
+	fq_t new_A, new_B, a24, c24;
 	fmpz_t k_local;
 	MG_point_t P;
 	TN_curve_t E_TN_tmp1, E_TN_tmp2;
-	fmpz_t card, r;
+	fmpz_t card;
+	velu_ws_t ws;
+	MG_frob_t frob;
 
-	fmpz_init(r);
 	fmpz_init(card);
+	velu_ws_init(&ws, fmpz_get_ui(l), b, bprime, op);
+	velu_ws_set_orbits(&ws, fmpz_sgn(k) < 0);
 	fq_init(new_A, *(op->F));
 	fq_init(new_B, *(op->F));
+	fq_init(a24, *(op->F));
+	fq_init(c24, *(op->F));
 	fmpz_init_set(k_local, k);
 	MG_point_init(&P, op);
 	TN_curve_init(&E_TN_tmp1, l, op->F);
 	TN_curve_init(&E_TN_tmp2, l, op->F);
 
-	fmpz_set_ui(r, fq_ctx_degree(*(op->F)));
+	OPCOUNT_WALK(fmpz_get_ui(l), fmpz_sgn(k), fq_ctx_degree(*(op->F)));
+
+	//// Projective curve coefficient (A+2C : 4C) with C = 1
+	fq_add_ui(a24, op->A, 2, *(op->F));
+	fq_set_ui(c24, 4, *(op->F));
 
 	//// Direction of the walk
 	if(fmpz_cmp_ui(k, 0) >= 0) {
-		// case k>0
-		MG_curve_card_ext(card, op, r);
+		// case k>0, the samples are cleared with the Frobenius in extensions
+		_walk_velu_card(card, op, 0);
+		MG_frob_init(&frob, op);
 
 		//// Main loop
 		for(int i = 0; fmpz_cmp_ui(k_local, i) > 0; i++) {
-			ec = MG_curve_rand_torsion(&P, l, card);
-			isogeny_from_torsion(&new_A, P, fmpz_get_ui(l));
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			if(i == 0 && start) MG_point_set_(&P, start);
+			else ec = MG_curve_rand_torsion_frob_proj(&P, l, dac, daclen, &frob, card, a24, c24);
+			if(!ec) break;
+			isogeny_from_torsion_proj(a24, c24, P, &ws);
+			OPCOUNT_STEP();
+			if(walk_yield()) {
+				ec = 0;
+				break;
+			}
 		}
+		MG_frob_clear(&frob);
 	}
 	else {
 		// case k<0, we're walking in the quadratic-twist-component
-		fmpz_mul_ui(r, r, 2);
 		fmpz_neg(k_local, k_local);
-		MG_curve_card_ext(card, op, r);
+		_walk_velu_card(card, op, 1);
 
 		//// Main loop
 		for(int i = 0; fmpz_cmp_ui(k_local, i) > 0; i++) {
-			ec = MG_curve_rand_torsion_(&P, l, card);
-			isogeny_from_torsion(&new_A, P, fmpz_get_ui(l));
+			OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+			if(i == 0 && start) MG_point_set_(&P, start);
+			else ec = MG_curve_rand_torsion_proj_(&P, l, dac, daclen, card, a24, c24);
+			if(!ec) break;
+			isogeny_from_torsion_proj(a24, c24, P, &ws);
+			OPCOUNT_STEP();
+			if(walk_yield()) {
+				ec = 0;
+				break;
+			}
 		}
 	}
 
+	//// Back to affine A = (4a24 - 2c24) / c24, the only inversion of the walk
+	OPCOUNT_PHASE(OPCOUNT_OTHER);
+	fq_mul_ui(new_A, a24, 2, *(op->F));
+	fq_sub(new_A, new_A, c24, *(op->F));
+	fq_mul_ui(new_A, new_A, 2, *(op->F));
+	fq_div_itoh(new_A, new_A, c24, *(op->F));
 
 	//// Set output
 	fq_set_ui(new_B, 1, *(op->F));
@@ -130,13 +425,336 @@ int walk_velu(MG_curve_t *rop, MG_curve_t *op, fmpz_t l, fmpz_t k) {
 	//// Clear
 	fq_clear(new_A, *(op->F));
 	fq_clear(new_B, *(op->F));
+	fq_clear(a24, *(op->F));
+	fq_clear(c24, *(op->F));
 	fmpz_clear(k_local);
 	MG_point_clear(&P);
 	TN_curve_clear(&E_TN_tmp1);
 	TN_curve_clear(&E_TN_tmp2);
 	fmpz_clear(card);
+	velu_ws_clear(&ws);
+
+	return ec;
+}
+
+/**
+  Auxiliary function for _walk_velu_batch_dir: returns the number of steps left for the primes idx[0], ..., idx[n-1].
+*/
+static slong _walk_steps_left(fmpz_t *k, uint *idx, uint n) {
+
+	slong left = 0;
+
+	for(uint i = 0; i < n; i++) left += fmpz_get_si(k[idx[i]]);
+	return left;
+}
+
+/**
+  Auxiliary function for _walk_velu_batch_dir.
+  T is a point whose order divides the product of the l[idx[i]]^v[idx[i]] for 0 <= i < n.
+  The set of primes is split in two halves: T is multiplied by the right half's cofactor to get a point
+  of the left half, and by the left half's cofactor to get a point of the right half, which waits on the stack
+  while the left half is walked. At a leaf, T is reduced to an l-torsion point and the isogeny is computed,
+  pushing all the pending points of the stack through it.
+  The pending points stack[0], ..., stack[depth-1] are evaluated at each isogeny.
+  twist = 1 on the quadratic twist, only used to attribute the operation counts.
+  The step counts k are decremented for the primes that were walked.
+  ws[i] is the Velu workspace of the i-th prime.
+  A leaf whose point does not reach O within the bits of its l^v multiplications by l is skipped.
+*/
+static void _walk_velu_batch_rec(fq_t a24, fq_t c24, MG_point_t *T, velu_ws_t *ws, ulong *dac, uint *daclen, fmpz_t *lv, fmpz_t *k, uint *idx, uint n, MG_point_t *stack, uint depth, int twist) {
+
+	bool isinfty;
+
+	MG_point_isinfty(&isinfty, T);
+	if(isinfty) return;
+
+	MG_point_t U;
+	MG_point_init(&U, T->E);
+
+	if(n == 1) {
+		//// Leaf, reduce T to an exact l-torsion point
+		OPCOUNT_WALK(ws[idx[0]].l, (twist ? -1 : 1), fq_ctx_degree(*(T->E->F)));
+		OPCOUNT_PHASE(OPCOUNT_TORSION);
+		MG_xMUL_dac_proj(&U, T, dac[idx[0]], daclen[idx[0]], a24, c24);
+		MG_point_isinfty(&isinfty, &U);
+		for(ulong e = fmpz_bits(lv[idx[0]]); !isinfty && e > 0; e--) {
+			MG_point_set_(T, &U);
+			MG_xMUL_dac_proj(&U, T, dac[idx[0]], daclen[idx[0]], a24, c24);
+			MG_point_isinfty(&isinfty, &U);
+		}
+
+		// Otherwise the order of T was not a power of l, the round makes no progress on this prime
+		if(isinfty) {
+			isogeny_from_torsion_eval_proj(a24, c24, *T, ws + idx[0], stack, depth);
+			fmpz_sub_ui(k[idx[0]], k[idx[0]], 1);
+			OPCOUNT_STEP();
+		}
+	}
+	else {
+		uint m = n/2;
+		fmpz_t e;
+		fmpz_init(e);
+
+		OPCOUNT_WALK(0, (twist ? -1 : 1), fq_ctx_degree(*(T->E->F)));
+		OPCOUNT_PHASE(OPCOUNT_LADDER);
+
+		//// Right point, killing the left primes
+		fmpz_one(e);
+		for(uint i = 0; i < m; i++) fmpz_mul(e, e, lv[idx[i]]);
+		MG_ladder_iter_proj_(&stack[depth], e, T, a24, c24);
+
+		//// Left point, killing the right primes
+		fmpz_one(e);
+		for(uint i = m; i < n; i++) fmpz_mul(e, e, lv[idx[i]]);
+		MG_ladder_iter_proj_(&U, e, T, a24, c24);
+
+		_walk_velu_batch_rec(a24, c24, &U, ws, dac, daclen, lv, k, idx, m, stack, depth + 1, twist);
+
+		//// The right point has been pushed through the left isogenies
+		MG_point_set_(&U, &stack[depth]);
+		_walk_velu_batch_rec(a24, c24, &U, ws, dac, daclen, lv, k, idx + m, n - m, stack, depth, twist);
+
+		fmpz_clear(e);
+	}
+
+	MG_point_clear(&U);
+}
+
+/**
+  Auxiliary function for walk_velu_batch.
+  Walks k[i] > 0 steps for each l[i] on the curve (a24 : c24), on its quadratic twist if twist = 1.
+  Each round clears the cofactor of all the remaining primes at once with a single ladder,
+  then splits the point into l-torsion points along a product tree.
+  The k[i] are consumed. The Velu workspaces are allocated once for all the rounds.
+  If start is not NULL, the first round walks the primes i with start[i] != NULL from these points of order l[i]
+  on op, each one being pushed through the isogenies of the previous ones, see walk_velu_batch_from.
+  Returns 0 in case of failure (some l has no rational torsion in this direction).
+*/
+static int _walk_velu_batch_dir(fq_t a24, fq_t c24, MG_curve_t *op, fmpz_t *l, ulong *dac, uint *daclen, uint *b, uint *bprime, fmpz_t *k, uint n, int twist, MG_point_t **start) {
+
+	int ec = 1, use_frob;
+	uint nb_active, tries = 0;
+	slong left;
+	bool isinfty;
+	flint_rand_t state;
+	fmpz_t r, card, cofactor, val;
+	fmpz_t lv[n];
+	uint idx[n];
+	MG_point_t R, Q;
+	MG_point_t stack[n];
+	velu_ws_t ws[n];
+	MG_frob_t frob;
+
+	fmpz_init(r);
+	fmpz_init(card);
+	fmpz_init(cofactor);
+	fmpz_init(val);
+	MG_point_init(&R, op);
+	MG_point_init(&Q, op);
+	for(uint i = 0; i < n; i++) {
+		fmpz_init(lv[i]);
+		MG_point_init(&stack[i], op);
+		velu_ws_init(ws + i, fmpz_get_ui(l[i]), b[i], bprime[i], op);
+		velu_ws_set_orbits(ws + i, twist);
+	}
+	flint_randinit(state);
+
+	//// Group order in the given direction, #E^t(F_q) = #E(F_q^2) / #E(F_q) for the twist
+	fmpz_set_ui(r, fq_ctx_degree(*(op->F)));
+	MG_curve_card_ext(card, op, r);
+	if(twist) {
+		fmpz_mul_ui(r, r, 2);
+		MG_curve_card_ext(cofactor, op, r);
+		fmpz_divexact(card, cofactor, card);
+	}
+
+	//// On the curve, the kernel of Phi_r(pi) if it has all the primes, see MG_frob_init
+	MG_frob_init(&frob, op);
+	use_frob = !twist && frob.k;
+	for(uint i = 0; use_frob && i < n; i++) {
+		if(!fmpz_divisible(frob.card, l[i])) use_frob = 0;
+	}
+	if(use_frob) fmpz_set(card, frob.card);
+
+	//// l^val for each prime
+	for(uint i = 0; i < n; i++) {
+		fmpz_val_q(val, cofactor, card, l[i]);
+		if(fmpz_is_zero(val)) ec = 0;
+		fmpz_pow_ui(lv[i], l[i], fmpz_get_ui(val));
+	}
+
+	//// First round from the given points, which need no sampling
+	if(ec && start) {
+		nb_active = 0;
+		for(uint i = 0; i < n; i++) {
+			if(start[i] && fmpz_cmp_ui(k[i], 0) > 0) {
+				MG_point_set_(&stack[nb_active], start[i]);
+				idx[nb_active++] = i;
+			}
+		}
+		for(uint j = 0; j < nb_active; j++) {
+			OPCOUNT_WALK(ws[idx[j]].l, (twist ? -1 : 1), fq_ctx_degree(*(op->F)));
+			isogeny_from_torsion_eval_proj(a24, c24, stack[j], ws + idx[j], stack + j + 1, nb_active - j - 1);
+			fmpz_sub_ui(k[idx[j]], k[idx[j]], 1);
+			OPCOUNT_STEP();
+		}
+	}
+
+	//// Main loop
+	while(ec) {
+
+		// Primes still to be walked
+		nb_active = 0;
+		fmpz_set(cofactor, card);
+		for(uint i = 0; i < n; i++) {
+			if(fmpz_cmp_ui(k[i], 0) > 0) {
+				idx[nb_active++] = i;
+				fmpz_divexact(cofactor, cofactor, lv[i]);
+			}
+		}
+		if(nb_active == 0) break;
+
+		// Common cofactor clearing
+		OPCOUNT_WALK(0, (twist ? -1 : 1), fq_ctx_degree(*(op->F)));
+		OPCOUNT_PHASE(OPCOUNT_SAMPLING);
+		if(twist) MG_point_rand_ninfty_nsquare_proj(&R, a24, c24, state);
+		else if(use_frob) MG_point_rand_frob_proj(&R, a24, c24, &frob, state, 0);
+		else MG_point_rand_ninfty_proj(&R, a24, c24, state);
+		OPCOUNT_PHASE(OPCOUNT_LADDER);
+		MG_ladder_iter_proj_(&Q, cofactor, &R, a24, c24);
+		MG_point_isinfty(&isinfty, &Q);
+
+		// Rounds that walk no prime are bounded like the single samplers, see MG_TORSION_TRIES
+		left = _walk_steps_left(k, idx, nb_active);
+		if(!isinfty) _walk_velu_batch_rec(a24, c24, &Q, ws, dac, daclen, lv, k, idx, nb_active, stack, 0, twist);
+		if(_walk_steps_left(k, idx, nb_active) < left) tries = 0;
+		else if(++tries == MG_TORSION_TRIES) ec = 0;
+		if(isinfty) continue;
+
+		// One round is one step of the shared work
+		OPCOUNT_WALK(0, (twist ? -1 : 1), fq_ctx_degree(*(op->F)));
+		OPCOUNT_STEP();
+		if(walk_yield()) ec = 0;
+	}
+
+	//// Clear
+	for(uint i = 0; i < n; i++) {
+		fmpz_clear(lv[i]);
+		MG_point_clear(&stack[i]);
+		velu_ws_clear(ws + i);
+	}
+	MG_frob_clear(&frob);
+	MG_point_clear(&R);
+	MG_point_clear(&Q);
+	fmpz_clear(val);
+	fmpz_clear(cofactor);
+	fmpz_clear(card);
 	fmpz_clear(r);
+	flint_randclear(state);
 
 	return ec;
 }
 
+/**
+  Take k[i] steps in the l[i]-isogeny graph for 0 <= i < n using the sqrt-velu algorithm.
+  All the primes must be walked in the field of op.
+  Instead of one cofactor ladder per step as in walk_velu, the primes walked in the same direction
+  share the random point: its cofactor is cleared once per round, and the resulting point is split
+  into torsion points for every prime along a product tree, the pending points being pushed
+  through each isogeny. This is the batching strategy of CSIDH implementations.
+  (dac[i], daclen[i]) is the differential addition chain of l[i], see MG_xMUL_dac_proj, and (b[i], bprime[i]) its split as in walk_velu.
+  The curve coefficient is carried projectively as in walk_velu, with a single inversion at the end.
+**/
+int walk_velu_batch(MG_curve_t *rop, MG_curve_t *op, fmpz_t *l, ulong *dac, uint *daclen, uint *b, uint *bprime, fmpz_t *k, uint n) {
+
+	return walk_velu_batch_from(rop, op, l, dac, daclen, b, bprime, k, n, NULL);
+}
+
+/**
+  Same as walk_velu_batch, the first step of each l[i] with start[i] != NULL being taken from start[i],
+  a point of order l[i] on op, or on its quadratic twist if k[i] < 0, as given by walk_velu_start.
+  start may be NULL.
+**/
+int walk_velu_batch_from(MG_curve_t *rop, MG_curve_t *op, fmpz_t *l, ulong *dac, uint *daclen, uint *b, uint *bprime, fmpz_t *k, uint n, MG_point_t **start) {
+
+	int ec = 1;
+
+	//// Init variables
+	fq_t new_A, new_B, a24, c24;
+	fmpz_t l_dir[n], k_dir[n];
+	ulong dac_dir[n];
+	uint daclen_dir[n], b_dir[n], bprime_dir[n];
+	MG_point_t *start_dir[n];
+	uint n_dir;
+	int moved;
+
+	fq_init(new_A, *(op->F));
+	fq_init(new_B, *(op->F));
+	fq_init(a24, *(op->F));
+	fq_init(c24, *(op->F));
+	for(uint i = 0; i < n; i++) {
+		fmpz_init(l_dir[i]);
+		fmpz_init(k_dir[i]);
+	}
+
+	//// Projective curve coefficient (A+2C : 4C) with C = 1
+	fq_add_ui(a24, op->A, 2, *(op->F));
+	fq_set_ui(c24, 4, *(op->F));
+
+	//// Positive steps, on the curve
+	n_dir = 0;
+	for(uint i = 0; i < n; i++) {
+		if(fmpz_cmp_ui(k[i], 0) > 0) {
+			fmpz_set(l_dir[n_dir], l[i]);
+			fmpz_set(k_dir[n_dir], k[i]);
+			dac_dir[n_dir] = dac[i];
+			daclen_dir[n_dir] = daclen[i];
+			b_dir[n_dir] = b[i];
+			bprime_dir[n_dir] = bprime[i];
+			start_dir[n_dir] = start ? start[i] : NULL;
+			n_dir++;
+		}
+	}
+	if(n_dir) ec = _walk_velu_batch_dir(a24, c24, op, l_dir, dac_dir, daclen_dir, b_dir, bprime_dir, k_dir, n_dir, 0, start_dir);
+	moved = (n_dir > 0);
+
+	//// Negative steps, on the quadratic twist
+	n_dir = 0;
+	for(uint i = 0; i < n; i++) {
+		if(fmpz_cmp_ui(k[i], 0) < 0) {
+			fmpz_set(l_dir[n_dir], l[i]);
+			fmpz_neg(k_dir[n_dir], k[i]);
+			dac_dir[n_dir] = dac[i];
+			daclen_dir[n_dir] = daclen[i];
+			b_dir[n_dir] = b[i];
+			bprime_dir[n_dir] = bprime[i];
+			start_dir[n_dir] = start ? start[i] : NULL;
+			n_dir++;
+		}
+	}
+	// The points of start lie on op, which the positive steps have left
+	if(ec && n_dir) ec = _walk_velu_batch_dir(a24, c24, op, l_dir, dac_dir, daclen_dir, b_dir, bprime_dir, k_dir, n_dir, 1, (moved ? NULL : start_dir));
+
+	//// Back to affine A = (4a24 - 2c24) / c24, the only inversion of the walk
+	OPCOUNT_PHASE(OPCOUNT_OTHER);
+	fq_mul_ui(new_A, a24, 2, *(op->F));
+	fq_sub(new_A, new_A, c24, *(op->F));
+	fq_mul_ui(new_A, new_A, 2, *(op->F));
+	fq_div_itoh(new_A, new_A, c24, *(op->F));
+
+	//// Set output
+	fq_set_ui(new_B, 1, *(op->F));
+	MG_curve_set(rop, op->F, new_A, new_B);
+
+	//// Clear
+	fq_clear(new_A, *(op->F));
+	fq_clear(new_B, *(op->F));
+	fq_clear(a24, *(op->F));
+	fq_clear(c24, *(op->F));
+	for(uint i = 0; i < n; i++) {
+		fmpz_clear(l_dir[i]);
+		fmpz_clear(k_dir[i]);
+	}
+
+	return ec;
+}
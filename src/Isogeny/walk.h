@@ -17,8 +17,15 @@
 #include "../EllipticCurves/arithmetic.h"
 #include "../EllipticCurves/pretty_print.h"
 
+int walk_rad_start(TN_curve_t *, MG_curve_t *, fmpz_t, int);
 int walk_rad(MG_curve_t *, MG_curve_t *, fmpz_t, fmpz_t);
-int walk_velu(MG_curve_t *, MG_curve_t *, fmpz_t, fmpz_t);
+int walk_rad_from(MG_curve_t *, MG_curve_t *, fmpz_t, fmpz_t, TN_curve_t *);
+int walk_rad_lanes(MG_curve_t *, MG_curve_t *, fmpz_t, fmpz_t *, uint);
+int walk_velu_start(MG_point_t *, MG_curve_t *, fmpz_t, ulong, uint, int);
+int walk_velu(MG_curve_t *, MG_curve_t *, fmpz_t, ulong, uint, uint, uint, fmpz_t);
+int walk_velu_from(MG_curve_t *, MG_curve_t *, fmpz_t, ulong, uint, uint, uint, fmpz_t, MG_point_t *);
+int walk_velu_batch(MG_curve_t *, MG_curve_t *, fmpz_t *, ulong *, uint *, uint *, uint *, fmpz_t *, uint);
+int walk_velu_batch_from(MG_curve_t *, MG_curve_t *, fmpz_t *, ulong *, uint *, uint *, uint *, fmpz_t *, uint, MG_point_t **);
 
 #endif
 
@@ -0,0 +1,22 @@
+// @file yield.c
+#include "yield.h"
+
+static __thread walk_yield_t _walk_yield_fn = NULL;
+static __thread void *_walk_yield_arg = NULL;
+
+/**
+  Sets the yield hook of the calling thread to fn, called with arg. fn = NULL removes it.
+*/
+void walk_set_yield(walk_yield_t fn, void *arg) {
+
+	_walk_yield_fn = fn;
+	_walk_yield_arg = arg;
+}
+
+/**
+  Yield point: returns 1 if the ongoing walk must stop and 0 otherwise.
+*/
+int walk_yield() {
+
+	return _walk_yield_fn ? _walk_yield_fn(_walk_yield_arg) : 0;
+}
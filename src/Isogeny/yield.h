@@ -0,0 +1,18 @@
+#ifndef _YIELD_H_
+#define _YIELD_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*********************************************
+   Cooperative yield point between isogeny steps
+*********************************************/
+// The walks call walk_yield() after every isogeny step (every round for walk_velu_batch)
+// and stop, reporting a failure, as soon as it returns a nonzero value.
+// The hook is set per thread, so that walks running in other threads are not affected.
+typedef int (*walk_yield_t)(void *);
+
+void walk_set_yield(walk_yield_t, void *);
+int walk_yield();
+
+#endif
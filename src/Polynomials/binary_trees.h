@@ -7,6 +7,8 @@
 #include <flint/fq.h>
 #include <flint/fq_poly.h>
 
+#include "../EllipticCurves/opcount.h"
+
 
 /*********************************
   Structures
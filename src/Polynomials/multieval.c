@@ -98,3 +98,153 @@ void fq_poly_multieval(fq_t * rop, fq_t * op, fq_poly_t P, uint len, const fq_ct
 	fq_poly_btree_clear(&T);
 }
 
+
+/**
+  Sets rop to lc(g)^(m - deg(g) + 1) * (op mod g), where m >= deg(op) is the formal degree of op.
+  This is a pseudo-remainder: no inversion is performed.
+  If m < deg(g), rop is set to op.
+*/
+void fq_poly_prem_formal(fq_poly_t rop, fq_poly_t op, slong m, fq_poly_t g, const fq_ctx_t *F) {
+
+	slong n = fq_poly_degree(g, *F);
+
+	fq_poly_set(rop, op, *F);
+	if(m < n) return;
+
+	fq_t lc, c;
+	fq_poly_t t;
+
+	fq_init(lc, *F);
+	fq_init(c, *F);
+	fq_poly_init(t, *F);
+
+	fq_poly_get_coeff(lc, g, n, *F);
+
+	//// Kill the coefficient of degree k with rop := lc*rop - c*X^(k-n)*g
+	for(slong k = m; k >= n; k--) {
+		fq_poly_get_coeff(c, rop, k, *F);
+		fq_poly_scalar_mul_fq(rop, rop, lc, *F);
+		fq_poly_scalar_mul_fq(t, g, c, *F);
+		fq_poly_shift_left(t, t, k - n, *F);
+		fq_poly_sub(rop, rop, t, *F);
+	}
+
+	fq_clear(lc, *F);
+	fq_clear(c, *F);
+	fq_poly_clear(t, *F);
+}
+
+/**
+  Same as remainderCell but the leaves are the non-monic polynomials Z*X - X for projective roots (X : Z).
+  The cells of a tree already built over the same number of roots are reused.
+*/
+void remainderCell_proj(fq_poly_bcell_t *rop, fq_t *X, fq_t *Z, uint offset_start, uint offset_end, const fq_ctx_t *F) {
+
+	uint offset_split;
+	fq_t tmp;
+	fq_poly_t p;
+
+	fq_init(tmp, *F);
+	fq_poly_init(p, *F);
+
+	if(offset_end - offset_start == 0) {
+
+		//// Set rop to a unique cell containing the Z*X - X polynomial
+		fq_neg(tmp, X[offset_start], *F);
+		fq_poly_set_coeff(p, 0, tmp, *F);
+		fq_poly_set_coeff(p, 1, Z[offset_start], *F);
+
+		fq_poly_bcell_set(rop, p);
+	}
+	else {
+
+		//// Recursively construct the tree, or refill it
+		fq_poly_bcell_t *left = rop->left, *right = rop->right;
+
+		if(left == NULL) {
+			left = malloc(sizeof(fq_poly_bcell_t));
+			right = malloc(sizeof(fq_poly_bcell_t));
+
+			fq_poly_bcell_init(left, F);
+			fq_poly_bcell_init(right, F);
+		}
+
+		offset_split = offset_start + (offset_end - offset_start) / 2;
+
+		remainderCell_proj(left, X, Z, offset_start, offset_split , F);
+		remainderCell_proj(right, X, Z, offset_split + 1, offset_end , F);
+
+		//// Compute product of child polynomials
+		fq_poly_mul(p, left->data, right->data, *F);
+
+		fq_poly_bcell_set_(rop, left, right, p);
+	}
+
+	fq_clear(tmp, *F);
+	fq_poly_clear(p, *F);
+}
+
+/**
+  See remainderCell_proj.
+  T should be initialized.
+*/
+void remainderTree_proj(fq_poly_btree_t *T, fq_t *X, fq_t *Z, uint len, const fq_ctx_t *F) {
+
+	remainderCell_proj(T->head, X, Z, 0, len-1, F);
+}
+
+void fq_poly_multieval_proj_fromtree(fq_poly_bcell_t *c, fq_t *res, fq_poly_t P, slong m, uint *k, const fq_ctx_t *F) {
+
+	fq_poly_t Q;
+
+	fq_poly_init(Q, *F);
+
+	//// New polynomial, of formal degree deg(c) - 1
+	fq_poly_prem_formal(Q, P, m, c->data, F);
+	m = fq_poly_degree(c->data, *F) - 1;
+
+	if(c->left == NULL) {
+
+		fq_poly_get_coeff(res[*k], Q, 0, *F);
+		(*k)++;
+	}
+	else {
+		fq_poly_multieval_proj_fromtree(c->left, res, Q, m, k, F);
+		fq_poly_multieval_proj_fromtree(c->right, res, Q, m, k, F);
+	}
+	fq_poly_clear(Q, *F);
+}
+
+/**
+  Same as fq_poly_multieval_proj on the remainder tree T built by remainderTree_proj,
+  so that several polynomials can be evaluated at the same points with a single tree.
+  T is only read: several evaluations may run at the same time.
+*/
+void fq_poly_multieval_proj_tree(fq_t *rop, fq_poly_btree_t *T, fq_poly_t P, slong m, const fq_ctx_t *F) {
+
+	uint k = 0;
+
+	fq_poly_multieval_proj_fromtree(T->head, rop, P, m, &k, F);
+}
+
+/**
+  Inversion-free multipoint evaluation at the projective points (X[i] : Z[i]), none of which is at infinity.
+  Sets rop[i] to s_i * P(X[i]/Z[i]) where the nonzero scalars s_i only depend on the points and on the formal degree m >= deg(P).
+  The values are therefore only meaningful up to these factors: for two polynomials of the same formal degree,
+  the ratio of the products of their evaluations is exact.
+*/
+void fq_poly_multieval_proj(fq_t *rop, fq_t *X, fq_t *Z, fq_poly_t P, slong m, uint len, const fq_ctx_t *F) {
+
+	uint k = 0;
+	fq_poly_btree_t T;
+
+	fq_poly_btree_init(&T, F);
+
+	//// Construct tree with modulos
+	remainderTree_proj(&T, X, Z, len, F);
+
+	//// Evaluate P by pseudo-remainders
+	fq_poly_multieval_proj_fromtree(T.head, rop, P, m, &k, F);
+
+	fq_poly_btree_clear(&T);
+}
@@ -12,5 +12,11 @@
 void remainderCell(fq_poly_bcell_t *, fq_t *, uint, uint, const fq_ctx_t *);
 void remainderTree(fq_poly_btree_t *, fq_t *, uint, const fq_ctx_t *);
 void fq_poly_multieval(fq_t *, fq_t *, fq_poly_t, uint, const fq_ctx_t *);
+
+void fq_poly_prem_formal(fq_poly_t, fq_poly_t, slong, fq_poly_t, const fq_ctx_t *);
+void remainderCell_proj(fq_poly_bcell_t *, fq_t *, fq_t *, uint, uint, const fq_ctx_t *);
+void remainderTree_proj(fq_poly_btree_t *, fq_t *, fq_t *, uint, const fq_ctx_t *);
+void fq_poly_multieval_proj_tree(fq_t *, fq_poly_btree_t *, fq_poly_t, slong, const fq_ctx_t *);
+void fq_poly_multieval_proj(fq_t *, fq_t *, fq_t *, fq_poly_t, slong, uint, const fq_ctx_t *);
 #endif
 
@@ -36,15 +36,15 @@ int fq_sqr_from_polyfact(fq_t rop, fq_t op, const fq_ctx_t F) {
 	fq_init(tmp, F);
 	fq_init(lead, F);
 	fq_poly_init(pol, F);
-	fq_poly_factor_init(fac, F); //// Memory leak (Valgrind)
+	fq_poly_factor_init(fac, F);
 
-	fq_neg(tmp, op, F);	//// Memory leak (Valgrind)
+	fq_neg(tmp, op, F);
 
-	fq_set_ui(one, 1, F);	//// Memory leak (Valgrind)
+	fq_set_ui(one, 1, F);
 	fq_poly_set_coeff(pol, 2, one, F);
-	fq_poly_set_coeff(pol, 0, tmp, F); //// Memory leak (Valgrind)
+	fq_poly_set_coeff(pol, 0, tmp, F);
 
-	fq_poly_factor(fac, lead, pol, F); //// Memory leak (Valgrind)
+	fq_poly_factor(fac, lead, pol, F);
 
 	if(fac->num < 2) ec = 0;
 	else fq_poly_get_coeff(rop, fac->poly, 0, F);
@@ -57,3 +57,398 @@ int fq_sqr_from_polyfact(fq_t rop, fq_t op, const fq_ctx_t F) {
 
 	return ec;
 }
+
+/**
+  Sets rop to op^e. Over a prime field the exponentiation is done on the
+  integer representative with the dispatched kernel of fp512_powm if p is registered and the kernel is fast,
+  and with fmpz_powm otherwise.
+  In extensions it falls back to fq_pow.
+*/
+void fq_pow_fast(fq_t rop, fq_t op, fmpz_t e, const fq_ctx_t F) {
+
+	if(fq_ctx_degree(F) != 1) {
+		fq_pow(rop, op, e, F);
+		return;
+	}
+
+	fmpz_t a;
+	fmpz_init(a);
+
+	OPCOUNT_ADD(OPCOUNT_POW, F);
+	fq_get_fmpz(a, op, F);
+	if(!fp512_powm(a, a, e, fq_ctx_prime(F))) fmpz_powm(a, a, e, fq_ctx_prime(F));
+	fq_set_fmpz(rop, a, F);
+
+	fmpz_clear(a);
+}
+
+/**
+  Returns 1 if op is a square in F and 0 otherwise. Zero is a square: it is tested first, since its norm
+  has Jacobi symbol 0. Otherwise, as the norm maps the squares of F onto those of F_p, this is the Jacobi symbol
+  of the norm of op, computed with Itoh-Tsujii by fq_norm_itoh in the extensions.
+*/
+int fq_issquare(fq_t op, const fq_ctx_t F) {
+
+	if(fq_is_zero(op, F)) return 1;
+
+	int ret;
+	fmpz_t a;
+	fmpz_init(a);
+
+	fq_norm_itoh(a, op, F);
+	ret = (fmpz_jacobi(a, fq_ctx_prime(F)) == 1);
+
+	fmpz_clear(a);
+	return ret;
+}
+
+/**
+  Auxiliary function for fq_sqr_tonelli: square root of op in an extension F of odd degree d with a Frobenius table.
+  With r = (q - 1)/(p - 1) = 1 + p + ... + p^(d-1), which is odd, b = op^((r+1)/2) satisfies b^2 = op N(op), so the root
+  is b / sqrt(N(op)) with a square root in F_p. Writing (r+1)/2 = (d+1)/2 + sum_{0 < i < d} (p^i - 1)/2 and v = op^((p-1)/2),
+  b = op^((d+1)/2) * prod_{0 < i < d} v pi(v) ... pi^(i-1)(v), that is one exponentiation to a power of the size of p,
+  d - 2 Frobenius maps and about 2d multiplications.
+  Returns 1 if successful and 0 otherwise.
+*/
+static int _fq_sqr_norm(fq_t rop, fq_t op, const fq_ctx_t F) {
+
+	uint d = fq_ctx_degree(F);
+	int ec;
+	fmpz_t n, e;
+	fq_t b, v, w;
+
+	fmpz_init(n);
+	fmpz_init(e);
+	fq_init(b, F);
+	fq_init(v, F);
+	fq_init(w, F);
+
+	//// op is a square if and only if N(op) is, n = sqrt(N(op)) in F_p
+	fq_norm_itoh(n, op, F);
+	ec = fmpz_sqrtmod(n, n, fq_ctx_prime(F));
+
+	if(ec) {
+		// v = op^((p-1)/2), b = op^((d+1)/2)
+		fmpz_sub_ui(e, fq_ctx_prime(F), 1);
+		fmpz_fdiv_q_2exp(e, e, 1);
+		fq_pow(v, op, e, F);
+		fq_pow_ui(b, op, (d + 1) / 2, F);
+
+		// w = v pi(v) ... pi^(i-1)(v) at step i
+		fq_set(w, v, F);
+		for(uint i = 1; i < d; i++) {
+			if(i > 1) {
+				fq_frobenius_tab(v, v, 1, F);
+				fq_mul(w, w, v, F);
+			}
+			fq_mul(b, b, w, F);
+		}
+
+		// rop = b / n
+		fmpz_invmod(n, n, fq_ctx_prime(F));
+		fq_mul_fmpz(rop, b, n, F);
+	}
+
+	fmpz_clear(n);
+	fmpz_clear(e);
+	fq_clear(b, F);
+	fq_clear(v, F);
+	fq_clear(w, F);
+
+	return ec;
+}
+
+/**
+  Extract square root of op with the Tonelli-Shanks algorithm.
+  Writing p - 1 = 2^s * m, this costs one exponentiation and at most s^2 squarings.
+  Extensions of odd degree with a Frobenius table reduce to a square root in F_p with _fq_sqr_norm,
+  the others go through fq_sqr_from_polyfact.
+  Returns 1 if successful and 0 otherwise.
+*/
+int fq_sqr_tonelli(fq_t rop, fq_t op, const fq_ctx_t F) {
+
+	if(fq_ctx_degree(F) != 1) {
+		if(fq_ctx_degree(F) % 2 == 0 || fq_frob_get(F) == NULL) return fq_sqr_from_polyfact(rop, op, F);
+
+		OPCOUNT_ADD(OPCOUNT_ROOT, F);
+		if(fq_is_zero(op, F)) {
+			fq_zero(rop, F);
+			return 1;
+		}
+		return _fq_sqr_norm(rop, op, F);
+	}
+	OPCOUNT_ADD(OPCOUNT_ROOT, F);
+	if(fq_is_zero(op, F)) {
+		fq_zero(rop, F);
+		return 1;
+	}
+	if(!fq_issquare(op, F)) return 0;
+
+	slong s, i, j;
+	fmpz_t m, e;
+	fq_t z, c, t, r, b;
+
+	fmpz_init(m);
+	fmpz_init(e);
+	fq_init(z, F);
+	fq_init(c, F);
+	fq_init(t, F);
+	fq_init(r, F);
+	fq_init(b, F);
+
+	//// p - 1 = 2^s * m with m odd
+	fmpz_sub_ui(m, fq_ctx_prime(F), 1);
+	for(s = 0; fmpz_is_even(m); s++) fmpz_fdiv_q_2exp(m, m, 1);
+
+	//// Smallest non-residue z, c = z^m
+	fq_set_ui(z, 2, F);
+	while(fq_issquare(z, F)) fq_add_ui(z, z, 1, F);
+	fq_pow_fast(c, z, m, F);
+
+	//// t = op^m, r = op^((m + 1)/2) from a single exponentiation op^((m - 1)/2)
+	fmpz_sub_ui(e, m, 1);
+	fmpz_fdiv_q_2exp(e, e, 1);
+	fq_pow_fast(b, op, e, F);
+	fq_mul(r, b, op, F);
+	fq_mul(t, b, r, F);
+
+	//// Main loop, t has order dividing 2^(s-1)
+	while(!fq_is_one(t, F)) {
+
+		// Least i such that t^(2^i) = 1
+		fq_set(b, t, F);
+		for(i = 0; !fq_is_one(b, F); i++) fq_sqr(b, b, F);
+
+		// b = c^(2^(s - i - 1))
+		fq_set(b, c, F);
+		for(j = 0; j < s - i - 1; j++) fq_sqr(b, b, F);
+
+		fq_mul(r, r, b, F);
+		fq_sqr(c, b, F);
+		fq_mul(t, t, c, F);
+		s = i;
+	}
+	fq_set(rop, r, F);
+
+	fmpz_clear(m);
+	fmpz_clear(e);
+	fq_clear(z, F);
+	fq_clear(c, F);
+	fq_clear(t, F);
+	fq_clear(r, F);
+	fq_clear(b, F);
+
+	return 1;
+}
+
+/**
+  Sets (r0 + r1 w) to the product of (a0 + a1 w) and (b0 + b1 w) in F[w]/(w^2 - D).
+  rop may alias the operands.
+*/
+static void _fq2_mul(fq_t r0, fq_t r1, fq_t a0, fq_t a1, fq_t b0, fq_t b1, fq_t D, const fq_ctx_t F) {
+
+	fq_t t0, t1, t2;
+
+	fq_init(t0, F);
+	fq_init(t1, F);
+	fq_init(t2, F);
+
+	// Karatsuba: (a0 + a1)(b0 + b1) - a0b0 - a1b1
+	fq_mul(t0, a0, b0, F);
+	fq_mul(t1, a1, b1, F);
+	fq_add(t2, a0, a1, F);
+	fq_add(r1, b0, b1, F);
+	fq_mul(r1, r1, t2, F);
+	fq_sub(r1, r1, t0, F);
+	fq_sub(r1, r1, t1, F);
+
+	fq_mul(t1, t1, D, F);
+	fq_add(r0, t0, t1, F);
+
+	fq_clear(t0, F);
+	fq_clear(t1, F);
+	fq_clear(t2, F);
+}
+
+/**
+  Sets rop to a root of the monic cubic x^3 + a2 x^2 + a1 x + a0 if it has one in F.
+  Over a prime field with p = 2 or 5 mod 9, this uses Cardano's formula
+  on the depressed cubic t^3 + Pt + Q, where every cube root is a single exponentiation:
+	- if D = Q^2/4 + P^3/27 is a square, u = (-Q/2 + sqrt(D))^((2p - 1)/3) is in F
+	  and t = u - P/(3u),
+	- otherwise u is a cube root of w = -Q/2 + sqrt(D) in F(sqrt(D)), obtained as w^k with
+	  3k = 1 mod (p^2 - 1)/3, and t = u + conj(u). The cubic has no root when w is not a cube.
+  Other fields go through fq_poly_factor.
+  Returns 1 if successful and 0 otherwise.
+*/
+int fq_cubic_anyroot(fq_t rop, fq_t a2, fq_t a1, fq_t a0, const fq_ctx_t F) {
+
+	int ret = 0;
+	const fmpz *p = fq_ctx_prime(F);
+
+	//// Generic case: factor the cubic
+	if(fq_ctx_degree(F) != 1 || (fmpz_fdiv_ui(p, 9) != 2 && fmpz_fdiv_ui(p, 9) != 5)) {
+
+		fq_t lead;
+		fq_poly_t pol;
+		fq_poly_factor_t fac;
+
+		fq_init(lead, F);
+		fq_poly_init(pol, F);
+		fq_poly_factor_init(fac, F);
+
+		fq_one(lead, F);
+		fq_poly_set_coeff(pol, 0, a0, F);
+		fq_poly_set_coeff(pol, 1, a1, F);
+		fq_poly_set_coeff(pol, 2, a2, F);
+		fq_poly_set_coeff(pol, 3, lead, F);
+
+		fq_poly_factor(fac, lead, pol, F);
+		for(int i=0; i < fac->num && !ret; i++) {
+			if(fq_poly_degree(fac->poly + i, F) == 1) {
+				fq_poly_get_coeff(rop, fac->poly + i, 0, F);
+				fq_neg(rop, rop, F);
+				ret = 1;
+			}
+		}
+
+		fq_clear(lead, F);
+		fq_poly_clear(pol, F);
+		fq_poly_factor_clear(fac, F);
+		return ret;
+	}
+
+	fmpz_t e, m;
+	fq_t P, Q, D, s, w0, w1, u0, u1, c1, N, tmp1, tmp2;
+
+	fmpz_init(e);
+	fmpz_init(m);
+	fq_init(P, F);
+	fq_init(Q, F);
+	fq_init(D, F);
+	fq_init(s, F);
+	fq_init(w0, F);
+	fq_init(w1, F);
+	fq_init(u0, F);
+	fq_init(u1, F);
+	fq_init(c1, F);
+	fq_init(N, F);
+	fq_init(tmp1, F);
+	fq_init(tmp2, F);
+
+	//// Depressed cubic, x = t - a2/3
+	// P = a1 - a2^2/3
+	fq_sqr(tmp1, a2, F);
+	fq_div_ui(tmp1, tmp1, 3, F);
+	fq_sub(P, a1, tmp1, F);
+	// Q = 2a2^3/27 - a1a2/3 + a0 = a2(2a2^2/9 - a1)/3 + a0
+	fq_mul_ui(tmp1, tmp1, 2, F);
+	fq_div_ui(tmp1, tmp1, 3, F);
+	fq_sub(tmp1, tmp1, a1, F);
+	fq_mul(tmp1, tmp1, a2, F);
+	fq_div_ui(tmp1, tmp1, 3, F);
+	fq_add(Q, tmp1, a0, F);
+
+	//// D = Q^2/4 + P^3/27 and w = -Q/2 + sqrt(D)
+	fq_sqr(tmp1, Q, F);
+	fq_div_ui(tmp1, tmp1, 4, F);
+	fq_sqr(tmp2, P, F);
+	fq_mul(tmp2, tmp2, P, F);
+	fq_div_ui(tmp2, tmp2, 27, F);
+	fq_add(D, tmp1, tmp2, F);
+	fq_div_ui(w0, Q, 2, F);
+	fq_neg(w0, w0, F);
+
+	if(fq_is_zero(P, F)) {
+		//// t^3 = -Q, cube roots are unique
+		fmpz_mul_ui(e, p, 2);
+		fmpz_sub_ui(e, e, 1);
+		fmpz_divexact_ui(e, e, 3);
+		fq_neg(tmp1, Q, F);
+		fq_pow_fast(u0, tmp1, e, F);
+		ret = 1;
+	}
+	else if(fq_is_zero(D, F)) {
+		//// Double root, the simple root is t = 3Q/P
+		fq_mul_ui(u0, Q, 3, F);
+		fq_div(u0, u0, P, F);
+		ret = 1;
+	}
+	else if(fq_issquare(D, F)) {
+		//// u = (-Q/2 + sqrt(D))^(1/3) in F, t = u - P/3u
+		fq_sqr_tonelli(s, D, F);
+		fq_add(tmp1, w0, s, F);
+		fmpz_mul_ui(e, p, 2);
+		fmpz_sub_ui(e, e, 1);
+		fmpz_divexact_ui(e, e, 3);
+		fq_pow_fast(u1, tmp1, e, F);
+
+		fq_mul_ui(tmp1, u1, 3, F);
+		fq_div(tmp1, P, tmp1, F);
+		fq_sub(u0, u1, tmp1, F);
+		ret = 1;
+	}
+	else {
+		//// w = w0 + sqrt(D) in F(sqrt(D)), with conjugate w0 - sqrt(D) and norm N = -P^3/27
+		fq_one(w1, F);
+		fq_neg(c1, w1, F);
+		fq_neg(N, tmp2, F);
+
+		// k = 3^-1 mod m, m = (p^2 - 1)/3, split as k = k1 p + k0
+		fmpz_mul(m, p, p);
+		fmpz_sub_ui(m, m, 1);
+		fmpz_divexact_ui(m, m, 3);
+		fmpz_set_ui(e, 3);
+		fmpz_invmod(e, e, m);
+		fmpz_t k0;
+		fmpz_init(k0);
+		fmpz_fdiv_qr(m, k0, e, p);
+
+		// u = w^k0 * conj(w)^k1, joint square-and-multiply with w * conj(w) = N
+		fq_one(u0, F);
+		fq_zero(u1, F);
+		for(slong i = FLINT_MAX(fmpz_bits(k0), fmpz_bits(m)) - 1; i >= 0; i--) {
+			_fq2_mul(u0, u1, u0, u1, u0, u1, D, F);
+			int b0 = fmpz_tstbit(k0, i), b1 = fmpz_tstbit(m, i);
+			if(b0 && b1) {
+				fq_mul(u0, u0, N, F);
+				fq_mul(u1, u1, N, F);
+			}
+			else if(b0) _fq2_mul(u0, u1, u0, u1, w0, w1, D, F);
+			else if(b1) _fq2_mul(u0, u1, u0, u1, w0, c1, D, F);
+		}
+		fmpz_clear(k0);
+
+		// Check u^3 = w, otherwise the cubic is irreducible
+		_fq2_mul(tmp1, tmp2, u0, u1, u0, u1, D, F);
+		_fq2_mul(tmp1, tmp2, tmp1, tmp2, u0, u1, D, F);
+		if(fq_equal(tmp1, w0, F) && fq_equal(tmp2, w1, F)) {
+			// t = u + conj(u)
+			fq_add(u0, u0, u0, F);
+			ret = 1;
+		}
+	}
+
+	//// x = t - a2/3
+	if(ret) {
+		fq_div_ui(tmp1, a2, 3, F);
+		fq_sub(rop, u0, tmp1, F);
+	}
+
+	fmpz_clear(e);
+	fmpz_clear(m);
+	fq_clear(P, F);
+	fq_clear(Q, F);
+	fq_clear(D, F);
+	fq_clear(s, F);
+	fq_clear(w0, F);
+	fq_clear(w1, F);
+	fq_clear(u0, F);
+	fq_clear(u1, F);
+	fq_clear(c1, F);
+	fq_clear(N, F);
+	fq_clear(tmp1, F);
+	fq_clear(tmp2, F);
+
+	return ret;
+}
@@ -8,8 +8,17 @@
 #include <flint/fq_poly.h>
 #include <flint/fq_poly_factor.h>
 
+#include "../EllipticCurves/auxiliary.h"
+#include "../EllipticCurves/frobenius.h"
+#include "../EllipticCurves/fp512.h"
+
 //int fq_poly_anyroot(fq_t, fq_poly_t, const fq_ctx_t);
 int fq_sqr_from_polyfact(fq_t, fq_t, const fq_ctx_t);
 
+void fq_pow_fast(fq_t, fq_t, fmpz_t, const fq_ctx_t);
+int fq_issquare(fq_t, const fq_ctx_t);
+int fq_sqr_tonelli(fq_t, fq_t, const fq_ctx_t);
+int fq_cubic_anyroot(fq_t, fq_t, fq_t, fq_t, const fq_ctx_t);
+
 #endif
 